@@ -27,48 +27,25 @@
  * - Introduced dynamic interpolation based on phoneme durations.
  * - Added a mechanism to adjust interpolation frames dynamically based on speech tempo.
  * - Enhanced compatibility with modern Unreal Engine APIs (e.g., FPaths and Async threading).
+ * - Added SignalProcessing for decoding sound wave assets at runtime.
+ * - Added AudioMixerCore for resampling ahead of inference.
+ * - Added DeveloperSettings, and TargetPlatform in editor builds, for per-platform packaging of sequences.
+ * - Moved the SDK, capture and cooking to OVRLipSyncInference, playback no longer links the SDK.
  ******************************************************************************/
 
-using System.IO;
 using UnrealBuildTool;
 
 public class OVRLipSync : ModuleRules
 {
     public OVRLipSync(ReadOnlyTargetRules Target) : base(Target)
     {
-        PrivateDependencyModuleNames.AddRange(new string[] {"AndroidPermission"});
-        PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
-
-        string BaseDirectory = Path.GetFullPath(Path.Combine(ModuleDirectory, "..", ".."));
-        string ThirdPartyDirectory = Path.Combine(BaseDirectory, "ThirdParty");
-        string PlatformString = Target.Platform.ToString();
-        string LibraryDirectory = Path.Combine(ThirdPartyDirectory, "Lib", PlatformString);
-        string TargetBinariesDirectory = Path.Combine(BaseDirectory, "Binaries", PlatformString);
-        PublicIncludePaths.Add(Path.Combine(ThirdPartyDirectory, "Include"));
-        PublicDependencyModuleNames.AddRange( new string[] { "Core", "CoreUObject", "Engine", "Voice"});
-
-        if (Target.Platform == UnrealTargetPlatform.Win64)
-        {
-            PublicAdditionalLibraries.Add(Path.Combine(LibraryDirectory, "OVRLipSyncShim.lib"));
-            PublicDelayLoadDLLs.Add("OVRLipSync.dll");
-            RuntimeDependencies.Add(Path.Combine(LibraryDirectory, "OVRLipSync.dll"), StagedFileType.NonUFS);
-        }
-        else if (Target.Platform == UnrealTargetPlatform.Mac)
-        {
-            PublicAdditionalLibraries.Add(Path.Combine(LibraryDirectory, "libOVRLipSyncShim.a"));
-            RuntimeDependencies.Add(Path.Combine(LibraryDirectory, "libOVRLipSync.dylib"), StagedFileType.NonUFS);
-        }
-        else if (Target.Platform == UnrealTargetPlatform.Android)
+        PublicDependencyModuleNames.Add("DeveloperSettings");
+        if (Target.bBuildEditor)
         {
-            string Android64Directory = Path.Combine(ThirdPartyDirectory, "Lib", "Android", "arm64-v8a");
-            string Android32Directory = Path.Combine(ThirdPartyDirectory, "Lib", "Android", "armeabi-v7a");
-            PublicSystemLibraryPaths.Add(LibraryDirectory);
-            PublicSystemLibraryPaths.Add(Android32Directory);
-            PublicSystemLibraryPaths.Add(Android64Directory);
-            AdditionalPropertiesForReceipt.Add("AndroidPlugin", Path.Combine(ModuleDirectory, "OVRLipSync_APL.xml"));
-            PublicAdditionalLibraries.Add(Path.Combine(Android32Directory, "libOVRLipSyncShim.a"));
-            PublicAdditionalLibraries.Add(Path.Combine(Android64Directory, "libOVRLipSyncShim.a"));
+            PrivateDependencyModuleNames.Add("TargetPlatform");
         }
+        PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 
+        PublicDependencyModuleNames.AddRange( new string[] { "Core", "CoreUObject", "Engine"});
     }
 }
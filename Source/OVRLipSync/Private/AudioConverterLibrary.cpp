@@ -7,6 +7,12 @@
  * - Added function `ParseWavHeader` for extracting WAV file metadata dynamically.
  * - Enhanced file loading logic to fallback on default parameters if WAV header parsing fails.
  * - Improved error handling and compatibility with various WAV file formats.
+ * - Replaced `ParseWavHeader` with a RIFF chunk walker, PCM is queued from a view of the data chunk.
+ * - Added memory-mapped loading through `OpenWaveFile` and `FOVRLipSyncWaveHandle`.
+ * - Added `StreamSoundFromDisk` to play long files with a constant amount of memory.
+ * - Convert 8/24/32-bit integer, float and multichannel WAVs to 16-bit mono or stereo on load.
+ * - Added `SetSoundFromLoadedWave` and `ParseWaveForPlayback` for loads done through async file I/O.
+ * - Added `SetSoundFromDiskCached` and clip cache controls backed by `FOVRLipSyncClipCache`.
  *
  * Licensed under standard Unreal Engine license.
  *******************************************************************************/
@@ -20,6 +26,85 @@
 #include "Sound/SoundNodeWavePlayer.h"
 #include "Sound/SoundWaveProcedural.h"
 #include "Components/AudioComponent.h"
+#include "OVRLipSyncAsyncWaveLoad.h"
+#include "OVRLipSyncClipCache.h"
+#include "OVRLipSyncPCMConverter.h"
+#include "OVRLipSyncWaveFormat.h"
+#include "OVRLipSyncWaveStreamer.h"
+
+namespace
+{
+// Layout assumed for files whose header can't be parsed
+constexpr int32 FallbackHeaderSize = 44;
+constexpr int32 FallbackSampleRate = 44100;
+constexpr int32 FallbackNumChannels = 2;
+
+USoundWaveProcedural *CreateProceduralSoundWave(const FOVRLipSyncWaveFormat &Format, float Duration)
+{
+	USoundWaveProcedural *SoundWave = NewObject<USoundWaveProcedural>();
+	SoundWave->SetSampleRate(Format.SampleRate);
+	SoundWave->NumChannels = Format.NumChannels;
+	SoundWave->Duration = Duration;
+	SoundWave->SoundGroup = SOUNDGROUP_Default;
+	return SoundWave;
+}
+
+void SetSoundFromWaveView(UAudioComponent *AudioComponent, const FOVRLipSyncWaveView &WaveView,
+						  const FString &SourceName)
+{
+	if (WaveView.Data.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("WAV file contains no audio data: %s"), *SourceName);
+		return;
+	}
+
+	// Procedural waves play 16-bit PCM, anything else is converted (and downmixed past stereo) while queueing
+	FOVRLipSyncPCMConverter Converter(WaveView.Format,
+									  FOVRLipSyncPCMConverter::GetInferenceChannels(WaveView.Format.NumChannels));
+
+	// Create a USoundWaveProcedural object
+	USoundWaveProcedural *SoundWave = CreateProceduralSoundWave(Converter.GetOutputFormat(), WaveView.GetDuration());
+
+	if (Converter.IsPassthrough())
+	{
+		// Queue the data chunk straight from the mapped file, no need to strip the header first
+		SoundWave->QueueAudio(WaveView.Data.GetData(), WaveView.Data.Num());
+	}
+	else
+	{
+		const int64 NumFrames = WaveView.GetNumFrames();
+		const int32 BlockFrames = WaveView.Format.SampleRate;
+		const int32 OutputBlockAlign = Converter.GetOutputFormat().BlockAlign;
+		TArray<uint8> Converted;
+		for (int64 Frame = 0; Frame < NumFrames; Frame += BlockFrames)
+		{
+			const int32 Frames = static_cast<int32>(FMath::Min<int64>(BlockFrames, NumFrames - Frame));
+			Converted.SetNumUninitialized(Frames * OutputBlockAlign);
+			Converter.Convert(WaveView.Data.GetData() + Frame * WaveView.Format.BlockAlign, Frames,
+							  reinterpret_cast<int16 *>(Converted.GetData()));
+			SoundWave->QueueAudio(Converted.GetData(), Converted.Num());
+		}
+	}
+
+	// Set the sound for the AudioComponent using the SoundWave
+	if (AudioComponent)
+	{
+		AudioComponent->SetSound(SoundWave);
+	}
+}
+} // namespace
+
+bool FOVRLipSyncWaveHandle::Initialize(const TSharedPtr<FOVRLipSyncFileBuffer> &InFile, FString *OutError)
+{
+	File.Reset();
+	View = FOVRLipSyncWaveView();
+	if (!InFile.IsValid() || !FOVRLipSyncWaveParser::Parse(InFile->GetView(), View, OutError))
+	{
+		return false;
+	}
+	File = InFile;
+	return true;
+}
 
 TArray<uint8> UAudioConverterLibrary::LoadWaveFile(const FString &FilePath)
 {
@@ -31,9 +116,11 @@ TArray<uint8> UAudioConverterLibrary::LoadWaveFile(const FString &FilePath)
 		return TArray<uint8>();
 	}
 
-	if (FileData.Num() <= 44)
+	FOVRLipSyncWaveView WaveView;
+	FString ParseError;
+	if (!FOVRLipSyncWaveParser::Parse(FileData, WaveView, &ParseError))
 	{
-		UE_LOG(LogTemp, Error, TEXT("File too short to be a valid WAV file: %s"), *FilePath);
+		UE_LOG(LogTemp, Error, TEXT("Not a valid WAV file: %s (%s)"), *FilePath, *ParseError);
 		return TArray<uint8>();
 	}
 	return FileData;
@@ -41,75 +128,151 @@ TArray<uint8> UAudioConverterLibrary::LoadWaveFile(const FString &FilePath)
 
 void UAudioConverterLibrary::SetSoundFromDisk(UAudioComponent *AudioComponent, const FString &FilePath)
 {
-	// Load sound file data from disk
-	TArray<uint8> FileData;
-	if (!FFileHelper::LoadFileToArray(FileData, *FilePath))
+	// Map sound file data from disk, pages are read as the data is queued
+	TSharedPtr<FOVRLipSyncFileBuffer> File = FOVRLipSyncFileBuffer::Open(FilePath);
+	if (!File)
 	{
 		UE_LOG(LogTemp, Error, TEXT("Failed to load file from disk: %s"), *FilePath);
 		return;
 	}
 
-	// Parse WAV header to get audio parameters
-	int32 SampleRate;
-	int32 NumChannels;
-	int32 BitsPerSample;
-	int32 HeaderSize; // Skipping the WAV header
+	// Locate the format and the PCM payload, the view points into the mapped file
+	FOVRLipSyncWaveView WaveView;
+	if (!ParseWaveForPlayback(File->GetView(), WaveView, FilePath))
+	{
+		return;
+	}
 
-	if (!ParseWavHeader(FileData, SampleRate, NumChannels, BitsPerSample, HeaderSize))
+	SetSoundFromWaveView(AudioComponent, WaveView, FilePath);
+}
+
+void UAudioConverterLibrary::SetSoundFromDiskCached(UAudioComponent *AudioComponent, const FString &FilePath)
+{
+	TSharedPtr<const FOVRLipSyncCachedClip> Clip = FOVRLipSyncClipCache::Get().FindOrLoad(FilePath);
+	if (!Clip.IsValid())
 	{
-		/*
-		// Return logic if default headers no needed
-		UE_LOG(LogTemp, Error, TEXT("Failed to parse WAV header: %s"), *FilePath);
 		return;
-		*/
+	}
+
+	// Every play gets its own wave, they all read the same cached buffer
+	UOVRLipSyncCachedSoundWave *SoundWave = NewObject<UOVRLipSyncCachedSoundWave>();
+	SoundWave->SetClip(Clip.ToSharedRef());
 
-		// Assuming the file is a 16-bit stereo WAV file at 44.1kHz
-		SampleRate = 44100;
-		NumChannels = 2;
-		BitsPerSample = 16;
-		HeaderSize = 44; 
+	if (AudioComponent)
+	{
+		AudioComponent->SetSound(SoundWave);
 	}
+}
 
+void UAudioConverterLibrary::SetClipCacheBudget(int64 BudgetBytes)
+{
+	FOVRLipSyncClipCache::Get().SetBudget(BudgetBytes);
+}
+
+void UAudioConverterLibrary::ClearClipCache()
+{
+	FOVRLipSyncClipCache::Get().Clear();
+}
+
+bool UAudioConverterLibrary::CacheFrameSequence(const FString &FilePath, UOVRLipSyncFrameSequence *Sequence)
+{
+	return FOVRLipSyncClipCache::Get().SetFrameSequence(FilePath, Sequence);
+}
 
+UOVRLipSyncFrameSequence *UAudioConverterLibrary::GetCachedFrameSequence(const FString &FilePath)
+{
+	return FOVRLipSyncClipCache::Get().GetFrameSequence(FilePath);
+}
 
-	if (FileData.Num() <= HeaderSize)
+bool UAudioConverterLibrary::ParseWaveForPlayback(TArrayView<const uint8> FileData, FOVRLipSyncWaveView &OutView,
+												  const FString &SourceName)
+{
+	FString ParseError;
+	if (FOVRLipSyncWaveParser::Parse(FileData, OutView, &ParseError))
 	{
-		UE_LOG(LogTemp, Error, TEXT("File too short to be a valid WAV file: %s"), *FilePath);
-		return;
+		return true;
 	}
 
-	// Create a USoundWaveProcedural object
-	USoundWaveProcedural *SoundWave = NewObject<USoundWaveProcedural>();
-	SoundWave->SetSampleRate(SampleRate);
-	SoundWave->NumChannels = NumChannels;
-	SoundWave->Duration = (FileData.Num() - HeaderSize) / (SampleRate * NumChannels * (BitsPerSample / 8.0f));
-	SoundWave->SoundGroup = SOUNDGROUP_Default;
+	/*
+	// Return logic if default headers no needed
+	UE_LOG(LogTemp, Error, TEXT("Failed to parse WAV header: %s"), *SourceName);
+	return false;
+	*/
+
+	if (FileData.Num() <= FallbackHeaderSize)
+	{
+		UE_LOG(LogTemp, Error, TEXT("File too short to be a valid WAV file: %s"), *SourceName);
+		return false;
+	}
 
-	// Skip the WAV header and add the PCM data to the SoundWave
-	FileData.RemoveAt(0, HeaderSize);
-	SoundWave->QueueAudio(FileData.GetData(), FileData.Num());
+	// Assuming the file is a 16-bit stereo WAV file at 44.1kHz
+	UE_LOG(LogTemp, Warning, TEXT("Failed to parse WAV header of %s (%s), assuming 16-bit stereo at 44.1kHz"),
+		   *SourceName, *ParseError);
+	OutView.Format = FOVRLipSyncWaveFormat::MakePCM16(FallbackSampleRate, FallbackNumChannels);
+	int32 DataSize = FileData.Num() - FallbackHeaderSize;
+	DataSize -= DataSize % OutView.Format.BlockAlign;
+	OutView.Data = FileData.Slice(FallbackHeaderSize, DataSize);
+	return true;
+}
+
+void UAudioConverterLibrary::SetSoundFromLoadedWave(UAudioComponent *AudioComponent,
+													const FOVRLipSyncLoadedWave &LoadedWave)
+{
+	const TArrayView<const uint8> PCMData = LoadedWave.GetPlaybackPCM();
+	if (!LoadedWave.IsValid() || PCMData.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("SetSoundFromLoadedWave called without loaded audio"));
+		return;
+	}
+
+	USoundWaveProcedural *SoundWave =
+		CreateProceduralSoundWave(LoadedWave.PlaybackFormat, LoadedWave.View.GetDuration());
+	SoundWave->QueueAudio(PCMData.GetData(), PCMData.Num());
 
-	// Set the sound for the AudioComponent using the SoundWave
 	if (AudioComponent)
 	{
 		AudioComponent->SetSound(SoundWave);
 	}
 }
 
-bool UAudioConverterLibrary::ParseWavHeader(const TArray<uint8> &FileData, int32 &SampleRate, int32 &NumChannels,
-											int32 &BitsPerSample, int32 &HeaderSize)
+bool UAudioConverterLibrary::OpenWaveFile(const FString &FilePath, FOVRLipSyncWaveHandle &OutHandle)
 {
-	// Check if the file is long enough to contain the WAV header
-	if (FileData.Num() <= 44)
+	FString ParseError;
+	if (!OutHandle.Initialize(FOVRLipSyncFileBuffer::Open(FilePath), &ParseError))
 	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to open WAV file: %s %s"), *FilePath, *ParseError);
 		return false;
 	}
+	return true;
+}
 
-	// Extract audio parameters from the WAV header
-	SampleRate = *(int32 *)&FileData[24];
-	NumChannels = *(int16 *)&FileData[22];
-	BitsPerSample = *(int16 *)&FileData[34];
-	HeaderSize = 44; // Skipping the WAV header
+void UAudioConverterLibrary::SetSoundFromWaveHandle(UAudioComponent *AudioComponent,
+													const FOVRLipSyncWaveHandle &WaveHandle)
+{
+	if (!WaveHandle.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("SetSoundFromWaveHandle called with an invalid handle"));
+		return;
+	}
+	SetSoundFromWaveView(AudioComponent, WaveHandle.View, TEXT("wave handle"));
+}
 
-	return true;
-}
\ No newline at end of file
+void UAudioConverterLibrary::StreamSoundFromDisk(UAudioComponent *AudioComponent, const FString &FilePath)
+{
+	FString OpenError;
+	TSharedPtr<FOVRLipSyncWaveStreamer> Streamer = FOVRLipSyncWaveStreamer::Open(FilePath, &OpenError);
+	if (!Streamer)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to open %s for streaming: %s"), *FilePath, *OpenError);
+		return;
+	}
+
+	// The wave owns the streamer through its underflow delegate
+	USoundWaveProcedural *SoundWave = CreateProceduralSoundWave(Streamer->GetFormat(), Streamer->GetDuration());
+	Streamer->Attach(SoundWave);
+
+	if (AudioComponent)
+	{
+		AudioComponent->SetSound(SoundWave);
+	}
+}
@@ -0,0 +1,75 @@
+/*******************************************************************************
+ * Filename    :   LoadWaveFileAsync.cpp
+ * Content     :   Latent Blueprint nodes loading WAV files without blocking the game thread
+ ******************************************************************************/
+
+#include "LoadWaveFileAsync.h"
+
+#include "Components/AudioComponent.h"
+#include "OVRLipSyncAsyncWaveLoad.h"
+
+ULoadWaveFileAsync *ULoadWaveFileAsync::LoadWaveFileAsync(UObject *WorldContextObject, const FString &FilePath)
+{
+	ULoadWaveFileAsync *BPNode = NewObject<ULoadWaveFileAsync>();
+	BPNode->FilePath = FilePath;
+	BPNode->RegisterWithGameInstance(WorldContextObject);
+	return BPNode;
+}
+
+ULoadWaveFileAsync *ULoadWaveFileAsync::SetSoundFromDiskAsync(UObject *WorldContextObject,
+															  UAudioComponent *AudioComponent, const FString &FilePath)
+{
+	ULoadWaveFileAsync *BPNode = NewObject<ULoadWaveFileAsync>();
+	BPNode->FilePath = FilePath;
+	BPNode->bSetSound = true;
+	BPNode->AudioComponent = AudioComponent;
+	BPNode->RegisterWithGameInstance(WorldContextObject);
+	return BPNode;
+}
+
+void ULoadWaveFileAsync::Activate()
+{
+	TWeakObjectPtr<ULoadWaveFileAsync> WeakThis(this);
+	Load = FOVRLipSyncAsyncWaveLoad::Start(FilePath, bSetSound,
+										   [WeakThis](FOVRLipSyncLoadedWave &&LoadedWave)
+										   {
+											   if (ULoadWaveFileAsync *This = WeakThis.Get())
+											   {
+												   This->OnLoadComplete(MoveTemp(LoadedWave));
+											   }
+										   });
+}
+
+void ULoadWaveFileAsync::Cancel()
+{
+	if (Load)
+	{
+		Load->Cancel();
+		Load.Reset();
+	}
+	Super::Cancel();
+}
+
+void ULoadWaveFileAsync::OnLoadComplete(FOVRLipSyncLoadedWave &&LoadedWave)
+{
+	Load.Reset();
+
+	FOVRLipSyncWaveHandle WaveFile;
+	const bool bSuccess = LoadedWave.IsValid();
+	if (bSuccess)
+	{
+		if (bSetSound)
+		{
+			UAudioConverterLibrary::SetSoundFromLoadedWave(AudioComponent.Get(), LoadedWave);
+		}
+		WaveFile.File = LoadedWave.File;
+		WaveFile.View = LoadedWave.View;
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to load file from disk: %s (%s)"), *FilePath, *LoadedWave.Error);
+	}
+
+	OnLoaded.Broadcast(WaveFile, bSuccess);
+	SetReadyToDestroy();
+}
@@ -25,6 +25,9 @@
 
 #include "Components/SkeletalMeshComponent.h"
 #include "OVRLipSyncModule.h"
+#include "OVRLipSyncStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Assign Visemes To Morph Targets"), STAT_OVRLipSync_AssignMorphTargets, STATGROUP_OVRLipSync);
 
 // Sets default values for this component's properties
 UOVRLipSyncActorComponentBase::UOVRLipSyncActorComponentBase() { Visemes.Init(0.0f, VisemeNames.Num()); }
@@ -38,6 +41,9 @@ const float UOVRLipSyncActorComponentBase::GetLaughterScore() const { return Lau
 void UOVRLipSyncActorComponentBase::AssignVisemesToMorphTargets(USkeletalMeshComponent *Mesh,
 																const TArray<FString> &InMorphTargetNames)
 {
+	SCOPE_CYCLE_COUNTER(STAT_OVRLipSync_AssignMorphTargets);
+	TRACE_CPUPROFILER_EVENT_SCOPE(OVRLipSync::AssignVisemesToMorphTargets);
+
 	auto MorphTargetNames = InMorphTargetNames.Num() > 0 ? InMorphTargetNames : VisemeNames;
 	if (Mesh == nullptr)
 	{
@@ -67,8 +73,21 @@ void UOVRLipSyncActorComponentBase::InitNeutralPose()
 	{
 		Visemes[idx] = 0.0f;
 	}
+	INC_DWORD_STAT(STAT_OVRLipSync_Broadcasts);
 	OnVisemesReady.Broadcast();
 }
+
+void UOVRLipSyncActorComponentBase::RecordUpdate(uint64 StartCycles)
+{
+	const uint64 Cycles = FPlatformTime::Cycles64() - StartCycles;
+	if (UpdateCounters.NumUpdates++ == 0)
+	{
+		UpdateCounters.FirstCycles = StartCycles;
+	}
+	UpdateCounters.LastCycles = StartCycles;
+	UpdateCounters.TotalCycles += Cycles;
+	UpdateCounters.PeakCycles = FMath::Max(UpdateCounters.PeakCycles, Cycles);
+}
 const TArray<FString> UOVRLipSyncActorComponentBase::VisemeNames = {
 	FString(TEXT("sil")), FString(TEXT("PP")), FString(TEXT("FF")), FString(TEXT("TH")), FString(TEXT("DD")),
 	FString(TEXT("kk")),  FString(TEXT("CH")), FString(TEXT("SS")), FString(TEXT("nn")), FString(TEXT("RR")),
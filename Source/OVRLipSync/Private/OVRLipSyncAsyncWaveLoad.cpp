@@ -0,0 +1,243 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncAsyncWaveLoad.cpp
+ * Content     :   Loads WAV files through async file I/O and prepares them off the game thread
+ ******************************************************************************/
+
+#include "OVRLipSyncAsyncWaveLoad.h"
+
+#include "Async/Async.h"
+#include "AudioConverterLibrary.h"
+#include "HAL/PlatformFileManager.h"
+#include "OVRLipSyncFileBuffer.h"
+#include "OVRLipSyncPCMConverter.h"
+
+FCriticalSection FOVRLipSyncAsyncWaveLoad::QueueLock;
+int32 FOVRLipSyncAsyncWaveLoad::NumActiveLoads = 0;
+TArray<TSharedRef<FOVRLipSyncAsyncWaveLoad>> FOVRLipSyncAsyncWaveLoad::QueuedLoads;
+
+namespace
+{
+FOVRLipSyncLoadedWave MakeError(const TCHAR *Error)
+{
+	FOVRLipSyncLoadedWave Result;
+	Result.Error = Error;
+	return Result;
+}
+} // namespace
+
+FOVRLipSyncAsyncWaveLoad::FOVRLipSyncAsyncWaveLoad(const FString &InFilePath, bool bInPreparePlayback,
+												   FOnComplete &&InOnComplete)
+	: FilePath(InFilePath), bPreparePlayback(bInPreparePlayback), OnComplete(MoveTemp(InOnComplete))
+{
+}
+
+FOVRLipSyncAsyncWaveLoad::~FOVRLipSyncAsyncWaveLoad()
+{
+	ReleaseRequest();
+}
+
+TSharedRef<FOVRLipSyncAsyncWaveLoad> FOVRLipSyncAsyncWaveLoad::Start(const FString &FilePath, bool bPreparePlayback,
+																	 FOnComplete &&OnComplete)
+{
+	TSharedRef<FOVRLipSyncAsyncWaveLoad> Load =
+		MakeShareable(new FOVRLipSyncAsyncWaveLoad(FilePath, bPreparePlayback, MoveTemp(OnComplete)));
+
+	bool bHasSlot = false;
+	{
+		FScopeLock Lock(&QueueLock);
+		bHasSlot = NumActiveLoads < MaxConcurrentLoads;
+		if (bHasSlot)
+		{
+			++NumActiveLoads;
+		}
+		else
+		{
+			QueuedLoads.Add(Load);
+		}
+	}
+
+	if (bHasSlot)
+	{
+		Load->Begin();
+	}
+	return Load;
+}
+
+void FOVRLipSyncAsyncWaveLoad::Cancel()
+{
+	check(IsInGameThread());
+	bCancelled = true;
+
+	// A queued load never got a slot, dropping it from the queue is enough
+	{
+		FScopeLock Lock(&QueueLock);
+		QueuedLoads.Remove(AsShared());
+	}
+
+	FScopeLock Lock(&RequestLock);
+	if (Request)
+	{
+		Request->Cancel();
+	}
+}
+
+void FOVRLipSyncAsyncWaveLoad::Begin()
+{
+	if (bCancelled)
+	{
+		Finish(MakeError(TEXT("cancelled")));
+		return;
+	}
+
+	FileHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenAsyncRead(*FilePath));
+	if (!FileHandle)
+	{
+		Finish(MakeError(TEXT("failed to open file")));
+		return;
+	}
+
+	// Callbacks run on the I/O thread, continue on a worker so the request can be deleted
+	TSharedRef<FOVRLipSyncAsyncWaveLoad> This = AsShared();
+	FScopeLock Lock(&RequestLock);
+	RequestCallback = [This](bool bWasCancelled, IAsyncReadRequest *InRequest)
+	{
+		const int64 FileSize = bWasCancelled ? INDEX_NONE : InRequest->GetSizeResults();
+		AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [This, FileSize]() { This->OnSizeKnown(FileSize); });
+	};
+	Request = FileHandle->SizeRequest(&RequestCallback);
+}
+
+void FOVRLipSyncAsyncWaveLoad::OnSizeKnown(int64 FileSize)
+{
+	ReleaseRequest();
+	if (bCancelled)
+	{
+		Finish(MakeError(TEXT("cancelled")));
+		return;
+	}
+	if (FileSize <= 0)
+	{
+		Finish(MakeError(TEXT("failed to read file")));
+		return;
+	}
+	if (FileSize > MAX_int32)
+	{
+		Finish(MakeError(TEXT("file is too large to load at once, stream it instead")));
+		return;
+	}
+
+	Bytes.SetNumUninitialized(static_cast<int32>(FileSize));
+
+	TSharedRef<FOVRLipSyncAsyncWaveLoad> This = AsShared();
+	FScopeLock Lock(&RequestLock);
+	RequestCallback = [This](bool bWasCancelled, IAsyncReadRequest *InRequest)
+	{
+		AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask,
+				  [This, bWasCancelled]() { This->OnReadDone(!bWasCancelled); });
+	};
+	Request = FileHandle->ReadRequest(0, FileSize, AIOP_Normal, &RequestCallback, Bytes.GetData());
+}
+
+void FOVRLipSyncAsyncWaveLoad::OnReadDone(bool bSucceeded)
+{
+	ReleaseRequest();
+	FileHandle.Reset();
+
+	if (bCancelled)
+	{
+		Finish(MakeError(TEXT("cancelled")));
+		return;
+	}
+	if (!bSucceeded)
+	{
+		Finish(MakeError(TEXT("failed to read file")));
+		return;
+	}
+
+	FOVRLipSyncLoadedWave Result;
+	Prepare(Result);
+	Finish(MoveTemp(Result));
+}
+
+void FOVRLipSyncAsyncWaveLoad::Prepare(FOVRLipSyncLoadedWave &Result)
+{
+	TSharedRef<FOVRLipSyncFileBuffer> File = FOVRLipSyncFileBuffer::FromArray(MoveTemp(Bytes));
+
+	if (!bPreparePlayback)
+	{
+		if (FOVRLipSyncWaveParser::Parse(File->GetView(), Result.View, &Result.Error))
+		{
+			Result.File = File;
+		}
+		return;
+	}
+
+	if (!UAudioConverterLibrary::ParseWaveForPlayback(File->GetView(), Result.View, FilePath))
+	{
+		Result.Error = TEXT("not a playable WAV file");
+		return;
+	}
+
+	// Do the conversion procedural waves would otherwise need on the game thread
+	FOVRLipSyncPCMConverter Converter(Result.View.Format,
+									  FOVRLipSyncPCMConverter::GetInferenceChannels(Result.View.Format.NumChannels));
+	Result.PlaybackFormat = Converter.GetOutputFormat();
+	if (!Converter.IsPassthrough())
+	{
+		const int64 NumFrames = Result.View.GetNumFrames();
+		const int64 ConvertedSize = NumFrames * Result.PlaybackFormat.BlockAlign;
+		if (ConvertedSize > MAX_int32)
+		{
+			Result.Error = TEXT("file is too large to load at once, stream it instead");
+			return;
+		}
+		Result.ConvertedPCM.SetNumUninitialized(static_cast<int32>(ConvertedSize));
+		Converter.Convert(Result.View.Data.GetData(), NumFrames,
+						  reinterpret_cast<int16 *>(Result.ConvertedPCM.GetData()));
+	}
+	Result.File = File;
+}
+
+void FOVRLipSyncAsyncWaveLoad::Finish(FOVRLipSyncLoadedWave &&Result)
+{
+	// Hand the slot over to the oldest queued load
+	TSharedPtr<FOVRLipSyncAsyncWaveLoad> Next;
+	{
+		FScopeLock Lock(&QueueLock);
+		if (QueuedLoads.Num() > 0)
+		{
+			Next = QueuedLoads[0];
+			QueuedLoads.RemoveAt(0);
+		}
+		else
+		{
+			--NumActiveLoads;
+		}
+	}
+	if (Next)
+	{
+		Next->Begin();
+	}
+
+	AsyncTask(ENamedThreads::GameThread,
+			  [This = AsShared(), Result = MoveTemp(Result)]() mutable
+			  {
+				  if (!This->bCancelled && This->OnComplete)
+				  {
+					  This->OnComplete(MoveTemp(Result));
+				  }
+				  This->OnComplete.Reset();
+			  });
+}
+
+void FOVRLipSyncAsyncWaveLoad::ReleaseRequest()
+{
+	FScopeLock Lock(&RequestLock);
+	if (Request)
+	{
+		Request->WaitCompletion();
+		delete Request;
+		Request = nullptr;
+	}
+	RequestCallback.Reset();
+}
@@ -0,0 +1,214 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncClipCache.cpp
+ * Content     :   Memory-budgeted cache of decoded clips loaded from disk
+ ******************************************************************************/
+
+#include "OVRLipSyncClipCache.h"
+
+#include "AudioConverterLibrary.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "OVRLipSyncFrame.h"
+#include "OVRLipSyncPCMConverter.h"
+
+namespace
+{
+TSharedPtr<FOVRLipSyncCachedClip> LoadClip(const FString &FilePath)
+{
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *FilePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to load file from disk: %s"), *FilePath);
+		return nullptr;
+	}
+
+	FOVRLipSyncWaveView WaveView;
+	if (!UAudioConverterLibrary::ParseWaveForPlayback(FileData, WaveView, FilePath))
+	{
+		return nullptr;
+	}
+	if (WaveView.Data.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("WAV file contains no audio data: %s"), *FilePath);
+		return nullptr;
+	}
+
+	FOVRLipSyncPCMConverter Converter(WaveView.Format,
+									  FOVRLipSyncPCMConverter::GetInferenceChannels(WaveView.Format.NumChannels));
+	TSharedPtr<FOVRLipSyncCachedClip> Clip = MakeShared<FOVRLipSyncCachedClip>();
+	Clip->Format = Converter.GetOutputFormat();
+	if (Converter.IsPassthrough())
+	{
+		Clip->PCM.Append(WaveView.Data.GetData(), WaveView.Data.Num());
+	}
+	else
+	{
+		const int64 NumFrames = WaveView.GetNumFrames();
+		const int64 ConvertedSize = NumFrames * Clip->Format.BlockAlign;
+		if (ConvertedSize > MAX_int32)
+		{
+			UE_LOG(LogTemp, Error, TEXT("File is too large to cache: %s"), *FilePath);
+			return nullptr;
+		}
+		Clip->PCM.SetNumUninitialized(static_cast<int32>(ConvertedSize));
+		Converter.Convert(WaveView.Data.GetData(), NumFrames, reinterpret_cast<int16 *>(Clip->PCM.GetData()));
+	}
+	return Clip;
+}
+} // namespace
+
+void UOVRLipSyncCachedSoundWave::SetClip(const TSharedRef<const FOVRLipSyncCachedClip> &InClip)
+{
+	Clip = InClip;
+	ReadOffset = 0;
+	SetSampleRate(InClip->Format.SampleRate);
+	NumChannels = InClip->Format.NumChannels;
+	Duration = InClip->GetDuration();
+	SoundGroup = SOUNDGROUP_Default;
+}
+
+int32 UOVRLipSyncCachedSoundWave::OnGeneratePCMAudio(TArray<uint8> &OutAudio, int32 NumSamples)
+{
+	if (!Clip.IsValid())
+	{
+		return 0;
+	}
+
+	const int32 Bytes = FMath::Min(NumSamples * static_cast<int32>(sizeof(int16)), Clip->PCM.Num() - ReadOffset);
+	if (Bytes <= 0)
+	{
+		return 0;
+	}
+	OutAudio.Append(Clip->PCM.GetData() + ReadOffset, Bytes);
+	ReadOffset += Bytes;
+	return Bytes / static_cast<int32>(sizeof(int16));
+}
+
+FOVRLipSyncClipCache &FOVRLipSyncClipCache::Get()
+{
+	static FOVRLipSyncClipCache Cache;
+	return Cache;
+}
+
+TSharedPtr<const FOVRLipSyncCachedClip> FOVRLipSyncClipCache::FindOrLoad(const FString &FilePath)
+{
+	check(IsInGameThread());
+
+	if (FEntry *Entry = FindEntry(FilePath))
+	{
+		return Entry->Clip;
+	}
+
+	TSharedPtr<const FOVRLipSyncCachedClip> Clip = LoadClip(FilePath);
+	if (!Clip.IsValid())
+	{
+		return nullptr;
+	}
+	if (Clip->PCM.GetAllocatedSize() > BudgetBytes)
+	{
+		// Larger than the whole cache, play it without evicting everything else
+		return Clip;
+	}
+
+	FEntry &Entry = Entries.Add(FPaths::ConvertRelativePathToFull(FilePath));
+	Entry.TimeStamp = IFileManager::Get().GetTimeStamp(*FilePath);
+	Entry.Clip = Clip;
+	Entry.LastUse = ++UseCounter;
+	UpdateSize(Entry);
+	Trim(&Entry);
+	return Clip;
+}
+
+bool FOVRLipSyncClipCache::SetFrameSequence(const FString &FilePath, UOVRLipSyncFrameSequence *Sequence)
+{
+	check(IsInGameThread());
+
+	FEntry *Entry = FindEntry(FilePath);
+	if (!Entry)
+	{
+		return false;
+	}
+	Entry->Sequence.Reset(Sequence);
+	UpdateSize(*Entry);
+	Trim(Entry);
+	return true;
+}
+
+UOVRLipSyncFrameSequence *FOVRLipSyncClipCache::GetFrameSequence(const FString &FilePath)
+{
+	check(IsInGameThread());
+
+	FEntry *Entry = FindEntry(FilePath);
+	return Entry ? Entry->Sequence.Get() : nullptr;
+}
+
+void FOVRLipSyncClipCache::SetBudget(int64 InBudgetBytes)
+{
+	check(IsInGameThread());
+
+	BudgetBytes = FMath::Max<int64>(InBudgetBytes, 0);
+	Trim();
+}
+
+void FOVRLipSyncClipCache::Clear()
+{
+	check(IsInGameThread());
+
+	// Sound waves already playing keep their clip alive until they're done
+	Entries.Empty();
+	CachedBytes = 0;
+}
+
+FOVRLipSyncClipCache::FEntry *FOVRLipSyncClipCache::FindEntry(const FString &FilePath)
+{
+	const FString Key = FPaths::ConvertRelativePathToFull(FilePath);
+	FEntry *Entry = Entries.Find(Key);
+	if (!Entry)
+	{
+		return nullptr;
+	}
+	if (Entry->TimeStamp != IFileManager::Get().GetTimeStamp(*FilePath))
+	{
+		// The file changed on disk, its audio and sequence are both out of date
+		CachedBytes -= Entry->Size;
+		Entries.Remove(Key);
+		return nullptr;
+	}
+	Entry->LastUse = ++UseCounter;
+	return Entry;
+}
+
+void FOVRLipSyncClipCache::UpdateSize(FEntry &Entry)
+{
+	int64 Size = Entry.Clip->PCM.GetAllocatedSize();
+	if (const UOVRLipSyncFrameSequence *Sequence = Entry.Sequence.Get())
+	{
+		Size += Sequence->GetFramesAllocatedSize();
+	}
+	CachedBytes += Size - Entry.Size;
+	Entry.Size = Size;
+}
+
+void FOVRLipSyncClipCache::Trim(const FEntry *Keep)
+{
+	while (CachedBytes > BudgetBytes)
+	{
+		const FString *Oldest = nullptr;
+		uint64 OldestUse = MAX_uint64;
+		for (const TPair<FString, FEntry> &Pair : Entries)
+		{
+			if (&Pair.Value != Keep && Pair.Value.LastUse < OldestUse)
+			{
+				Oldest = &Pair.Key;
+				OldestUse = Pair.Value.LastUse;
+			}
+		}
+		if (!Oldest)
+		{
+			return;
+		}
+		CachedBytes -= Entries[*Oldest].Size;
+		Entries.Remove(FString(*Oldest));
+	}
+}
@@ -0,0 +1,276 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncCompactTrack.cpp
+ * Content     :   Reduced LipSync frames written to cooked packages
+ ******************************************************************************/
+
+#include "OVRLipSyncCompactTrack.h"
+
+#include "Misc/Compression.h"
+#include "OVRLipSyncFrame.h"
+#include "OVRLipSyncSettings.h"
+
+namespace
+{
+constexpr int32 SourceFrameRate = 100;
+
+uint8 GetBytesPerScore(EOVRLipSyncQuantization Quantization)
+{
+	switch (Quantization)
+	{
+	case EOVRLipSyncQuantization::Bits16:
+		return 2;
+	case EOVRLipSyncQuantization::Bits8:
+		return 1;
+	default:
+		return 4;
+	}
+}
+
+float GetSourceScore(const FOVRLipSyncFrame &Frame, int32 Viseme)
+{
+	return Frame.VisemeScores.IsValidIndex(Viseme) ? Frame.VisemeScores[Viseme] : 0.0f;
+}
+
+// Track frame Index covers the source frames played back while it is current
+void GetSourceRange(int32 Index, int32 FrameRate, int32 NumSourceFrames, int32 &OutFirst, int32 &OutLast)
+{
+	OutFirst = static_cast<int32>(static_cast<int64>(Index) * SourceFrameRate / FrameRate);
+	OutLast = static_cast<int32>((static_cast<int64>(Index + 1) * SourceFrameRate + FrameRate - 1) / FrameRate);
+	OutLast = FMath::Clamp(OutLast, OutFirst + 1, NumSourceFrames);
+}
+
+FOVRLipSyncCompactTrack BuildAtRate(const TArray<FOVRLipSyncFrame> &Frames, int32 FrameRate, int32 NumVisemes,
+									const TArray<uint8> &KeptVisemes, bool bHasLaughter, uint8 BytesPerScore)
+{
+	FOVRLipSyncCompactTrack Track;
+	Track.FrameRate = FrameRate;
+	Track.NumFrames =
+		static_cast<int32>((static_cast<int64>(Frames.Num()) * FrameRate + SourceFrameRate - 1) / SourceFrameRate);
+	Track.NumVisemes = NumVisemes;
+	Track.BytesPerScore = BytesPerScore;
+	Track.bHasLaughter = bHasLaughter;
+	Track.KeptVisemes = KeptVisemes;
+	Track.Scores.Reserve(Track.GetScoresSize());
+
+	// Each frame is the average of the source frames it replaces
+	TArray<float> Sums;
+	for (int32 Index = 0; Index < Track.NumFrames; ++Index)
+	{
+		int32 First, Last;
+		GetSourceRange(Index, FrameRate, Frames.Num(), First, Last);
+		Sums.Reset();
+		Sums.SetNumZeroed(KeptVisemes.Num() + 1);
+		for (int32 Source = First; Source < Last; ++Source)
+		{
+			for (int32 Kept = 0; Kept < KeptVisemes.Num(); ++Kept)
+			{
+				Sums[Kept] += GetSourceScore(Frames[Source], KeptVisemes[Kept]);
+			}
+			Sums.Last() += Frames[Source].LaughterScore;
+		}
+		const float Scale = 1.0f / (Last - First);
+		for (int32 Kept = 0; Kept < KeptVisemes.Num(); ++Kept)
+		{
+			Track.WriteScore(Sums[Kept] * Scale);
+		}
+		if (bHasLaughter)
+		{
+			Track.WriteScore(Sums.Last() * Scale);
+		}
+	}
+	return Track;
+}
+
+// Largest difference between a source frame and the track frame played at the same time
+float MeasureError(const TArray<FOVRLipSyncFrame> &Frames, const FOVRLipSyncCompactTrack &Track)
+{
+	float MaxError = 0.0f;
+	TArray<float> Visemes;
+	float LaughterScore = 0.0f;
+	for (int32 Source = 0; Source < Frames.Num(); ++Source)
+	{
+		const int32 Index =
+			FMath::Min(static_cast<int32>(static_cast<int64>(Source) * Track.FrameRate / SourceFrameRate),
+					   Track.NumFrames - 1);
+		Track.GetFrame(Index, Visemes, LaughterScore);
+		for (int32 Viseme = 0; Viseme < Visemes.Num(); ++Viseme)
+		{
+			MaxError = FMath::Max(MaxError, FMath::Abs(Visemes[Viseme] - GetSourceScore(Frames[Source], Viseme)));
+		}
+		// Stripped laughter is accepted whatever its error
+		if (Track.bHasLaughter)
+		{
+			MaxError = FMath::Max(MaxError, FMath::Abs(LaughterScore - Frames[Source].LaughterScore));
+		}
+	}
+	return MaxError;
+}
+} // namespace
+
+FOVRLipSyncCompactTrack FOVRLipSyncCompactTrack::Build(const TArray<FOVRLipSyncFrame> &Frames,
+													   const FOVRLipSyncPlatformCookSettings &Settings,
+													   float &OutMaxError)
+{
+	const int32 NumVisemes = Frames.Num() > 0 ? Frames[0].VisemeScores.Num() : 0;
+
+	// Visemes that never rise above MaxError may be dropped
+	TArray<uint8> KeptVisemes;
+	for (int32 Viseme = 0; Viseme < NumVisemes; ++Viseme)
+	{
+		float Peak = 0.0f;
+		for (const FOVRLipSyncFrame &Frame : Frames)
+		{
+			Peak = FMath::Max(Peak, GetSourceScore(Frame, Viseme));
+		}
+		if (!Settings.bStripUnusedVisemes || Peak > Settings.MaxError)
+		{
+			KeptVisemes.Add(static_cast<uint8>(Viseme));
+		}
+	}
+	const bool bHasLaughter = !Settings.bStripLaughter;
+	const uint8 BytesPerScore = GetBytesPerScore(Settings.Quantization);
+
+	int32 FrameRate = FMath::Clamp(Settings.FrameRate, 1, SourceFrameRate);
+	for (;;)
+	{
+		FOVRLipSyncCompactTrack Track =
+			BuildAtRate(Frames, FrameRate, NumVisemes, KeptVisemes, bHasLaughter, BytesPerScore);
+		OutMaxError = Track.IsEmpty() ? 0.0f : MeasureError(Frames, Track);
+		if (Settings.MaxError <= 0.0f || OutMaxError <= Settings.MaxError || FrameRate == SourceFrameRate)
+		{
+			return Track;
+		}
+		FrameRate = FMath::Min(FrameRate * 2, SourceFrameRate);
+	}
+}
+
+float FOVRLipSyncCompactTrack::ReadScore(const uint8 *Data) const
+{
+	switch (BytesPerScore)
+	{
+	case 1:
+		return Data[0] / 255.0f;
+	case 2:
+	{
+		uint16 Value;
+		FMemory::Memcpy(&Value, Data, sizeof(Value));
+		return Value / 65535.0f;
+	}
+	default:
+	{
+		float Value;
+		FMemory::Memcpy(&Value, Data, sizeof(Value));
+		return Value;
+	}
+	}
+}
+
+void FOVRLipSyncCompactTrack::WriteScore(float Score)
+{
+	const int32 Offset = Scores.AddUninitialized(BytesPerScore);
+	uint8 *Data = Scores.GetData() + Offset;
+	switch (BytesPerScore)
+	{
+	case 1:
+		Data[0] = static_cast<uint8>(FMath::RoundToInt(FMath::Clamp(Score, 0.0f, 1.0f) * 255.0f));
+		break;
+	case 2:
+	{
+		const uint16 Value = static_cast<uint16>(FMath::RoundToInt(FMath::Clamp(Score, 0.0f, 1.0f) * 65535.0f));
+		FMemory::Memcpy(Data, &Value, sizeof(Value));
+		break;
+	}
+	default:
+		FMemory::Memcpy(Data, &Score, sizeof(Score));
+		break;
+	}
+}
+
+void FOVRLipSyncCompactTrack::GetFrame(int32 Index, TArray<float> &OutVisemes, float &OutLaughterScore) const
+{
+	GetFrame(Scores.GetData(), Index, OutVisemes, OutLaughterScore);
+}
+
+void FOVRLipSyncCompactTrack::GetFrame(const uint8 *TrackScores, int32 Index, TArray<float> &OutVisemes,
+									   float &OutLaughterScore) const
+{
+	OutVisemes.Reset();
+	OutVisemes.SetNumZeroed(NumVisemes);
+	const uint8 *Data = TrackScores + static_cast<int64>(Index) * GetFrameSize();
+	for (const uint8 Viseme : KeptVisemes)
+	{
+		OutVisemes[Viseme] = ReadScore(Data);
+		Data += BytesPerScore;
+	}
+	OutLaughterScore = bHasLaughter ? ReadScore(Data) : 0.0f;
+}
+
+bool FOVRLipSyncCompactTrack::IsLayoutValid() const
+{
+	return (BytesPerScore == 1 || BytesPerScore == 2 || BytesPerScore == 4) && NumFrames >= 0 && FrameRate > 0 &&
+		   !KeptVisemes.ContainsByPredicate([this](uint8 Viseme) { return Viseme >= NumVisemes; });
+}
+
+void FOVRLipSyncCompactTrack::SerializeLayout(FArchive &Ar)
+{
+	Ar << FrameRate << NumFrames << NumVisemes << BytesPerScore << bHasLaughter << KeptVisemes;
+	if (Ar.IsLoading() && !IsLayoutValid())
+	{
+		Ar.SetError();
+		*this = FOVRLipSyncCompactTrack();
+	}
+}
+
+void FOVRLipSyncCompactTrack::Serialize(FArchive &Ar, bool bCompress)
+{
+	SerializeLayout(Ar);
+	SerializeScores(Ar, Scores, bCompress);
+
+	if (Ar.IsLoading() && (Ar.IsError() || Scores.Num() != GetScoresSize()))
+	{
+		Ar.SetError();
+		*this = FOVRLipSyncCompactTrack();
+	}
+}
+
+void FOVRLipSyncCompactTrack::SerializeScores(FArchive &Ar, TArray<uint8> &InOutScores, bool bCompress)
+{
+	// Scores are only written compressed when that makes them smaller
+	TArray<uint8> Compressed;
+	int32 UncompressedSize = InOutScores.Num();
+	if (Ar.IsSaving() && bCompress && UncompressedSize > 0)
+	{
+		int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, UncompressedSize);
+		Compressed.SetNumUninitialized(CompressedSize);
+		if (FCompression::CompressMemory(NAME_Zlib, Compressed.GetData(), CompressedSize, InOutScores.GetData(),
+										 UncompressedSize) &&
+			CompressedSize < UncompressedSize)
+		{
+			Compressed.SetNum(CompressedSize);
+		}
+		else
+		{
+			Compressed.Empty();
+		}
+	}
+	bool bCompressed = Compressed.Num() > 0;
+	Ar << bCompressed;
+	if (!bCompressed)
+	{
+		Ar << InOutScores;
+	}
+	else
+	{
+		Ar << UncompressedSize << Compressed;
+		if (Ar.IsLoading())
+		{
+			InOutScores.SetNumUninitialized(FMath::Max(UncompressedSize, 0));
+			if (UncompressedSize < 0 ||
+				!FCompression::UncompressMemory(NAME_Zlib, InOutScores.GetData(), UncompressedSize,
+												Compressed.GetData(), Compressed.Num()))
+			{
+				Ar.SetError();
+			}
+		}
+	}
+}
@@ -0,0 +1,120 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncConsoleCommands.cpp
+ * Content     :   Console commands listing LipSync components and loaded sequences
+ ******************************************************************************/
+
+#include "CoreMinimal.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "OVRLipSyncActorComponentBase.h"
+#include "OVRLipSyncFrame.h"
+#include "OVRLipSyncResidencyManager.h"
+#include "OVRLipSyncSequenceBank.h"
+#include "UObject/UObjectIterator.h"
+
+namespace
+{
+void ListComponents(const TArray<FString> &Args, UWorld *, FOutputDevice &Ar)
+{
+	TArray<const UOVRLipSyncActorComponentBase *> Components;
+	for (TObjectIterator<UOVRLipSyncActorComponentBase> It; It; ++It)
+	{
+		if (!It->IsTemplate() && It->IsRegistered() && It->GetWorld())
+		{
+			Components.Add(*It);
+		}
+	}
+	Components.Sort(
+		[](const UOVRLipSyncActorComponentBase &A, const UOVRLipSyncActorComponentBase &B)
+		{ return A.GetUpdateCounters().TotalCycles > B.GetUpdateCounters().TotalCycles; });
+
+	Ar.Logf(TEXT("%-40s %-10s %10s %10s %10s  %s"), TEXT("Component"), TEXT("Mode"), TEXT("Updates/s"),
+			TEXT("Avg us"), TEXT("Peak us"), TEXT("Details"));
+	int32 NumLive = 0;
+	double TotalMilliseconds = 0.0;
+	for (const UOVRLipSyncActorComponentBase *Component : Components)
+	{
+		const FOVRLipSyncUpdateCounters &Counters = Component->GetUpdateCounters();
+		const double Span = FPlatformTime::ToSeconds64(Counters.LastCycles - Counters.FirstCycles);
+		const double UpdateRate = Counters.NumUpdates > 1 && Span > 0.0 ? (Counters.NumUpdates - 1) / Span : 0.0;
+		const double Average =
+			Counters.NumUpdates > 0 ? FPlatformTime::ToSeconds64(Counters.TotalCycles) * 1e6 / Counters.NumUpdates
+									: 0.0;
+		FString Name = Component->GetName();
+		if (const AActor *Owner = Component->GetOwner())
+		{
+			Name = FString::Printf(TEXT("%s.%s"), *Owner->GetName(), *Name);
+		}
+		Ar.Logf(TEXT("%-40s %-10s %10.1f %10.1f %10.1f  %s"), *Name, Component->GetDebugMode(), UpdateRate, Average,
+				FPlatformTime::ToSeconds64(Counters.PeakCycles) * 1e6, *Component->GetDebugDetails());
+
+		NumLive += FCString::Strcmp(Component->GetDebugMode(), TEXT("Live")) == 0 ? 1 : 0;
+		TotalMilliseconds += FPlatformTime::ToMilliseconds64(Counters.TotalCycles);
+	}
+	Ar.Logf(TEXT("%d components, %d live, %.2f ms spent in updates since they started"), Components.Num(), NumLive,
+			TotalMilliseconds);
+}
+
+void ListMemory(const TArray<FString> &Args, UWorld *, FOutputDevice &Ar)
+{
+	struct FRow
+	{
+		const UObject *Asset;
+		int64 Bytes;
+	};
+	TArray<FRow> Rows;
+	for (TObjectIterator<UOVRLipSyncFrameSequence> It; It; ++It)
+	{
+		if (!It->IsTemplate())
+		{
+			Rows.Add({*It, static_cast<int64>(It->GetFramesAllocatedSize())});
+		}
+	}
+	for (TObjectIterator<UOVRLipSyncSequenceBank> It; It; ++It)
+	{
+		if (!It->IsTemplate())
+		{
+			Rows.Add({*It, static_cast<int64>(It->GetFramesAllocatedSize())});
+		}
+	}
+	Rows.Sort([](const FRow &A, const FRow &B) { return A.Bytes > B.Bytes; });
+
+	// LipSync.Memory 20 only lists the 20 largest assets
+	const int32 MaxRows = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 0) : Rows.Num();
+	const FOVRLipSyncResidencyManager &Residency = FOVRLipSyncResidencyManager::Get();
+	Ar.Logf(TEXT("%12s %-10s %6s  %s"), TEXT("KB"), TEXT("Type"), TEXT("Users"), TEXT("Asset"));
+	int64 TotalBytes = 0;
+	for (int32 Index = 0; Index < Rows.Num(); ++Index)
+	{
+		TotalBytes += Rows[Index].Bytes;
+		if (Index < MaxRows)
+		{
+			// Assets the residency manager doesn't track are kept alive by something else
+			const int32 NumUsers = Residency.GetNumUsers(Rows[Index].Asset);
+			Ar.Logf(TEXT("%12.1f %-10s %6s  %s"), Rows[Index].Bytes / 1024.0,
+					Rows[Index].Asset->IsA<UOVRLipSyncSequenceBank>() ? TEXT("Bank") : TEXT("Sequence"),
+					NumUsers == INDEX_NONE ? TEXT("-") : *FString::FromInt(NumUsers),
+					*Rows[Index].Asset->GetPathName());
+		}
+	}
+
+	const FOVRLipSyncResidencyStats Stats = Residency.GetStats();
+	Ar.Logf(TEXT("%d assets, %.1f KB of frames"), Rows.Num(), TotalBytes / 1024.0);
+	Ar.Logf(TEXT("Residency: %d tracked, %.1f of %.1f KB budget, %d in use (%.1f KB), peak %.1f KB, %d evictions"),
+			Stats.NumResident, Stats.ResidentBytes / 1024.0, Stats.BudgetBytes / 1024.0, Stats.NumInUse,
+			Stats.InUseBytes / 1024.0, Stats.PeakResidentBytes / 1024.0, Stats.NumEvictions);
+}
+
+FAutoConsoleCommandWithWorldArgsAndOutputDevice ListCommand(
+	TEXT("LipSync.List"),
+	TEXT("List every LipSync component with its mode, update rate, average and peak cost per update, and what it "
+		 "plays or streams."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&ListComponents));
+
+FAutoConsoleCommandWithWorldArgsAndOutputDevice MemoryCommand(
+	TEXT("LipSync.Memory"),
+	TEXT("List the frame memory of every loaded sequence and bank, largest first, and the residency budget. "
+		 "LipSync.Memory N lists the N largest."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&ListMemory));
+} // namespace
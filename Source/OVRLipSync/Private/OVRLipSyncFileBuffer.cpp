@@ -0,0 +1,58 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncFileBuffer.cpp
+ * Content     :   Read-only file contents backed by a memory mapping or a loaded array
+ ******************************************************************************/
+
+#include "OVRLipSyncFileBuffer.h"
+
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "OVRLipSyncModule.h"
+
+TSharedPtr<FOVRLipSyncFileBuffer> FOVRLipSyncFileBuffer::Open(const FString &FilePath, bool bAllowMapping)
+{
+	TSharedPtr<FOVRLipSyncFileBuffer> Buffer(new FOVRLipSyncFileBuffer());
+
+	if (bAllowMapping)
+	{
+		Buffer->MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+		// Views are 32-bit, larger files are loaded the regular way and rejected there. Large WAV files are streamed
+		// by IOVRLipSyncAudioDecoder::CreateForFile instead.
+		if (Buffer->MappedFile && Buffer->MappedFile->GetFileSize() > 0 &&
+			Buffer->MappedFile->GetFileSize() <= MAX_int32)
+		{
+			Buffer->MappedRegion.Reset(Buffer->MappedFile->MapRegion());
+		}
+		if (Buffer->MappedRegion)
+		{
+			Buffer->View = MakeArrayView(Buffer->MappedRegion->GetMappedPtr(),
+										 static_cast<int32>(Buffer->MappedRegion->GetMappedSize()));
+			return Buffer;
+		}
+		Buffer->MappedFile.Reset();
+	}
+
+	if (!FFileHelper::LoadFileToArray(Buffer->LoadedBytes, *FilePath))
+	{
+		UE_LOG(LogOvrLipSync, Error, TEXT("Failed to load file: %s"), *FilePath);
+		return nullptr;
+	}
+	Buffer->View = Buffer->LoadedBytes;
+	return Buffer;
+}
+
+TSharedRef<FOVRLipSyncFileBuffer> FOVRLipSyncFileBuffer::FromArray(TArray<uint8> &&Bytes)
+{
+	TSharedRef<FOVRLipSyncFileBuffer> Buffer(new FOVRLipSyncFileBuffer());
+	Buffer->LoadedBytes = MoveTemp(Bytes);
+	Buffer->View = Buffer->LoadedBytes;
+	return Buffer;
+}
+
+FOVRLipSyncFileBuffer::~FOVRLipSyncFileBuffer()
+{
+	// The region has to be unmapped before its file handle is closed
+	MappedRegion.Reset();
+	MappedFile.Reset();
+}
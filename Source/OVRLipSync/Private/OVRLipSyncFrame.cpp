@@ -0,0 +1,82 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncFrame.cpp
+ * Content     :   Serialization and playback access of LipSync sequences
+ ******************************************************************************/
+
+#include "OVRLipSyncFrame.h"
+
+#include "OVRLipSyncCustomVersion.h"
+#include "OVRLipSyncModule.h"
+#include "OVRLipSyncSettings.h"
+#include "Serialization/CustomVersion.h"
+
+#if WITH_EDITOR
+#include "Interfaces/ITargetPlatform.h"
+#endif
+
+const FGuid FOVRLipSyncCustomVersion::GUID(0x5AB837DC, 0x99CC47D5, 0x9B80A556, 0x65505C55);
+
+static FCustomVersionRegistration GRegisterOVRLipSyncCustomVersion(FOVRLipSyncCustomVersion::GUID,
+																  FOVRLipSyncCustomVersion::LatestVersion,
+																  TEXT("OVRLipSyncVer"));
+
+bool UOVRLipSyncFrameSequence::GetFrame(int32 Index, TArray<float> &OutVisemes, float &OutLaughterScore) const
+{
+	if (Index < 0 || Index >= static_cast<int32>(Num()))
+	{
+		return false;
+	}
+	if (FrameSequence.Num() > 0)
+	{
+		OutVisemes = FrameSequence[Index].VisemeScores;
+		OutLaughterScore = FrameSequence[Index].LaughterScore;
+	}
+	else
+	{
+		CompactTrack.GetFrame(Index, OutVisemes, OutLaughterScore);
+	}
+	return true;
+}
+
+SIZE_T UOVRLipSyncFrameSequence::GetFramesAllocatedSize() const
+{
+	SIZE_T Size = FrameSequence.GetAllocatedSize() + CompactTrack.GetAllocatedSize();
+	for (const FOVRLipSyncFrame &Frame : FrameSequence)
+	{
+		Size += Frame.VisemeScores.GetAllocatedSize();
+	}
+	return Size;
+}
+
+void UOVRLipSyncFrameSequence::Serialize(FArchive &Ar)
+{
+	Ar.UsingCustomVersion(FOVRLipSyncCustomVersion::GUID);
+
+#if WITH_EDITOR
+	if (Ar.IsSaving() && Ar.IsCooking() && Ar.CookingTarget() && FrameSequence.Num() > 0)
+	{
+		const FOVRLipSyncPlatformCookSettings &Settings =
+			UOVRLipSyncSettings::GetForPlatform(*Ar.CookingTarget()->IniPlatformName());
+		float MaxError = 0.0f;
+		FOVRLipSyncCompactTrack Track = FOVRLipSyncCompactTrack::Build(FrameSequence, Settings, MaxError);
+		if (Settings.MaxError > 0.0f && MaxError > Settings.MaxError)
+		{
+			UE_LOG(LogOvrLipSync, Warning, TEXT("%s: packaged frames differ by up to %.3f, above the maximum of %.3f"),
+				   *GetPathName(), MaxError, Settings.MaxError);
+		}
+
+		// The editor keeps the full precision frames, the package only gets the track
+		TArray<FOVRLipSyncFrame> SourceFrames = MoveTemp(FrameSequence);
+		Super::Serialize(Ar);
+		FrameSequence = MoveTemp(SourceFrames);
+		Track.Serialize(Ar, Settings.bCompress);
+		return;
+	}
+#endif
+
+	Super::Serialize(Ar);
+	if (Ar.CustomVer(FOVRLipSyncCustomVersion::GUID) >= FOVRLipSyncCustomVersion::AddedCompactTrack)
+	{
+		CompactTrack.Serialize(Ar);
+	}
+}
@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncLoadSequenceAsync.cpp
+ * Content     :   Blueprint access to asynchronous loading of LipSync sequences and banks
+ ******************************************************************************/
+
+#include "OVRLipSyncLoadSequenceAsync.h"
+
+#include "OVRLipSyncResidencyManager.h"
+#include "OVRLipSyncSequenceStreamer.h"
+
+UOVRLipSyncLoadSequenceAsync *
+UOVRLipSyncLoadSequenceAsync::LoadLipSyncSequence(TSoftObjectPtr<UOVRLipSyncFrameSequence> Sequence)
+{
+	UOVRLipSyncLoadSequenceAsync *Action = NewObject<UOVRLipSyncLoadSequenceAsync>();
+	Action->Path = Sequence.ToSoftObjectPath();
+	return Action;
+}
+
+UOVRLipSyncLoadSequenceAsync *
+UOVRLipSyncLoadSequenceAsync::LoadLipSyncBankEntry(TSoftObjectPtr<UOVRLipSyncSequenceBank> Bank, FName EntryId)
+{
+	UOVRLipSyncLoadSequenceAsync *Action = NewObject<UOVRLipSyncLoadSequenceAsync>();
+	Action->Path = Bank.ToSoftObjectPath();
+	Action->EntryId = EntryId;
+	return Action;
+}
+
+void UOVRLipSyncLoadSequenceAsync::Activate()
+{
+	FOVRLipSyncSequenceStreamer::Get().Request(
+		Path,
+		[WeakThis = TWeakObjectPtr<UOVRLipSyncLoadSequenceAsync>(this)](UObject *Asset)
+		{
+			if (!WeakThis.IsValid())
+			{
+				return;
+			}
+			UOVRLipSyncFrameSequence *Sequence = Cast<UOVRLipSyncFrameSequence>(Asset);
+			UOVRLipSyncSequenceBank *Bank = Cast<UOVRLipSyncSequenceBank>(Asset);
+			const bool bSuccess = Sequence || (Bank && Bank->Contains(WeakThis->EntryId));
+			WeakThis->OnLoaded.Broadcast(Sequence, Bank, bSuccess);
+			WeakThis->SetReadyToDestroy();
+		});
+}
+
+void UOVRLipSyncStreamingLibrary::PrefetchLipSyncSequences(
+	const TArray<TSoftObjectPtr<UOVRLipSyncFrameSequence>> &UpcomingSequences)
+{
+	TArray<FSoftObjectPath> Paths;
+	for (const TSoftObjectPtr<UOVRLipSyncFrameSequence> &Sequence : UpcomingSequences)
+	{
+		Paths.Add(Sequence.ToSoftObjectPath());
+	}
+	FOVRLipSyncSequenceStreamer::Get().Prefetch(Paths);
+}
+
+void UOVRLipSyncStreamingLibrary::PrefetchLipSyncBanks(
+	const TArray<TSoftObjectPtr<UOVRLipSyncSequenceBank>> &UpcomingBanks)
+{
+	TArray<FSoftObjectPath> Paths;
+	for (const TSoftObjectPtr<UOVRLipSyncSequenceBank> &Bank : UpcomingBanks)
+	{
+		Paths.Add(Bank.ToSoftObjectPath());
+	}
+	FOVRLipSyncSequenceStreamer::Get().Prefetch(Paths);
+}
+
+void UOVRLipSyncStreamingLibrary::SetLipSyncStreamingBudget(int64 BudgetBytes)
+{
+	FOVRLipSyncResidencyManager::Get().SetBudget(BudgetBytes);
+}
+
+FOVRLipSyncResidencyStats UOVRLipSyncStreamingLibrary::GetLipSyncResidencyStats()
+{
+	return FOVRLipSyncResidencyManager::Get().GetStats();
+}
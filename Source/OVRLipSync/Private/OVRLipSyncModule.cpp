@@ -23,14 +23,47 @@
 #include "OVRLipSyncModule.h"
 
 #include "Modules/ModuleManager.h"
-#include "OVRLipSync.h"
+#include "OVRLipSyncClipCache.h"
+#include "OVRLipSyncResidencyManager.h"
+#include "OVRLipSyncSequenceStreamer.h"
+#include "UObject/CoreRedirects.h"
 
 DEFINE_LOG_CATEGORY(LogOvrLipSync);
 
+namespace
+{
+FCoreRedirect MakeInferenceRedirect(ECoreRedirectFlags Flags, const TCHAR *Name)
+{
+	return FCoreRedirect(Flags, FString::Printf(TEXT("/Script/OVRLipSync.%s"), Name),
+						 FString::Printf(TEXT("/Script/OVRLipSyncInference.%s"), Name));
+}
+} // namespace
+
 class FOVRLipSyncModule : public IModuleInterface
 {
 public:
-	void ShutdownModule() override { ovrLipSync_Shutdown(); }
+	void StartupModule() override
+	{
+		// Capture and cooking moved to OVRLipSyncInference, keep assets and Blueprints saved before the split loading
+		const FCoreRedirect Redirects[] = {
+			MakeInferenceRedirect(ECoreRedirectFlags::Type_Class, TEXT("CookFrameSequenceAsync")),
+			MakeInferenceRedirect(ECoreRedirectFlags::Type_Class, TEXT("OVRLipSyncActorComponent")),
+			MakeInferenceRedirect(ECoreRedirectFlags::Type_Struct, TEXT("VisemeInterpolationSettings")),
+			MakeInferenceRedirect(ECoreRedirectFlags::Type_Struct, TEXT("OVRLipSyncPreprocessSettings")),
+			MakeInferenceRedirect(ECoreRedirectFlags::Type_Enum, TEXT("EOVRLipSyncResampleQuality")),
+			MakeInferenceRedirect(ECoreRedirectFlags::Type_Enum, TEXT("OVRLipSyncProviderKind")),
+			MakeInferenceRedirect(ECoreRedirectFlags::Type_Function, TEXT("FrameSequenceCoocked__DelegateSignature")),
+		};
+		FCoreRedirects::AddRedirectList(Redirects, TEXT("OVRLipSync"));
+	}
+
+	void ShutdownModule() override
+	{
+		// Cached sequences must be released while UObjects are still alive
+		FOVRLipSyncClipCache::Get().Clear();
+		FOVRLipSyncSequenceStreamer::Get().Clear();
+		FOVRLipSyncResidencyManager::Get().Shutdown();
+	}
 };
 
 IMPLEMENT_MODULE(FOVRLipSyncModule, OVRLipSync);
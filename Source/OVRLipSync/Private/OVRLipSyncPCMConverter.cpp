@@ -0,0 +1,239 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncPCMConverter.cpp
+ * Content     :   Conversion of PCM encodings to 16-bit mono or stereo
+ ******************************************************************************/
+
+#include "OVRLipSyncPCMConverter.h"
+
+#include "Math/VectorRegister.h"
+
+namespace
+{
+// Samples converted per block, sized so that the scratch buffers stay on the stack and in L1
+constexpr int32 BlockSamples = 1024;
+
+// Speaker position bits of WAVE_FORMAT_EXTENSIBLE channel masks
+constexpr uint32 SpeakerLowFrequency = 0x8;
+// Front, back, side and top left/right speakers
+constexpr uint32 SpeakersLeft = 0x1 | 0x10 | 0x40 | 0x200 | 0x1000 | 0x8000;
+constexpr uint32 SpeakersRight = 0x2 | 0x20 | 0x80 | 0x400 | 0x4000 | 0x20000;
+
+// Widen integer samples to left-justified 32-bit integers so that a single kernel converts all sizes
+void LoadAsInt32(const uint8 *Src, int32 BitsPerSample, int32 NumSamples, int32 *Dst)
+{
+	switch (BitsPerSample)
+	{
+	case 8:
+		// 8-bit WAV samples are unsigned
+		for (int32 i = 0; i < NumSamples; ++i)
+		{
+			Dst[i] = (int32(Src[i]) - 128) << 24;
+		}
+		break;
+	case 16:
+		for (int32 i = 0; i < NumSamples; ++i)
+		{
+			Dst[i] = int32(int16(uint16(Src[2 * i]) | (uint16(Src[2 * i + 1]) << 8))) << 16;
+		}
+		break;
+	case 24:
+		for (int32 i = 0; i < NumSamples; ++i)
+		{
+			Dst[i] = int32(uint32(Src[3 * i]) << 8 | uint32(Src[3 * i + 1]) << 16 | uint32(Src[3 * i + 2]) << 24);
+		}
+		break;
+	default:
+		FMemory::Memcpy(Dst, Src, NumSamples * sizeof(int32));
+		break;
+	}
+}
+
+void Int32ToFloat(const int32 *Src, int32 NumSamples, float *Dst)
+{
+	constexpr float Scale = 1.0f / 2147483648.0f;
+	const VectorRegister4Float ScaleVector = VectorSetFloat1(Scale);
+	int32 i = 0;
+	for (; i + 4 <= NumSamples; i += 4)
+	{
+		VectorStore(VectorMultiply(VectorIntToFloat(VectorIntLoad(Src + i)), ScaleVector), Dst + i);
+	}
+	for (; i < NumSamples; ++i)
+	{
+		Dst[i] = Src[i] * Scale;
+	}
+}
+
+void FloatToInt16(const float *Src, int32 NumSamples, int16 *Dst)
+{
+	// 32768 keeps 16-bit sources bit exact through the float round trip
+	constexpr float Scale = 32768.0f;
+	const VectorRegister4Float ScaleVector = VectorSetFloat1(Scale);
+	const VectorRegister4Float MinVector = VectorSetFloat1(-32768.0f);
+	const VectorRegister4Float MaxVector = VectorSetFloat1(32767.0f);
+	alignas(16) int32 Ints[4];
+	int32 i = 0;
+	for (; i + 4 <= NumSamples; i += 4)
+	{
+		VectorRegister4Float Value = VectorMultiply(VectorLoad(Src + i), ScaleVector);
+		Value = VectorMin(VectorMax(Value, MinVector), MaxVector);
+		VectorIntStoreAligned(VectorRoundToIntHalfEven(Value), Ints);
+		Dst[i] = static_cast<int16>(Ints[0]);
+		Dst[i + 1] = static_cast<int16>(Ints[1]);
+		Dst[i + 2] = static_cast<int16>(Ints[2]);
+		Dst[i + 3] = static_cast<int16>(Ints[3]);
+	}
+	for (; i < NumSamples; ++i)
+	{
+		Dst[i] = static_cast<int16>(FMath::Clamp(FMath::RoundToInt(Src[i] * Scale), -32768, 32767));
+	}
+}
+} // namespace
+
+FOVRLipSyncPCMConverter::FOVRLipSyncPCMConverter(const FOVRLipSyncWaveFormat &InFormat, int32 InOutputChannels)
+	: Format(InFormat), OutputChannels(FMath::Clamp(InOutputChannels, 1, 2))
+{
+	bPassthrough = Format.IsPCM16() && Format.NumChannels == OutputChannels;
+	BuildMixGains();
+}
+
+FOVRLipSyncWaveFormat FOVRLipSyncPCMConverter::GetOutputFormat() const
+{
+	return FOVRLipSyncWaveFormat::MakePCM16(Format.SampleRate, OutputChannels);
+}
+
+void FOVRLipSyncPCMConverter::BuildMixGains()
+{
+	const int32 NumChannels = Format.NumChannels;
+	MixGains.SetNumZeroed(OutputChannels * NumChannels);
+
+	if (NumChannels == OutputChannels)
+	{
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			MixGains[Channel * NumChannels + Channel] = 1.0f;
+		}
+		return;
+	}
+	if (NumChannels == 1)
+	{
+		// Mono to stereo
+		MixGains[0] = MixGains[1] = 1.0f;
+		return;
+	}
+
+	// Without a channel mask, channels follow the default WAVE speaker order (FL, FR, FC, LFE, BL, BR, ...)
+	const uint32 ChannelMask = Format.ChannelMask != 0 ? Format.ChannelMask : 0xFFFFFFFFu;
+	uint32 RemainingSpeakers = ChannelMask;
+	for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+	{
+		// Speaker of this channel is the next set bit of the mask, channels past the mask count as center
+		const uint32 Speaker = RemainingSpeakers & (~RemainingSpeakers + 1);
+		RemainingSpeakers &= ~Speaker;
+
+		float Left = UE_HALF_SQRT_2;
+		float Right = UE_HALF_SQRT_2;
+		if (Speaker == SpeakerLowFrequency)
+		{
+			Left = Right = 0.0f;
+		}
+		else if (Speaker & SpeakersLeft)
+		{
+			Left = 1.0f;
+			Right = 0.0f;
+		}
+		else if (Speaker & SpeakersRight)
+		{
+			Left = 0.0f;
+			Right = 1.0f;
+		}
+
+		if (OutputChannels == 1)
+		{
+			MixGains[Channel] = Speaker == SpeakerLowFrequency ? 0.0f : 1.0f;
+		}
+		else
+		{
+			MixGains[Channel] = Left;
+			MixGains[NumChannels + Channel] = Right;
+		}
+	}
+
+	// Normalize each output so that a signal present on all speakers doesn't clip
+	for (int32 Output = 0; Output < OutputChannels; ++Output)
+	{
+		float Sum = 0.0f;
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			Sum += MixGains[Output * NumChannels + Channel];
+		}
+		if (Sum > 0.0f)
+		{
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				MixGains[Output * NumChannels + Channel] /= Sum;
+			}
+		}
+	}
+}
+
+void FOVRLipSyncPCMConverter::Convert(const uint8 *Src, int64 NumFrames, int16 *Dst) const
+{
+	if (bPassthrough)
+	{
+		FMemory::Memcpy(Dst, Src, NumFrames * Format.BlockAlign);
+		return;
+	}
+
+	const int32 NumChannels = Format.NumChannels;
+	const int32 BlockFrames = FMath::Max(1, BlockSamples / NumChannels);
+	const bool bMix = NumChannels != OutputChannels;
+
+	TArray<int32, TInlineAllocator<BlockSamples>> Ints;
+	TArray<float, TInlineAllocator<BlockSamples>> Samples;
+	TArray<float, TInlineAllocator<BlockSamples * 2>> Mixed;
+	Ints.SetNumUninitialized(BlockFrames * NumChannels);
+	Samples.SetNumUninitialized(BlockFrames * NumChannels);
+	Mixed.SetNumUninitialized(BlockFrames * OutputChannels);
+
+	for (int64 Frame = 0; Frame < NumFrames; Frame += BlockFrames)
+	{
+		const int32 Frames = static_cast<int32>(FMath::Min<int64>(BlockFrames, NumFrames - Frame));
+		const int32 NumSamples = Frames * NumChannels;
+		const uint8 *BlockSrc = Src + Frame * Format.BlockAlign;
+
+		// Decode to float
+		if (Format.Encoding == EOVRLipSyncSampleEncoding::Float)
+		{
+			FMemory::Memcpy(Samples.GetData(), BlockSrc, NumSamples * sizeof(float));
+		}
+		else
+		{
+			LoadAsInt32(BlockSrc, Format.BitsPerSample, NumSamples, Ints.GetData());
+			Int32ToFloat(Ints.GetData(), NumSamples, Samples.GetData());
+		}
+
+		// Downmix
+		const float *Output = Samples.GetData();
+		if (bMix)
+		{
+			for (int32 FrameIndex = 0; FrameIndex < Frames; ++FrameIndex)
+			{
+				const float *In = Samples.GetData() + FrameIndex * NumChannels;
+				for (int32 OutChannel = 0; OutChannel < OutputChannels; ++OutChannel)
+				{
+					const float *Gains = MixGains.GetData() + OutChannel * NumChannels;
+					float Sum = 0.0f;
+					for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+					{
+						Sum += Gains[Channel] * In[Channel];
+					}
+					Mixed[FrameIndex * OutputChannels + OutChannel] = Sum;
+				}
+			}
+			Output = Mixed.GetData();
+		}
+
+		// Quantize
+		FloatToInt16(Output, Frames * OutputChannels, Dst + Frame * OutputChannels);
+	}
+}
@@ -23,6 +23,13 @@
 
 #include "OVRLipSyncPlaybackActorComponent.h"
 
+#include "Misc/ScopeExit.h"
+#include "OVRLipSyncResidencyManager.h"
+#include "OVRLipSyncSequenceStreamer.h"
+#include "OVRLipSyncStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Playback Update"), STAT_OVRLipSync_PlaybackUpdate, STATGROUP_OVRLipSync);
+
 UAudioComponent *UOVRLipSyncPlaybackActorComponent::FindAutoplayAudioComponent() const
 {
 	TArray<UAudioComponent *> AudioComponents;
@@ -44,7 +51,7 @@ UAudioComponent *UOVRLipSyncPlaybackActorComponent::FindAutoplayAudioComponent()
 void UOVRLipSyncPlaybackActorComponent::BeginPlay()
 {
 	Super::BeginPlay();
-	if (!Sequence)
+	if (!Sequence && !Bank)
 	{
 		return;
 	}
@@ -65,25 +72,26 @@ void UOVRLipSyncPlaybackActorComponent::EndPlay(const EEndPlayReason::Type EndPl
 void UOVRLipSyncPlaybackActorComponent::OnAudioPlaybackPercent(const UAudioComponent *, const USoundWave *SoundWave,
 															   float Percent)
 {
-	if (!Sequence)
-	{
-		InitNeutralPose();
-		return;
-	}
+	SCOPE_CYCLE_COUNTER(STAT_OVRLipSync_PlaybackUpdate);
+	TRACE_CPUPROFILER_EVENT_SCOPE(OVRLipSync::OnAudioPlaybackPercent);
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	ON_SCOPE_EXIT { RecordUpdate(StartCycles); };
 	auto PlayPos = SoundWave->Duration * Percent;
-	auto IntPos = static_cast<unsigned>(PlayPos * 100);
-	if (IntPos >= Sequence->Num())
+	if (!GetFrameAt(PlayPos, Visemes, LaughterScore))
 	{
 		InitNeutralPose();
 		return;
 	}
-	const auto &Frame = (*Sequence)[IntPos];
-	LaughterScore = Frame.LaughterScore;
-	Visemes = Frame.VisemeScores;
+	INC_DWORD_STAT(STAT_OVRLipSync_Broadcasts);
 	OnVisemesReady.Broadcast();
 }
 
-void UOVRLipSyncPlaybackActorComponent::OnAudioPlaybackFinished(UAudioComponent *) { InitNeutralPose(); }
+void UOVRLipSyncPlaybackActorComponent::OnAudioPlaybackFinished(UAudioComponent *)
+{
+	SetAssetInUse(nullptr);
+	InitNeutralPose();
+}
 
 void UOVRLipSyncPlaybackActorComponent::Start(UAudioComponent *InAudioComponent, UOVRLipSyncFrameSequence *InSequence)
 {
@@ -92,6 +100,8 @@ void UOVRLipSyncPlaybackActorComponent::Start(UAudioComponent *InAudioComponent,
 	{
 		Sequence = InSequence;
 	}
+	SetAssetInUse(Sequence ? static_cast<UObject *>(Sequence) : Bank);
+	ResetUpdateCounters();
 	PlaybackPercentHandle = AudioComponent->OnAudioPlaybackPercentNative.AddUObject(
 		this, &UOVRLipSyncPlaybackActorComponent::OnAudioPlaybackPercent);
 	PlaybackFinishedHandle = AudioComponent->OnAudioFinishedNative.AddUObject(
@@ -99,8 +109,51 @@ void UOVRLipSyncPlaybackActorComponent::Start(UAudioComponent *InAudioComponent,
 	AudioComponent->Play();
 }
 
+void UOVRLipSyncPlaybackActorComponent::StartBankEntry(UAudioComponent *InAudioComponent,
+														UOVRLipSyncSequenceBank *InBank, FName InEntryId)
+{
+	SetPlaybackBankEntry(InBank, InEntryId);
+	Start(InAudioComponent, nullptr);
+}
+
+void UOVRLipSyncPlaybackActorComponent::StartAsync(UAudioComponent *InAudioComponent,
+													TSoftObjectPtr<UOVRLipSyncFrameSequence> InSequence)
+{
+	const uint32 Request = ++LoadRequest;
+	FOVRLipSyncSequenceStreamer::Get().Request(
+		InSequence.ToSoftObjectPath(),
+		[this, WeakThis = TWeakObjectPtr<UOVRLipSyncPlaybackActorComponent>(this),
+		 WeakAudioComponent = TWeakObjectPtr<UAudioComponent>(InAudioComponent), Request](UObject *Asset)
+		{
+			UOVRLipSyncFrameSequence *LoadedSequence = Cast<UOVRLipSyncFrameSequence>(Asset);
+			if (WeakThis.IsValid() && WeakAudioComponent.IsValid() && LoadedSequence && Request == LoadRequest)
+			{
+				Start(WeakAudioComponent.Get(), LoadedSequence);
+			}
+		});
+}
+
+void UOVRLipSyncPlaybackActorComponent::StartBankEntryAsync(UAudioComponent *InAudioComponent,
+															 TSoftObjectPtr<UOVRLipSyncSequenceBank> InBank,
+															 FName InEntryId)
+{
+	const uint32 Request = ++LoadRequest;
+	FOVRLipSyncSequenceStreamer::Get().Request(
+		InBank.ToSoftObjectPath(),
+		[this, WeakThis = TWeakObjectPtr<UOVRLipSyncPlaybackActorComponent>(this),
+		 WeakAudioComponent = TWeakObjectPtr<UAudioComponent>(InAudioComponent), Request, InEntryId](UObject *Asset)
+		{
+			UOVRLipSyncSequenceBank *LoadedBank = Cast<UOVRLipSyncSequenceBank>(Asset);
+			if (WeakThis.IsValid() && WeakAudioComponent.IsValid() && LoadedBank && Request == LoadRequest)
+			{
+				StartBankEntry(WeakAudioComponent.Get(), LoadedBank, InEntryId);
+			}
+		});
+}
+
 void UOVRLipSyncPlaybackActorComponent::Stop()
 {
+	++LoadRequest;
 	if (!AudioComponent)
 	{
 		return;
@@ -108,6 +161,7 @@ void UOVRLipSyncPlaybackActorComponent::Stop()
 	AudioComponent->OnAudioPlaybackPercentNative.Remove(PlaybackPercentHandle);
 	AudioComponent->OnAudioFinishedNative.Remove(PlaybackFinishedHandle);
 	AudioComponent = nullptr;
+	SetAssetInUse(nullptr);
 	InitNeutralPose();
 }
 
@@ -116,26 +170,63 @@ void UOVRLipSyncPlaybackActorComponent::SetPlaybackSequence(UOVRLipSyncFrameSequ
 	Sequence = InSequence;
 }
 
-bool UOVRLipSyncPlaybackActorComponent::GetVisemesTimeBased(float Time, TArray<float> &OutVisemes,
-															float &OutLaughterScore)
+void UOVRLipSyncPlaybackActorComponent::SetPlaybackBankEntry(UOVRLipSyncSequenceBank *InBank, FName InEntryId)
+{
+	Sequence = nullptr;
+	Bank = InBank;
+	BankEntryId = InEntryId;
+}
+
+FString UOVRLipSyncPlaybackActorComponent::GetDebugDetails() const
 {
-	if (!Sequence)
+	FString Source = TEXT("no sequence");
+	if (Sequence)
 	{
-		OutVisemes.Empty();
-		OutLaughterScore = 0.f;
-		return false;
+		Source = Sequence->GetName();
 	}
+	else if (Bank)
+	{
+		Source = FString::Printf(TEXT("%s:%s"), *Bank->GetName(), *BankEntryId.ToString());
+	}
+	return FString::Printf(TEXT("%s, %s"), *Source, AudioComponent ? TEXT("playing") : TEXT("stopped"));
+}
 
-	int32 FrameIndex = static_cast<int32>(Time * 100);
-	if (FrameIndex < 0 || FrameIndex >= static_cast<int32>(Sequence->Num()))
+void UOVRLipSyncPlaybackActorComponent::SetAssetInUse(UObject *Asset)
+{
+	if (Asset == AssetInUse)
+	{
+		return;
+	}
+	FOVRLipSyncResidencyManager &Residency = FOVRLipSyncResidencyManager::Get();
+	Residency.AcquireUse(Asset);
+	Residency.ReleaseUse(AssetInUse);
+	AssetInUse = Asset;
+}
+
+bool UOVRLipSyncPlaybackActorComponent::GetFrameAt(float Time, TArray<float> &OutVisemes,
+												   float &OutLaughterScore) const
+{
+	if (Sequence)
+	{
+		return Sequence->GetFrame(static_cast<int32>(Time * Sequence->GetFrameRate()), OutVisemes, OutLaughterScore);
+	}
+	if (Bank)
+	{
+		const int32 Entry = Bank->FindEntry(BankEntryId);
+		return Bank->GetFrame(Entry, static_cast<int32>(Time * Bank->GetFrameRate(Entry)), OutVisemes,
+							  OutLaughterScore);
+	}
+	return false;
+}
+
+bool UOVRLipSyncPlaybackActorComponent::GetVisemesTimeBased(float Time, TArray<float> &OutVisemes,
+															float &OutLaughterScore)
+{
+	if (!GetFrameAt(Time, OutVisemes, OutLaughterScore))
 	{
 		OutVisemes.Empty();
 		OutLaughterScore = 0.f;
 		return false;
 	}
-
-	const auto &Frame = (*Sequence)[FrameIndex];
-	OutVisemes = Frame.VisemeScores;
-	OutLaughterScore = Frame.LaughterScore;
 	return true;
 }
@@ -0,0 +1,203 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncResidencyManager.cpp
+ * Content     :   Memory budget for loaded LipSync sequences and banks
+ ******************************************************************************/
+
+#include "OVRLipSyncResidencyManager.h"
+
+#include "Engine/StreamableManager.h"
+#include "OVRLipSyncFrame.h"
+#include "OVRLipSyncSequenceBank.h"
+#include "OVRLipSyncSettings.h"
+
+namespace
+{
+int64 GetAssetSize(const UObject *Asset)
+{
+	if (const UOVRLipSyncFrameSequence *Sequence = Cast<UOVRLipSyncFrameSequence>(Asset))
+	{
+		return Sequence->GetFramesAllocatedSize();
+	}
+	if (const UOVRLipSyncSequenceBank *Bank = Cast<UOVRLipSyncSequenceBank>(Asset))
+	{
+		return Bank->GetFramesAllocatedSize();
+	}
+	return 0;
+}
+} // namespace
+
+FOVRLipSyncResidencyManager &FOVRLipSyncResidencyManager::Get()
+{
+	static FOVRLipSyncResidencyManager Manager;
+	return Manager;
+}
+
+FOVRLipSyncResidencyManager::FOVRLipSyncResidencyManager()
+	: BudgetBytes(static_cast<int64>(GetDefault<UOVRLipSyncSettings>()->ResidencyBudgetMB) * 1024 * 1024)
+{
+}
+
+FOVRLipSyncResidencyManager::FEntry &FOVRLipSyncResidencyManager::FindOrAdd(UObject *Asset)
+{
+	FEntry *Entry = Entries.Find(Asset);
+	if (!Entry)
+	{
+		Entry = &Entries.Add(Asset);
+		Entry->Asset.Reset(Asset);
+		Entry->Size = GetAssetSize(Asset);
+		ResidentBytes += Entry->Size;
+		PeakResidentBytes = FMath::Max(PeakResidentBytes, ResidentBytes);
+	}
+	Entry->LastUse = ++UseCounter;
+	return *Entry;
+}
+
+void FOVRLipSyncResidencyManager::Register(UObject *Asset, TSharedPtr<FStreamableHandle> Handle)
+{
+	check(IsInGameThread());
+
+	if (!Asset)
+	{
+		return;
+	}
+	FEntry &Entry = FindOrAdd(Asset);
+	if (Handle.IsValid() && Entry.Handle != Handle)
+	{
+		if (Entry.Handle.IsValid())
+		{
+			Entry.Handle->ReleaseHandle();
+		}
+		Entry.Handle = MoveTemp(Handle);
+	}
+	Trim(Asset);
+}
+
+void FOVRLipSyncResidencyManager::AcquireUse(UObject *Asset)
+{
+	check(IsInGameThread());
+
+	if (!Asset)
+	{
+		return;
+	}
+	++FindOrAdd(Asset).NumUsers;
+	Trim();
+}
+
+void FOVRLipSyncResidencyManager::ReleaseUse(UObject *Asset)
+{
+	check(IsInGameThread());
+
+	FEntry *Entry = Asset ? Entries.Find(Asset) : nullptr;
+	if (Entry && Entry->NumUsers > 0)
+	{
+		--Entry->NumUsers;
+		Entry->LastUse = ++UseCounter;
+		Trim();
+	}
+}
+
+void FOVRLipSyncResidencyManager::SetBudget(int64 InBudgetBytes)
+{
+	check(IsInGameThread());
+
+	BudgetBytes = FMath::Max<int64>(InBudgetBytes, 0);
+	Trim();
+}
+
+FOVRLipSyncResidencyStats FOVRLipSyncResidencyManager::GetStats() const
+{
+	FOVRLipSyncResidencyStats Stats;
+	Stats.BudgetBytes = BudgetBytes;
+	Stats.ResidentBytes = ResidentBytes;
+	Stats.PeakResidentBytes = PeakResidentBytes;
+	Stats.NumResident = Entries.Num();
+	Stats.NumEvictions = NumEvictions;
+	for (const TPair<const UObject *, FEntry> &Pair : Entries)
+	{
+		if (Pair.Value.NumUsers > 0)
+		{
+			++Stats.NumInUse;
+			Stats.InUseBytes += Pair.Value.Size;
+		}
+	}
+	return Stats;
+}
+
+int32 FOVRLipSyncResidencyManager::GetNumUsers(const UObject *Asset) const
+{
+	const FEntry *Entry = Entries.Find(Asset);
+	return Entry ? Entry->NumUsers : INDEX_NONE;
+}
+
+void FOVRLipSyncResidencyManager::Clear()
+{
+	check(IsInGameThread());
+
+	TArray<const UObject *> Idle;
+	for (const TPair<const UObject *, FEntry> &Pair : Entries)
+	{
+		if (Pair.Value.NumUsers == 0)
+		{
+			Idle.Add(Pair.Key);
+		}
+	}
+	for (const UObject *Asset : Idle)
+	{
+		Evict(Asset);
+	}
+}
+
+void FOVRLipSyncResidencyManager::Shutdown()
+{
+	check(IsInGameThread());
+
+	for (TPair<const UObject *, FEntry> &Pair : Entries)
+	{
+		if (Pair.Value.Handle.IsValid())
+		{
+			Pair.Value.Handle->ReleaseHandle();
+		}
+	}
+	Entries.Empty();
+	ResidentBytes = 0;
+}
+
+void FOVRLipSyncResidencyManager::Trim(const UObject *Keep)
+{
+	while (ResidentBytes > BudgetBytes)
+	{
+		const UObject *Oldest = nullptr;
+		uint64 OldestUse = MAX_uint64;
+		for (const TPair<const UObject *, FEntry> &Pair : Entries)
+		{
+			if (Pair.Key != Keep && Pair.Value.NumUsers == 0 && Pair.Value.LastUse < OldestUse)
+			{
+				Oldest = Pair.Key;
+				OldestUse = Pair.Value.LastUse;
+			}
+		}
+		if (!Oldest)
+		{
+			// Everything left is being played, or was just registered
+			return;
+		}
+		Evict(Oldest);
+		++NumEvictions;
+	}
+}
+
+void FOVRLipSyncResidencyManager::Evict(const UObject *Asset)
+{
+	FEntry *Entry = Entries.Find(Asset);
+	if (!Entry)
+	{
+		return;
+	}
+	ResidentBytes -= Entry->Size;
+	if (Entry->Handle.IsValid())
+	{
+		Entry->Handle->ReleaseHandle();
+	}
+	Entries.Remove(Asset);
+}
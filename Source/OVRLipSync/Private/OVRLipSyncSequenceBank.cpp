@@ -0,0 +1,200 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncSequenceBank.cpp
+ * Content     :   Many LipSync tracks packed into one asset
+ ******************************************************************************/
+
+#include "OVRLipSyncSequenceBank.h"
+
+#include "OVRLipSyncCustomVersion.h"
+#include "OVRLipSyncFrame.h"
+#include "OVRLipSyncModule.h"
+#include "OVRLipSyncSettings.h"
+
+#if WITH_EDITOR
+#include "Interfaces/ITargetPlatform.h"
+#endif
+
+int32 UOVRLipSyncSequenceBank::FindEntry(FName Id) const
+{
+	const int32 *Entry = EntryIndex.Find(Id);
+	return Entry ? *Entry : INDEX_NONE;
+}
+
+bool UOVRLipSyncSequenceBank::GetFrame(int32 Entry, int32 Index, TArray<float> &OutVisemes,
+									   float &OutLaughterScore) const
+{
+	if (!Packed.Tracks.IsValidIndex(Entry) || Index < 0 || Index >= Packed.Tracks[Entry].NumFrames)
+	{
+		return false;
+	}
+	Packed.Tracks[Entry].GetFrame(Packed.Scores.GetData() + Packed.Offsets[Entry], Index, OutVisemes,
+								  OutLaughterScore);
+	return true;
+}
+
+SIZE_T UOVRLipSyncSequenceBank::GetFramesAllocatedSize() const
+{
+	return Packed.GetAllocatedSize() + EntryIndex.GetAllocatedSize();
+}
+
+void UOVRLipSyncSequenceBank::RebuildIndex()
+{
+	EntryIndex.Reset();
+	for (int32 Entry = 0; Entry < Packed.EntryIds.Num(); ++Entry)
+	{
+		EntryIndex.Add(Packed.EntryIds[Entry], Entry);
+	}
+}
+
+#if WITH_EDITOR
+bool UOVRLipSyncSequenceBank::Rebuild(FString *OutError)
+{
+	Packed.Reset();
+	EntryIndex.Reset();
+
+	// The default settings keep every frame at full precision, the packed frames match the sources exactly
+	const FOVRLipSyncPlatformCookSettings Lossless;
+	TArray<FString> Errors;
+	for (const FOVRLipSyncBankSource &Source : Sources)
+	{
+		const UOVRLipSyncFrameSequence *Sequence = Source.Sequence.LoadSynchronous();
+		const TCHAR *Reason = nullptr;
+		if (Source.Id.IsNone())
+		{
+			Reason = TEXT("no ID");
+		}
+		else if (EntryIndex.Contains(Source.Id))
+		{
+			Reason = TEXT("duplicate ID");
+		}
+		else if (!Sequence || Sequence->FrameSequence.Num() == 0)
+		{
+			Reason = TEXT("no frames");
+		}
+		if (Reason)
+		{
+			Errors.Add(
+				FString::Printf(TEXT("%s (%s): %s"), *Source.Id.ToString(), *Source.Sequence.ToString(), Reason));
+			continue;
+		}
+		float MaxError = 0.0f;
+		Packed.Add(Source.Id, FOVRLipSyncCompactTrack::Build(Sequence->FrameSequence, Lossless, MaxError));
+		EntryIndex.Add(Source.Id, Packed.EntryIds.Num() - 1);
+	}
+
+	if (OutError)
+	{
+		*OutError = FString::Join(Errors, TEXT(", "));
+	}
+	return Errors.Num() == 0;
+}
+
+void UOVRLipSyncSequenceBank::PostEditChangeProperty(FPropertyChangedEvent &PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	FString Error;
+	if (!Rebuild(&Error))
+	{
+		UE_LOG(LogOvrLipSync, Warning, TEXT("%s: some sources weren't packed: %s"), *GetPathName(), *Error);
+	}
+}
+#endif
+
+void UOVRLipSyncSequenceBank::Serialize(FArchive &Ar)
+{
+	Ar.UsingCustomVersion(FOVRLipSyncCustomVersion::GUID);
+	Super::Serialize(Ar);
+
+#if WITH_EDITOR
+	if (Ar.IsSaving() && Ar.IsCooking() && Ar.CookingTarget())
+	{
+		// Repack every entry with the packaging settings of the platform, the editor keeps the lossless entries
+		const FOVRLipSyncPlatformCookSettings &Settings =
+			UOVRLipSyncSettings::GetForPlatform(*Ar.CookingTarget()->IniPlatformName());
+		FOVRLipSyncPackedTracks Cooked;
+		TArray<FOVRLipSyncFrame> Frames;
+		for (int32 Entry = 0; Entry < Packed.Tracks.Num(); ++Entry)
+		{
+			Frames.SetNum(Packed.Tracks[Entry].NumFrames);
+			for (int32 Index = 0; Index < Frames.Num(); ++Index)
+			{
+				GetFrame(Entry, Index, Frames[Index].VisemeScores, Frames[Index].LaughterScore);
+			}
+			float MaxError = 0.0f;
+			Cooked.Add(Packed.EntryIds[Entry], FOVRLipSyncCompactTrack::Build(Frames, Settings, MaxError));
+		}
+		Cooked.Serialize(Ar, Settings.bCompress);
+		return;
+	}
+#endif
+
+	Packed.Serialize(Ar);
+	if (Ar.IsLoading())
+	{
+		if (Ar.IsError())
+		{
+			UE_LOG(LogOvrLipSync, Error, TEXT("%s: packed LipSync data is corrupt"), *GetPathName());
+		}
+		RebuildIndex();
+	}
+}
+
+void FOVRLipSyncPackedTracks::Add(FName Id, FOVRLipSyncCompactTrack &&Track)
+{
+	EntryIds.Add(Id);
+	Offsets.Add(Scores.Num());
+	Scores.Append(Track.Scores);
+	Track.Scores.Empty();
+	Tracks.Add(MoveTemp(Track));
+}
+
+void FOVRLipSyncPackedTracks::Reset()
+{
+	EntryIds.Reset();
+	Tracks.Reset();
+	Offsets.Reset();
+	Scores.Reset();
+}
+
+SIZE_T FOVRLipSyncPackedTracks::GetAllocatedSize() const
+{
+	SIZE_T Size = EntryIds.GetAllocatedSize() + Tracks.GetAllocatedSize() + Offsets.GetAllocatedSize() +
+				  Scores.GetAllocatedSize();
+	for (const FOVRLipSyncCompactTrack &Track : Tracks)
+	{
+		Size += Track.KeptVisemes.GetAllocatedSize();
+	}
+	return Size;
+}
+
+void FOVRLipSyncPackedTracks::Serialize(FArchive &Ar, bool bCompress)
+{
+	Ar << EntryIds << Offsets;
+	int32 NumTracks = Tracks.Num();
+	Ar << NumTracks;
+	if (Ar.IsLoading())
+	{
+		Tracks.SetNum(FMath::Max(NumTracks, 0));
+	}
+	for (FOVRLipSyncCompactTrack &Track : Tracks)
+	{
+		Track.SerializeLayout(Ar);
+	}
+	// The scores of every entry are read in one go
+	FOVRLipSyncCompactTrack::SerializeScores(Ar, Scores, bCompress);
+
+	if (Ar.IsLoading())
+	{
+		bool bValid = !Ar.IsError() && EntryIds.Num() == Tracks.Num() && Offsets.Num() == Tracks.Num();
+		for (int32 Entry = 0; bValid && Entry < Tracks.Num(); ++Entry)
+		{
+			bValid = Offsets[Entry] >= 0 && Offsets[Entry] + Tracks[Entry].GetScoresSize() <= Scores.Num();
+		}
+		if (!bValid)
+		{
+			Ar.SetError();
+			Reset();
+		}
+	}
+}
@@ -0,0 +1,129 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncSequenceStreamer.cpp
+ * Content     :   Asynchronous loading and prefetching of LipSync sequences and banks
+ ******************************************************************************/
+
+#include "OVRLipSyncSequenceStreamer.h"
+
+#include "OVRLipSyncResidencyManager.h"
+
+namespace
+{
+// Lines about to play load ahead of prefetched ones
+constexpr TAsyncLoadPriority RequestPriority = FStreamableManager::AsyncLoadHighPriority;
+constexpr TAsyncLoadPriority PrefetchPriority = FStreamableManager::DefaultAsyncLoadPriority;
+
+// The asset at Path when it is fully loaded
+UObject *FindLoaded(const FSoftObjectPath &Path)
+{
+	UObject *Asset = Path.ResolveObject();
+	return Asset && !Asset->HasAnyFlags(RF_NeedLoad | RF_NeedPostLoad) ? Asset : nullptr;
+}
+} // namespace
+
+FOVRLipSyncSequenceStreamer &FOVRLipSyncSequenceStreamer::Get()
+{
+	static FOVRLipSyncSequenceStreamer Streamer;
+	return Streamer;
+}
+
+void FOVRLipSyncSequenceStreamer::Request(const FSoftObjectPath &Path, FOnLoaded &&OnLoaded)
+{
+	check(IsInGameThread());
+
+	if (!PendingLoads.Contains(Path))
+	{
+		if (UObject *Asset = FindLoaded(Path))
+		{
+			FOVRLipSyncResidencyManager::Get().Register(Asset);
+			OnLoaded(Asset);
+			return;
+		}
+		if (Path.IsNull() || !Load(Path, RequestPriority))
+		{
+			OnLoaded(nullptr);
+			return;
+		}
+	}
+	if (FPendingLoad *Pending = PendingLoads.Find(Path))
+	{
+		Pending->Waiting.Add(MoveTemp(OnLoaded));
+	}
+	else
+	{
+		// The load completed synchronously
+		OnLoaded(FindLoaded(Path));
+	}
+}
+
+void FOVRLipSyncSequenceStreamer::Prefetch(const TArray<FSoftObjectPath> &Paths)
+{
+	check(IsInGameThread());
+
+	for (const FSoftObjectPath &Path : Paths)
+	{
+		if (Path.IsNull() || PendingLoads.Contains(Path))
+		{
+			continue;
+		}
+		if (UObject *Asset = FindLoaded(Path))
+		{
+			FOVRLipSyncResidencyManager::Get().Register(Asset);
+			continue;
+		}
+		Load(Path, PrefetchPriority);
+	}
+}
+
+void FOVRLipSyncSequenceStreamer::Clear()
+{
+	check(IsInGameThread());
+
+	for (TPair<FSoftObjectPath, FPendingLoad> &Pair : PendingLoads)
+	{
+		Pair.Value.Handle->ReleaseHandle();
+	}
+	PendingLoads.Empty();
+}
+
+bool FOVRLipSyncSequenceStreamer::Load(const FSoftObjectPath &Path, TAsyncLoadPriority Priority)
+{
+	TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(Path, FStreamableDelegate(), Priority);
+	if (!Handle.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to load LipSync asset %s"), *Path.ToString());
+		return false;
+	}
+	PendingLoads.Add(Path).Handle = Handle;
+
+	// Assets already in memory complete without waiting for the loader
+	if (!Handle->BindCompleteDelegate(
+			FStreamableDelegate::CreateRaw(this, &FOVRLipSyncSequenceStreamer::OnLoadDone, Path)))
+	{
+		OnLoadDone(Path);
+	}
+	return true;
+}
+
+void FOVRLipSyncSequenceStreamer::OnLoadDone(FSoftObjectPath Path)
+{
+	FPendingLoad Pending;
+	if (!PendingLoads.RemoveAndCopyValue(Path, Pending))
+	{
+		return;
+	}
+
+	UObject *Asset = Pending.Handle->GetLoadedAsset();
+	if (Asset)
+	{
+		FOVRLipSyncResidencyManager::Get().Register(Asset, Pending.Handle);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to load LipSync asset %s"), *Path.ToString());
+	}
+	for (FOnLoaded &OnLoaded : Pending.Waiting)
+	{
+		OnLoaded(Asset);
+	}
+}
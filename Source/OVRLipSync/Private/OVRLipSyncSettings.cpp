@@ -0,0 +1,13 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncSettings.cpp
+ * Content     :   Project settings of the OVRLipSync runtime
+ ******************************************************************************/
+
+#include "OVRLipSyncSettings.h"
+
+const FOVRLipSyncPlatformCookSettings &UOVRLipSyncSettings::GetForPlatform(FName IniPlatformName)
+{
+	const UOVRLipSyncSettings *Settings = GetDefault<UOVRLipSyncSettings>();
+	const FOVRLipSyncPlatformCookSettings *PlatformSettings = Settings->PlatformSettings.Find(IniPlatformName);
+	return PlatformSettings ? *PlatformSettings : Settings->DefaultSettings;
+}
@@ -0,0 +1,13 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncStats.cpp
+ * Content     :   Stats group and trace channel of the LipSync pipeline
+ ******************************************************************************/
+
+#include "OVRLipSyncStats.h"
+
+DEFINE_STAT(STAT_OVRLipSync_FramesInferred);
+DEFINE_STAT(STAT_OVRLipSync_FramesGated);
+DEFINE_STAT(STAT_OVRLipSync_Broadcasts);
+DEFINE_STAT(STAT_OVRLipSync_ActiveStreams);
+
+UE_TRACE_CHANNEL_DEFINE(OVRLipSyncChannel);
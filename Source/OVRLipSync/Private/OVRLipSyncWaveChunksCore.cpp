@@ -0,0 +1,179 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncWaveChunksCore.cpp
+ * Content     :   Engine independent RIFF/WAVE chunk walker
+ ******************************************************************************/
+
+#include "OVRLipSyncWaveChunksCore.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace OVRLipSyncCore
+{
+namespace
+{
+constexpr uint16_t WaveFormatPCM = 0x0001;
+constexpr uint16_t WaveFormatIEEEFloat = 0x0003;
+constexpr uint16_t WaveFormatExtensible = 0xFFFE;
+
+// Size of the RIFF header ("RIFF", size, "WAVE") and of a chunk header (id, size)
+constexpr int32_t RiffHeaderSize = 12;
+constexpr int32_t ChunkHeaderSize = 8;
+// Minimal fmt chunk (WAVEFORMAT + wBitsPerSample) and the WAVE_FORMAT_EXTENSIBLE one
+constexpr int32_t FmtChunkMinSize = 16;
+constexpr int32_t FmtChunkExtensibleSize = 40;
+
+// Trailing 14 bytes shared by all KSDATAFORMAT_SUBTYPE_* GUIDs of WAVE_FORMAT_EXTENSIBLE
+const uint8_t ExtensibleSubFormatSuffix[14] = {0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80,
+											   0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71};
+
+// WAV fields are little-endian and not guaranteed to be naturally aligned
+uint16_t ReadU16(const uint8_t *Ptr) { return uint16_t(Ptr[0] | (Ptr[1] << 8)); }
+
+uint32_t ReadU32(const uint8_t *Ptr)
+{
+	return uint32_t(Ptr[0]) | (uint32_t(Ptr[1]) << 8) | (uint32_t(Ptr[2]) << 16) | (uint32_t(Ptr[3]) << 24);
+}
+
+bool IsChunkId(const uint8_t *Ptr, const char (&Id)[5]) { return std::memcmp(Ptr, Id, 4) == 0; }
+
+bool Fail(const char **OutError, const char *Reason)
+{
+	if (OutError)
+	{
+		*OutError = Reason;
+	}
+	return false;
+}
+
+bool ParseFmtChunk(const uint8_t *Chunk, int32_t ChunkSize, FWaveFormat &OutFormat, const char **OutError)
+{
+	if (ChunkSize < FmtChunkMinSize)
+	{
+		return Fail(OutError, "fmt chunk is truncated");
+	}
+
+	uint16_t FormatTag = ReadU16(Chunk);
+	OutFormat.NumChannels = ReadU16(Chunk + 2);
+	OutFormat.SampleRate = static_cast<int>(ReadU32(Chunk + 4));
+	OutFormat.BlockAlign = ReadU16(Chunk + 12);
+	OutFormat.BitsPerSample = ReadU16(Chunk + 14);
+	OutFormat.ChannelMask = 0;
+
+	if (FormatTag == WaveFormatExtensible)
+	{
+		if (ChunkSize < FmtChunkExtensibleSize)
+		{
+			return Fail(OutError, "WAVE_FORMAT_EXTENSIBLE fmt chunk is truncated");
+		}
+		OutFormat.ChannelMask = ReadU32(Chunk + 20);
+		const uint8_t *SubFormat = Chunk + 24;
+		if (std::memcmp(SubFormat + 2, ExtensibleSubFormatSuffix, sizeof(ExtensibleSubFormatSuffix)) != 0)
+		{
+			return Fail(OutError, "unknown WAVE_FORMAT_EXTENSIBLE sub-format");
+		}
+		FormatTag = ReadU16(SubFormat);
+	}
+
+	switch (FormatTag)
+	{
+	case WaveFormatPCM:
+		OutFormat.Encoding = EWaveEncoding::PCM;
+		if (OutFormat.BitsPerSample != 8 && OutFormat.BitsPerSample != 16 && OutFormat.BitsPerSample != 24 &&
+			OutFormat.BitsPerSample != 32)
+		{
+			return Fail(OutError, "unsupported PCM sample size");
+		}
+		break;
+	case WaveFormatIEEEFloat:
+		OutFormat.Encoding = EWaveEncoding::Float;
+		if (OutFormat.BitsPerSample != 32)
+		{
+			return Fail(OutError, "unsupported floating point sample size");
+		}
+		break;
+	default:
+		return Fail(OutError, "compressed WAV encodings are not supported");
+	}
+
+	if (OutFormat.NumChannels <= 0 || OutFormat.SampleRate <= 0)
+	{
+		return Fail(OutError, "invalid channel count or sample rate");
+	}
+	if (OutFormat.BlockAlign != OutFormat.NumChannels * OutFormat.BitsPerSample / 8)
+	{
+		return Fail(OutError, "block alignment does not match channel count and sample size");
+	}
+	return true;
+}
+} // namespace
+
+bool ParseWaveChunks(int64_t FileSize, const FReadBytes &ReadBytes, FWaveFormat &OutFormat, int64_t &OutDataOffset,
+					 int64_t &OutDataSize, const char **OutError)
+{
+	uint8_t Header[RiffHeaderSize];
+	if (FileSize < RiffHeaderSize || !ReadBytes(0, RiffHeaderSize, Header) || !IsChunkId(Header, "RIFF") ||
+		!IsChunkId(Header + 8, "WAVE"))
+	{
+		return Fail(OutError, "not a RIFF/WAVE file");
+	}
+
+	// Don't trust the RIFF size blindly: writers that stream to disk often leave it unpatched
+	const int64_t RiffEnd = std::min<int64_t>(FileSize, ChunkHeaderSize + int64_t(ReadU32(Header + 4)));
+
+	bool bHasFormat = false;
+	OutDataOffset = -1;
+	OutDataSize = 0;
+
+	int64_t Offset = RiffHeaderSize;
+	while (Offset + ChunkHeaderSize <= RiffEnd)
+	{
+		uint8_t Chunk[ChunkHeaderSize];
+		if (!ReadBytes(Offset, ChunkHeaderSize, Chunk))
+		{
+			return Fail(OutError, "failed to read chunk header");
+		}
+		const int64_t ChunkSize = ReadU32(Chunk + 4);
+		const int64_t PayloadOffset = Offset + ChunkHeaderSize;
+		const int64_t PayloadAvailable = FileSize - PayloadOffset;
+
+		if (IsChunkId(Chunk, "fmt "))
+		{
+			// Only the WAVE_FORMAT_EXTENSIBLE part of the fmt chunk is of interest
+			uint8_t Fmt[FmtChunkExtensibleSize];
+			const int32_t FmtSize = static_cast<int32_t>(std::min<int64_t>(ChunkSize, FmtChunkExtensibleSize));
+			if (ChunkSize > PayloadAvailable || !ReadBytes(PayloadOffset, FmtSize, Fmt))
+			{
+				return Fail(OutError, "fmt chunk is truncated");
+			}
+			if (!ParseFmtChunk(Fmt, FmtSize, OutFormat, OutError))
+			{
+				return false;
+			}
+			bHasFormat = true;
+		}
+		else if (IsChunkId(Chunk, "data") && OutDataOffset < 0)
+		{
+			// Truncated files and unfinished recordings declare more data than they contain
+			OutDataOffset = PayloadOffset;
+			OutDataSize = std::min(ChunkSize, PayloadAvailable);
+		}
+
+		// Chunks are word aligned, odd-sized chunks are followed by a pad byte
+		Offset = PayloadOffset + ChunkSize + (ChunkSize & 1);
+	}
+
+	if (!bHasFormat)
+	{
+		return Fail(OutError, "missing fmt chunk");
+	}
+	if (OutDataOffset < 0)
+	{
+		return Fail(OutError, "missing data chunk");
+	}
+
+	// Drop a trailing partial frame so that consumers can always read whole frames
+	OutDataSize -= OutDataSize % OutFormat.BlockAlign;
+	return true;
+}
+} // namespace OVRLipSyncCore
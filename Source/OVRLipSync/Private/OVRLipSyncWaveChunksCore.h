@@ -0,0 +1,50 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncWaveChunksCore.h
+ * Content     :   Engine independent RIFF/WAVE chunk walker
+ ******************************************************************************/
+
+#pragma once
+
+// Standard C++ only, built and tested outside the engine by Tools/PostProcessCore. FOVRLipSyncWaveParser adapts it
+// to views and file handles.
+#include <cstdint>
+#include <functional>
+
+namespace OVRLipSyncCore
+{
+// Plain copy of EOVRLipSyncSampleEncoding
+enum class EWaveEncoding : uint8_t
+{
+	PCM,
+	Float,
+};
+
+// Plain copy of FOVRLipSyncWaveFormat
+struct FWaveFormat
+{
+	EWaveEncoding Encoding = EWaveEncoding::PCM;
+	int NumChannels = 0;
+	int SampleRate = 0;
+	int BitsPerSample = 0;
+	int BlockAlign = 0;
+	uint32_t ChannelMask = 0;
+};
+
+// Copies Size bytes found at Offset in the file to Dest, false when they can't be read
+using FReadBytes = std::function<bool(int64_t Offset, int32_t Size, uint8_t *Dest)>;
+
+/**
+ * Walk the RIFF chunks of a WAV file, validate its fmt chunk and locate its data chunk.
+ * Chunks other than fmt and data are skipped and only chunk headers and the fmt chunk are read.
+ *
+ * @param FileSize Size in bytes of the file.
+ * @param ReadBytes Reads a range of the file.
+ * @param OutFormat Receives the format of the data chunk.
+ * @param OutDataOffset Receives the offset of the first sample in the file.
+ * @param OutDataSize Receives the size in bytes of the data chunk, a whole number of frames.
+ * @param OutError Optional, receives a static description of why parsing failed.
+ * @return True if the file holds a supported WAV file.
+ */
+bool ParseWaveChunks(int64_t FileSize, const FReadBytes &ReadBytes, FWaveFormat &OutFormat, int64_t &OutDataOffset,
+					 int64_t &OutDataSize, const char **OutError = nullptr);
+} // namespace OVRLipSyncCore
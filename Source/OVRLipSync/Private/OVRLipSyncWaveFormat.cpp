@@ -0,0 +1,91 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncWaveFormat.cpp
+ * Content     :   RIFF/WAVE chunk parser producing non-owning views of PCM data
+ ******************************************************************************/
+
+#include "OVRLipSyncWaveFormat.h"
+
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "OVRLipSyncWaveChunksCore.h"
+
+namespace
+{
+bool Fail(FString *OutError, const TCHAR *Reason)
+{
+	if (OutError)
+	{
+		*OutError = Reason;
+	}
+	return false;
+}
+} // namespace
+
+FOVRLipSyncWaveFormat FOVRLipSyncWaveFormat::MakePCM16(int32 SampleRate, int32 NumChannels)
+{
+	FOVRLipSyncWaveFormat Format;
+	Format.Encoding = EOVRLipSyncSampleEncoding::PCM;
+	Format.NumChannels = NumChannels;
+	Format.SampleRate = SampleRate;
+	Format.BitsPerSample = 16;
+	Format.BlockAlign = NumChannels * sizeof(int16);
+	return Format;
+}
+
+bool FOVRLipSyncWaveParser::ParseChunks(int64 FileSize, TFunctionRef<bool(int64, int32, uint8 *)> ReadBytes,
+										 FOVRLipSyncWaveFormat &OutFormat, int64 &OutDataOffset, int64 &OutDataSize,
+										 FString *OutError)
+{
+	auto ReadCoreBytes = [&ReadBytes](int64_t Offset, int32_t Size, uint8_t *Dest)
+	{ return ReadBytes(Offset, Size, Dest); };
+
+	OVRLipSyncCore::FWaveFormat Format;
+	const char *Error = nullptr;
+	if (!OVRLipSyncCore::ParseWaveChunks(FileSize, ReadCoreBytes, Format, OutDataOffset, OutDataSize, &Error))
+	{
+		return Fail(OutError, ANSI_TO_TCHAR(Error));
+	}
+
+	OutFormat.Encoding = Format.Encoding == OVRLipSyncCore::EWaveEncoding::Float ? EOVRLipSyncSampleEncoding::Float
+																				  : EOVRLipSyncSampleEncoding::PCM;
+	OutFormat.NumChannels = Format.NumChannels;
+	OutFormat.SampleRate = Format.SampleRate;
+	OutFormat.BitsPerSample = Format.BitsPerSample;
+	OutFormat.BlockAlign = Format.BlockAlign;
+	OutFormat.ChannelMask = Format.ChannelMask;
+	return true;
+}
+
+bool FOVRLipSyncWaveParser::Parse(TArrayView<const uint8> FileData, FOVRLipSyncWaveView &OutView, FString *OutError)
+{
+	auto ReadBytes = [&FileData](int64 Offset, int32 Size, uint8 *Dest)
+	{
+		if (Offset + Size > FileData.Num())
+		{
+			return false;
+		}
+		FMemory::Memcpy(Dest, FileData.GetData() + Offset, Size);
+		return true;
+	};
+
+	int64 DataOffset = 0;
+	int64 DataSize = 0;
+	if (!ParseChunks(FileData.Num(), ReadBytes, OutView.Format, DataOffset, DataSize, OutError))
+	{
+		return false;
+	}
+	if (DataSize > MAX_int32)
+	{
+		return Fail(OutError, TEXT("data chunk is too large"));
+	}
+	OutView.Data = FileData.Slice(static_cast<int32>(DataOffset), static_cast<int32>(DataSize));
+	return true;
+}
+
+bool FOVRLipSyncWaveParser::ParseFile(IFileHandle &File, FOVRLipSyncWaveFormat &OutFormat, int64 &OutDataOffset,
+									  int64 &OutDataSize, FString *OutError)
+{
+	auto ReadBytes = [&File](int64 Offset, int32 Size, uint8 *Dest)
+	{ return File.Seek(Offset) && File.Read(Dest, Size); };
+
+	return ParseChunks(File.Size(), ReadBytes, OutFormat, OutDataOffset, OutDataSize, OutError);
+}
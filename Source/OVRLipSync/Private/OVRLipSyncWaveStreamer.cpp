@@ -0,0 +1,149 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncWaveStreamer.cpp
+ * Content     :   Feeds a USoundWaveProcedural from a WAV file in fixed-size chunks
+ ******************************************************************************/
+
+#include "OVRLipSyncWaveStreamer.h"
+
+#include "Async/Async.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/QueuedThreadPool.h"
+#include "OVRLipSyncModule.h"
+#include "Sound/SoundWaveProcedural.h"
+
+TSharedPtr<FOVRLipSyncWaveStreamer> FOVRLipSyncWaveStreamer::Open(const FString &FilePath, FString *OutError)
+{
+	TSharedPtr<FOVRLipSyncWaveStreamer> Streamer(new FOVRLipSyncWaveStreamer());
+	Streamer->FileHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+	if (!Streamer->FileHandle)
+	{
+		if (OutError)
+		{
+			*OutError = TEXT("can't open file");
+		}
+		return nullptr;
+	}
+
+	int64 DataSize = 0;
+	if (!FOVRLipSyncWaveParser::ParseFile(*Streamer->FileHandle, Streamer->Format, Streamer->DataBegin, DataSize,
+										  OutError))
+	{
+		return nullptr;
+	}
+	Streamer->DataEnd = Streamer->DataBegin + DataSize;
+	Streamer->ReadOffset = Streamer->DataBegin;
+	Streamer->bEndOfData = DataSize == 0;
+
+	const FOVRLipSyncWaveFormat &Format = Streamer->Format;
+	Streamer->Converter = MakeUnique<FOVRLipSyncPCMConverter>(
+		Format, FOVRLipSyncPCMConverter::GetInferenceChannels(Format.NumChannels));
+	const int32 FramesPerChunk = FMath::Max(1, static_cast<int32>(Format.SampleRate * ChunkDuration));
+	Streamer->ChunkBytes = FramesPerChunk * Format.BlockAlign;
+	return Streamer;
+}
+
+FOVRLipSyncWaveStreamer::~FOVRLipSyncWaveStreamer() = default;
+
+float FOVRLipSyncWaveStreamer::GetDuration() const
+{
+	return static_cast<float>((DataEnd - DataBegin) / Format.BlockAlign) / Format.SampleRate;
+}
+
+void FOVRLipSyncWaveStreamer::Attach(USoundWaveProcedural *SoundWave)
+{
+	// Prime synchronously so that playback can start right away
+	bReadInFlight = true;
+	FillReadAhead();
+
+	TArray<uint8> Chunk;
+	if (ReadyChunks.Dequeue(Chunk))
+	{
+		--NumReadyChunks;
+		SoundWave->QueueAudio(Chunk.GetData(), Chunk.Num());
+	}
+
+	SoundWave->OnSoundWaveProceduralUnderflow.BindLambda(
+		[Streamer = AsShared()](USoundWaveProcedural *InSoundWave, int32 SamplesRequired)
+		{ Streamer->OnUnderflow(InSoundWave, SamplesRequired); });
+
+	bReadInFlight = false;
+	ScheduleRead();
+}
+
+void FOVRLipSyncWaveStreamer::OnUnderflow(USoundWaveProcedural *SoundWave, int32 SamplesRequired)
+{
+	const int32 BytesRequired = SamplesRequired * static_cast<int32>(sizeof(int16));
+	int32 BytesQueued = 0;
+	TArray<uint8> Chunk;
+	while (BytesQueued < BytesRequired && ReadyChunks.Dequeue(Chunk))
+	{
+		--NumReadyChunks;
+		SoundWave->QueueAudio(Chunk.GetData(), Chunk.Num());
+		BytesQueued += Chunk.Num();
+	}
+	ScheduleRead();
+}
+
+void FOVRLipSyncWaveStreamer::ScheduleRead()
+{
+	if (bEndOfData || NumReadyChunks >= ReadAheadChunks)
+	{
+		return;
+	}
+	bool bExpected = false;
+	if (!bReadInFlight.compare_exchange_strong(bExpected, true))
+	{
+		return;
+	}
+
+	TWeakPtr<FOVRLipSyncWaveStreamer> WeakThis = AsShared();
+	auto ReadTask = [WeakThis]()
+	{
+		if (TSharedPtr<FOVRLipSyncWaveStreamer> This = WeakThis.Pin())
+		{
+			This->FillReadAhead();
+			This->bReadInFlight = false;
+		}
+	};
+	if (GIOThreadPool)
+	{
+		AsyncPool(*GIOThreadPool, MoveTemp(ReadTask));
+	}
+	else
+	{
+		Async(EAsyncExecution::ThreadPool, MoveTemp(ReadTask));
+	}
+}
+
+void FOVRLipSyncWaveStreamer::FillReadAhead()
+{
+	while (!bEndOfData && NumReadyChunks < ReadAheadChunks)
+	{
+		const int32 BytesToRead = static_cast<int32>(FMath::Min<int64>(ChunkBytes, DataEnd - ReadOffset));
+		ReadBuffer.SetNumUninitialized(BytesToRead);
+		if (!FileHandle->Seek(ReadOffset) || !FileHandle->Read(ReadBuffer.GetData(), BytesToRead))
+		{
+			UE_LOG(LogOvrLipSync, Error, TEXT("Failed to read audio data at offset %lld, stopping stream"), ReadOffset);
+			bEndOfData = true;
+			break;
+		}
+		ReadOffset += BytesToRead;
+		bEndOfData = ReadOffset >= DataEnd;
+
+		TArray<uint8> Chunk;
+		if (Converter->IsPassthrough())
+		{
+			Chunk = MoveTemp(ReadBuffer);
+		}
+		else
+		{
+			const int32 NumFrames = BytesToRead / Format.BlockAlign;
+			Chunk.SetNumUninitialized(NumFrames * Converter->GetOutputFormat().BlockAlign);
+			Converter->Convert(ReadBuffer.GetData(), NumFrames, reinterpret_cast<int16 *>(Chunk.GetData()));
+		}
+
+		ReadyChunks.Enqueue(MoveTemp(Chunk));
+		++NumReadyChunks;
+	}
+}
@@ -0,0 +1,73 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncWaveStreamer.h
+ * Content     :   Feeds a USoundWaveProcedural from a WAV file in fixed-size chunks
+ ******************************************************************************/
+
+#pragma once
+
+#include "Containers/Queue.h"
+#include "CoreMinimal.h"
+#include "OVRLipSyncPCMConverter.h"
+#include "OVRLipSyncWaveFormat.h"
+
+#include <atomic>
+
+class IFileHandle;
+class USoundWaveProcedural;
+
+/**
+ * Streams the data chunk of a WAV file into a procedural sound wave. Chunks are read on the I/O thread pool
+ * and kept in a small read-ahead queue; the wave's underflow callback moves them into the wave and schedules
+ * the next reads, so memory use stays constant regardless of the file length. Encodings other than 16-bit PCM
+ * are converted as chunks are read.
+ */
+class FOVRLipSyncWaveStreamer : public TSharedFromThis<FOVRLipSyncWaveStreamer>
+{
+public:
+	// Chunks kept in memory ahead of the playback position
+	static constexpr int32 ReadAheadChunks = 3;
+	// Length of audio read from disk at once
+	static constexpr float ChunkDuration = 0.25f;
+
+	/**
+	 * Open a WAV file for streaming.
+	 *
+	 * @param FilePath The path to the WAV file.
+	 * @param OutError Optional description of why the file can't be streamed.
+	 * @return The streamer, or nullptr on failure.
+	 */
+	static TSharedPtr<FOVRLipSyncWaveStreamer> Open(const FString &FilePath, FString *OutError = nullptr);
+
+	~FOVRLipSyncWaveStreamer();
+
+	// Format of the audio fed to the wave
+	FOVRLipSyncWaveFormat GetFormat() const { return Converter->GetOutputFormat(); }
+	float GetDuration() const;
+
+	// Prime the read-ahead and start feeding SoundWave, which keeps the streamer alive from then on
+	void Attach(USoundWaveProcedural *SoundWave);
+
+private:
+	FOVRLipSyncWaveStreamer() = default;
+
+	// Called on the audio render thread when the wave runs out of queued audio
+	void OnUnderflow(USoundWaveProcedural *SoundWave, int32 SamplesRequired);
+	// Refill the read-ahead queue on the I/O thread pool unless a read is already in flight
+	void ScheduleRead();
+	// Read chunks until the read-ahead queue is full, only called by the owner of bReadInFlight
+	void FillReadAhead();
+
+	TUniquePtr<IFileHandle> FileHandle;
+	FOVRLipSyncWaveFormat Format;
+	TUniquePtr<FOVRLipSyncPCMConverter> Converter;
+	int64 DataBegin = 0;
+	int64 DataEnd = 0;
+	int64 ReadOffset = 0;
+	int32 ChunkBytes = 0;
+	TArray<uint8> ReadBuffer;
+
+	TQueue<TArray<uint8>, EQueueMode::Spsc> ReadyChunks;
+	std::atomic<int32> NumReadyChunks{0};
+	std::atomic<bool> bReadInFlight{false};
+	std::atomic<bool> bEndOfData{false};
+};
@@ -5,8 +5,38 @@
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "Sound/SoundWave.h"
+#include "OVRLipSyncFileBuffer.h"
+#include "OVRLipSyncWaveFormat.h"
 #include "AudioConverterLibrary.generated.h"
 
+struct FOVRLipSyncLoadedWave;
+class UOVRLipSyncFrameSequence;
+
+/**
+ * Lightweight handle to a WAV file opened from disk. The file stays mapped (or loaded) for as long as any copy of
+ * the handle exists, so cooking and playback setup can read its samples directly.
+ */
+USTRUCT(BlueprintType)
+struct OVRLIPSYNC_API FOVRLipSyncWaveHandle
+{
+	GENERATED_BODY()
+
+	TSharedPtr<FOVRLipSyncFileBuffer> File;
+	// Format and data chunk of File
+	FOVRLipSyncWaveView View;
+
+	bool IsValid() const { return File.IsValid(); }
+
+	/**
+	 * Parse the WAV file held by InFile and keep it alive.
+	 *
+	 * @param InFile The file contents.
+	 * @param OutError Optional description of why parsing failed.
+	 * @return True if InFile is a valid WAV file.
+	 */
+	bool Initialize(const TSharedPtr<FOVRLipSyncFileBuffer> &InFile, FString *OutError = nullptr);
+};
+
 /**
  * A library for loading audio files and setting sounds for AudioComponents.
  */
@@ -18,6 +48,7 @@ class OVRLIPSYNC_API UAudioConverterLibrary : public UBlueprintFunctionLibrary
 public:
 	/**
 	 * Load binary data from a WAV file.
+	 * Blocks on file I/O, use ULoadWaveFileAsync::LoadWaveFileAsync for large files.
 	 *
 	 * @param FilePath The path to the WAV file.
 	 * @return The loaded binary data.
@@ -27,6 +58,7 @@ public:
 
 	/**
 	 * Set the sound of an AudioComponent using data from a WAV file on disk.
+	 * Blocks on file I/O, use ULoadWaveFileAsync::SetSoundFromDiskAsync for large files.
 	 *
 	 * @param AudioComponent The AudioComponent to set the sound for.
 	 * @param FilePath The path to the WAV file.
@@ -34,17 +66,96 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Audio Converter")
 	static void SetSoundFromDisk(UAudioComponent *AudioComponent, const FString &FilePath);
 
-private:
 	/**
-	 * Parse the WAV header to get audio parameters.
+	 * Set the sound of an AudioComponent using a WAV file kept in the clip cache. The file is only read and
+	 * converted the first time, later calls play from memory until the file changes or the clip is evicted.
+	 *
+	 * @param AudioComponent The AudioComponent to set the sound for.
+	 * @param FilePath The path to the WAV file.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Audio Converter")
+	static void SetSoundFromDiskCached(UAudioComponent *AudioComponent, const FString &FilePath);
+
+	/**
+	 * Set how much memory the clip cache may use, least recently used clips are evicted past it.
+	 *
+	 * @param BudgetBytes The budget in bytes.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Audio Converter")
+	static void SetClipCacheBudget(int64 BudgetBytes);
+
+	/**
+	 * Drop every clip from the clip cache. Sounds already playing are not affected.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Audio Converter")
+	static void ClearClipCache();
+
+	/**
+	 * Keep a frame sequence with the cached clip of a WAV file, so it is evicted together with the audio.
+	 *
+	 * @param FilePath The path to the WAV file, which must already be cached.
+	 * @param Sequence The lip-sync track of the file.
+	 * @return True if the clip is cached.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Audio Converter")
+	static bool CacheFrameSequence(const FString &FilePath, UOVRLipSyncFrameSequence *Sequence);
+
+	/**
+	 * Get the frame sequence stored with the cached clip of a WAV file.
+	 *
+	 * @param FilePath The path to the WAV file.
+	 * @return The sequence, or nullptr if the clip isn't cached or has no sequence.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Audio Converter")
+	static UOVRLipSyncFrameSequence *GetCachedFrameSequence(const FString &FilePath);
+
+	/**
+	 * Set the sound of an AudioComponent to a WAV file that is streamed from disk while it plays.
+	 * Only a small read-ahead is kept in memory, which suits long ambient or narrative tracks.
+	 *
+	 * @param AudioComponent The AudioComponent to set the sound for.
+	 * @param FilePath The path to the WAV file.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Audio Converter")
+	static void StreamSoundFromDisk(UAudioComponent *AudioComponent, const FString &FilePath);
+
+	/**
+	 * Open a WAV file through a memory mapping without reading it up front.
+	 *
+	 * @param FilePath The path to the WAV file.
+	 * @param OutHandle Handle to the opened file.
+	 * @return True if the file was opened and is a valid WAV file.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Audio Converter")
+	static bool OpenWaveFile(const FString &FilePath, FOVRLipSyncWaveHandle &OutHandle);
+
+	/**
+	 * Set the sound of an AudioComponent using a WAV file opened with OpenWaveFile.
+	 *
+	 * @param AudioComponent The AudioComponent to set the sound for.
+	 * @param WaveHandle The opened WAV file.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Audio Converter")
+	static void SetSoundFromWaveHandle(UAudioComponent *AudioComponent, const FOVRLipSyncWaveHandle &WaveHandle);
+
+	/**
+	 * Set the sound of an AudioComponent using a file loaded for playback with FOVRLipSyncAsyncWaveLoad.
+	 * The audio is already converted, so this only queues it.
+	 *
+	 * @param AudioComponent The AudioComponent to set the sound for.
+	 * @param LoadedWave The loaded file.
+	 */
+	static void SetSoundFromLoadedWave(UAudioComponent *AudioComponent, const FOVRLipSyncLoadedWave &LoadedWave);
+
+	/**
+	 * Locate the audio of a WAV file the way SetSoundFromDisk does: files whose header can't be parsed are assumed
+	 * to be 16-bit stereo at 44.1kHz after a 44-byte header. Safe to call from any thread.
 	 *
-	 * @param FileData The binary data of the WAV file.
-	 * @param SampleRate The sample rate of the audio.
-	 * @param NumChannels The number of audio channels.
-	 * @param BitsPerSample The number of bits per sample.
-	 * @param HeaderSize The size of the WAV header.
-	 * @return True if the header was parsed successfully, false otherwise.
+	 * @param FileData Complete contents of the file.
+	 * @param OutView Receives the format and a view of the audio inside FileData.
+	 * @param SourceName Name of the file for log messages.
+	 * @return False if the file is too short to hold any audio.
 	 */
-	static bool ParseWavHeader(const TArray<uint8> &FileData, int32 &SampleRate, int32 &NumChannels,
-							   int32 &BitsPerSample, int32 &HeaderSize);
+	static bool ParseWaveForPlayback(TArrayView<const uint8> FileData, FOVRLipSyncWaveView &OutView,
+									 const FString &SourceName);
 };
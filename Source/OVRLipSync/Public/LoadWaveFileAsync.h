@@ -0,0 +1,63 @@
+/*******************************************************************************
+ * Filename    :   LoadWaveFileAsync.h
+ * Content     :   Latent Blueprint nodes loading WAV files without blocking the game thread
+ ******************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AudioConverterLibrary.h"
+#include "Engine/CancellableAsyncAction.h"
+#include "LoadWaveFileAsync.generated.h"
+
+class FOVRLipSyncAsyncWaveLoad;
+class UAudioComponent;
+struct FOVRLipSyncLoadedWave;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FWaveFileLoaded, const FOVRLipSyncWaveHandle &, WaveFile, bool, Success);
+
+/**
+ * Asynchronous versions of UAudioConverterLibrary::LoadWaveFile and SetSoundFromDisk. Files are read through the
+ * platform's async file I/O and prepared on a worker thread, completion is reported on the game thread.
+ */
+UCLASS()
+class OVRLIPSYNC_API ULoadWaveFileAsync : public UCancellableAsyncAction
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY(BlueprintAssignable, Category = "Audio Converter")
+	FWaveFileLoaded OnLoaded;
+
+	/**
+	 * Load a WAV file into memory.
+	 *
+	 * @param FilePath The path to the WAV file.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"),
+			  Category = "Audio Converter")
+	static ULoadWaveFileAsync *LoadWaveFileAsync(UObject *WorldContextObject, const FString &FilePath);
+
+	/**
+	 * Set the sound of an AudioComponent using data from a WAV file on disk once it is loaded.
+	 *
+	 * @param AudioComponent The AudioComponent to set the sound for.
+	 * @param FilePath The path to the WAV file.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"),
+			  Category = "Audio Converter")
+	static ULoadWaveFileAsync *SetSoundFromDiskAsync(UObject *WorldContextObject, UAudioComponent *AudioComponent,
+													 const FString &FilePath);
+
+	virtual void Activate() override;
+	virtual void Cancel() override;
+
+private:
+	void OnLoadComplete(FOVRLipSyncLoadedWave &&LoadedWave);
+
+	FString FilePath;
+	bool bSetSound = false;
+	UPROPERTY()
+	TWeakObjectPtr<UAudioComponent> AudioComponent;
+
+	TSharedPtr<FOVRLipSyncAsyncWaveLoad> Load;
+};
@@ -30,6 +30,17 @@ limitations under the License.
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOVRLipSyncVisemesDataReadyDelegate);
 
+// Updates of a component since it last started, counted in every build and listed by the LipSync.List command
+struct FOVRLipSyncUpdateCounters
+{
+	uint64 NumUpdates = 0;
+	uint64 TotalCycles = 0;
+	uint64 PeakCycles = 0;
+	// FPlatformTime::Cycles64 at the start of the first and of the last update
+	uint64 FirstCycles = 0;
+	uint64 LastCycles = 0;
+};
+
 UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
 class OVRLIPSYNC_API UOVRLipSyncActorComponentBase : public UActorComponent
 {
@@ -57,12 +68,24 @@ public:
 			  Meta = (Tooltip = "Event triggered when new prediction is ready"))
 	FOVRLipSyncVisemesDataReadyDelegate OnVisemesReady;
 
+	const FOVRLipSyncUpdateCounters &GetUpdateCounters() const { return UpdateCounters; }
+
+	// Kind of component shown by LipSync.List
+	virtual const TCHAR *GetDebugMode() const { return TEXT("None"); }
+	// What the component plays or streams, shown by LipSync.List
+	virtual FString GetDebugDetails() const { return FString(); }
+
 protected:
 	// Set component internal state to a neutral pose
 	void InitNeutralPose();
 
+	// Count an update that started at StartCycles and ends now, game thread only
+	void RecordUpdate(uint64 StartCycles);
+	void ResetUpdateCounters() { UpdateCounters = FOVRLipSyncUpdateCounters(); }
+
 	float LaughterScore = 0;
 	TArray<float> Visemes;
+	FOVRLipSyncUpdateCounters UpdateCounters;
 
 	static const TArray<FString> VisemeNames;
 };
@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncAsyncWaveLoad.h
+ * Content     :   Loads WAV files through async file I/O and prepares them off the game thread
+ ******************************************************************************/
+
+#pragma once
+
+#include "Async/AsyncFileHandle.h"
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "OVRLipSyncWaveFormat.h"
+
+#include <atomic>
+
+class FOVRLipSyncFileBuffer;
+
+/**
+ * Result of an asynchronous WAV load, delivered on the game thread.
+ */
+struct OVRLIPSYNC_API FOVRLipSyncLoadedWave
+{
+	// Contents of the file, View and a passthrough PCM view point into it
+	TSharedPtr<FOVRLipSyncFileBuffer> File;
+	// Format and data chunk of File
+	FOVRLipSyncWaveView View;
+	// Data chunk converted to 16-bit mono or stereo, only filled for playback loads of other formats
+	TArray<uint8> ConvertedPCM;
+	// Format of GetPlaybackPCM
+	FOVRLipSyncWaveFormat PlaybackFormat;
+	// Why the load failed, empty on success
+	FString Error;
+
+	bool IsValid() const { return File.IsValid(); }
+	// 16-bit PCM ready to queue on a procedural sound wave, only meaningful for playback loads
+	TArrayView<const uint8> GetPlaybackPCM() const
+	{
+		return ConvertedPCM.Num() > 0 ? TArrayView<const uint8>(ConvertedPCM) : View.Data;
+	}
+};
+
+/**
+ * A single in-flight WAV load. The file is read through the platform's async file I/O, parsed (and converted for
+ * playback when requested) on a worker thread, and the result is handed to a callback on the game thread.
+ * At most MaxConcurrentLoads loads read and parse at once, the rest wait in a queue in start order.
+ */
+class OVRLIPSYNC_API FOVRLipSyncAsyncWaveLoad : public TSharedFromThis<FOVRLipSyncAsyncWaveLoad>
+{
+public:
+	// Loads allowed to be reading or parsing at the same time
+	static constexpr int32 MaxConcurrentLoads = 4;
+
+	using FOnComplete = TUniqueFunction<void(FOVRLipSyncLoadedWave &&LoadedWave)>;
+
+	/**
+	 * Start loading a WAV file.
+	 *
+	 * @param FilePath The path to the WAV file.
+	 * @param bPreparePlayback Convert the audio to the 16-bit layout procedural sound waves play, and accept files
+	 *                         with unreadable headers the way UAudioConverterLibrary::SetSoundFromDisk does.
+	 * @param OnComplete Called on the game thread with the result, unless the load is cancelled first.
+	 * @return The load, which keeps itself alive until it completes.
+	 */
+	static TSharedRef<FOVRLipSyncAsyncWaveLoad> Start(const FString &FilePath, bool bPreparePlayback,
+													 FOnComplete &&OnComplete);
+
+	~FOVRLipSyncAsyncWaveLoad();
+
+	// Stop the load as soon as possible, OnComplete won't be called. Game thread only.
+	void Cancel();
+	bool IsCancelled() const { return bCancelled; }
+
+private:
+	FOVRLipSyncAsyncWaveLoad(const FString &InFilePath, bool bInPreparePlayback, FOnComplete &&InOnComplete);
+
+	// Open the file and request its size, called once the load holds one of the concurrency slots
+	void Begin();
+	void OnSizeKnown(int64 FileSize);
+	void OnReadDone(bool bSucceeded);
+	// Parse and convert the bytes read, on a worker thread
+	void Prepare(FOVRLipSyncLoadedWave &Result);
+	// Release the concurrency slot and deliver Result on the game thread
+	void Finish(FOVRLipSyncLoadedWave &&Result);
+	// Wait for and delete the request in flight, requests can't be deleted from their own callback
+	void ReleaseRequest();
+
+	FString FilePath;
+	bool bPreparePlayback;
+	FOnComplete OnComplete;
+	std::atomic<bool> bCancelled{false};
+
+	TUniquePtr<IAsyncReadFileHandle> FileHandle;
+	// Guards Request against Cancel
+	FCriticalSection RequestLock;
+	IAsyncReadRequest *Request = nullptr;
+	FAsyncFileCallBack RequestCallback;
+	TArray<uint8> Bytes;
+
+	static FCriticalSection QueueLock;
+	static int32 NumActiveLoads;
+	static TArray<TSharedRef<FOVRLipSyncAsyncWaveLoad>> QueuedLoads;
+};
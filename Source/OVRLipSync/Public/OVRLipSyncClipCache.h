@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncClipCache.h
+ * Content     :   Memory-budgeted cache of decoded clips loaded from disk
+ ******************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OVRLipSyncWaveFormat.h"
+#include "Sound/SoundWaveProcedural.h"
+#include "UObject/StrongObjectPtr.h"
+#include "OVRLipSyncClipCache.generated.h"
+
+class UOVRLipSyncFrameSequence;
+
+/**
+ * Audio of a clip, converted to the 16-bit layout procedural sound waves play. Immutable once cached, so any number
+ * of sound waves can read it at once.
+ */
+struct OVRLIPSYNC_API FOVRLipSyncCachedClip
+{
+	FOVRLipSyncWaveFormat Format;
+	TArray<uint8> PCM;
+
+	float GetDuration() const
+	{
+		return Format.BlockAlign > 0 ? static_cast<float>(PCM.Num() / Format.BlockAlign) / Format.SampleRate : 0.0f;
+	}
+};
+
+/**
+ * Procedural sound wave that plays a cached clip. Audio is copied from the shared buffer as the mixer asks for it,
+ * instead of being queued up front.
+ */
+UCLASS()
+class OVRLIPSYNC_API UOVRLipSyncCachedSoundWave : public USoundWaveProcedural
+{
+	GENERATED_BODY()
+
+public:
+	void SetClip(const TSharedRef<const FOVRLipSyncCachedClip> &InClip);
+
+	virtual int32 OnGeneratePCMAudio(TArray<uint8> &OutAudio, int32 NumSamples) override;
+
+private:
+	TSharedPtr<const FOVRLipSyncCachedClip> Clip;
+	// Bytes of Clip->PCM handed to the mixer, only touched on the audio render thread
+	int32 ReadOffset = 0;
+};
+
+/**
+ * LRU cache of clips loaded from disk, keyed by path and modification time so edited files are reloaded. A cooked
+ * frame sequence can be stored alongside a clip and shares its lifetime. Entries are evicted, least recently used
+ * first, once the cache holds more than its budget. Game thread only.
+ */
+class OVRLIPSYNC_API FOVRLipSyncClipCache
+{
+public:
+	static constexpr int64 DefaultBudgetBytes = 64 * 1024 * 1024;
+
+	static FOVRLipSyncClipCache &Get();
+
+	/**
+	 * Get the clip of a WAV file, loading and converting it on a miss.
+	 *
+	 * @param FilePath The path to the WAV file.
+	 * @return The clip, or nullptr if the file can't be loaded.
+	 */
+	TSharedPtr<const FOVRLipSyncCachedClip> FindOrLoad(const FString &FilePath);
+
+	// Store the frame sequence of a cached clip, the sequence is kept alive while the clip stays cached
+	bool SetFrameSequence(const FString &FilePath, UOVRLipSyncFrameSequence *Sequence);
+	UOVRLipSyncFrameSequence *GetFrameSequence(const FString &FilePath);
+
+	// Evicts entries right away when the new budget is lower than the cached size
+	void SetBudget(int64 InBudgetBytes);
+	int64 GetBudget() const { return BudgetBytes; }
+	int64 GetCachedBytes() const { return CachedBytes; }
+	void Clear();
+
+private:
+	struct FEntry
+	{
+		FDateTime TimeStamp;
+		TSharedPtr<const FOVRLipSyncCachedClip> Clip;
+		TStrongObjectPtr<UOVRLipSyncFrameSequence> Sequence;
+		int64 Size = 0;
+		uint64 LastUse = 0;
+	};
+
+	// Entry for FilePath if it still matches the file on disk
+	FEntry *FindEntry(const FString &FilePath);
+	void UpdateSize(FEntry &Entry);
+	// Evict least recently used entries, other than Keep, until the cache fits the budget
+	void Trim(const FEntry *Keep = nullptr);
+
+	TMap<FString, FEntry> Entries;
+	int64 BudgetBytes = DefaultBudgetBytes;
+	int64 CachedBytes = 0;
+	uint64 UseCounter = 0;
+};
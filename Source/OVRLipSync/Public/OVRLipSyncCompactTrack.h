@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncCompactTrack.h
+ * Content     :   Reduced LipSync frames written to cooked packages
+ ******************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FOVRLipSyncFrame;
+struct FOVRLipSyncPlatformCookSettings;
+
+/**
+ * Frames of a sequence resampled, quantized and stripped for one platform. Scores are stored frame after frame,
+ * each frame holding the kept visemes followed by the laughter score when it is kept.
+ */
+struct OVRLIPSYNC_API FOVRLipSyncCompactTrack
+{
+	int32 FrameRate = 100;
+	int32 NumFrames = 0;
+	// Visemes of the source frames, stripped ones read as zero
+	int32 NumVisemes = 0;
+	// Bytes per score: 4 for floats, 2 or 1 for fixed point
+	uint8 BytesPerScore = 4;
+	bool bHasLaughter = true;
+	// Source viseme index of each stored score
+	TArray<uint8> KeptVisemes;
+	TArray<uint8> Scores;
+
+	/**
+	 * Build the track of a platform from 100 Hz source frames. The frame rate is doubled until the error of the
+	 * resampled and quantized frames is within the settings' MaxError or the source rate is reached.
+	 *
+	 * @param Frames Source frames.
+	 * @param Settings Settings of the target platform.
+	 * @param OutMaxError Largest score difference between the source frames and the track.
+	 */
+	static FOVRLipSyncCompactTrack Build(const TArray<FOVRLipSyncFrame> &Frames,
+										 const FOVRLipSyncPlatformCookSettings &Settings, float &OutMaxError);
+
+	bool IsEmpty() const { return NumFrames == 0; }
+
+	// Bytes of one frame and of all frames
+	int32 GetFrameSize() const { return (KeptVisemes.Num() + (bHasLaughter ? 1 : 0)) * BytesPerScore; }
+	int64 GetScoresSize() const { return static_cast<int64>(NumFrames) * GetFrameSize(); }
+
+	// Decode one frame, Index must be below NumFrames
+	void GetFrame(int32 Index, TArray<float> &OutVisemes, float &OutLaughterScore) const;
+
+	// Decode one frame of a track whose scores are stored elsewhere, e.g. in a sequence bank
+	void GetFrame(const uint8 *TrackScores, int32 Index, TArray<float> &OutVisemes, float &OutLaughterScore) const;
+
+	SIZE_T GetAllocatedSize() const { return KeptVisemes.GetAllocatedSize() + Scores.GetAllocatedSize(); }
+
+	/**
+	 * Read or write the track. Written scores are compressed when bCompress is set, loaded scores are always
+	 * decompressed.
+	 */
+	void Serialize(FArchive &Ar, bool bCompress = false);
+
+	// Read or write everything but the scores
+	void SerializeLayout(FArchive &Ar);
+
+	// Read or write a buffer of scores, in one read or write of the whole buffer
+	static void SerializeScores(FArchive &Ar, TArray<uint8> &InOutScores, bool bCompress);
+	bool IsLayoutValid() const;
+
+private:
+	float ReadScore(const uint8 *Data) const;
+	void WriteScore(float Score);
+};
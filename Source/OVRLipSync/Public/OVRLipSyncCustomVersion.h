@@ -0,0 +1,29 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncCustomVersion.h
+ * Content     :   Serialization versions of OVRLipSync assets
+ ******************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/Guid.h"
+
+struct OVRLIPSYNC_API FOVRLipSyncCustomVersion
+{
+	enum Type
+	{
+		// Before any version changes were made
+		BeforeCustomVersionWasAdded = 0,
+		// Sequences carry a compact track after their tagged properties, filled in cooked packages
+		AddedCompactTrack,
+
+		// -----<new versions can be added above this line>-------------------------------------------------
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	static const FGuid GUID;
+
+private:
+	FOVRLipSyncCustomVersion() {}
+};
@@ -0,0 +1,44 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncFileBuffer.h
+ * Content     :   Read-only file contents backed by a memory mapping or a loaded array
+ ******************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Read-only bytes of a file. Files are memory mapped when the platform supports it, so the OS pages data in
+ * on demand and nothing is copied; otherwise (e.g. files inside a pak) the file is loaded into memory.
+ */
+class OVRLIPSYNC_API FOVRLipSyncFileBuffer
+{
+public:
+	/**
+	 * Open a file for reading.
+	 *
+	 * @param FilePath The path to the file.
+	 * @param bAllowMapping Try to memory map the file before falling back to loading it.
+	 * @return The file contents, or nullptr if the file can't be read.
+	 */
+	static TSharedPtr<FOVRLipSyncFileBuffer> Open(const FString &FilePath, bool bAllowMapping = true);
+
+	// Wrap bytes that are already in memory
+	static TSharedRef<FOVRLipSyncFileBuffer> FromArray(TArray<uint8> &&Bytes);
+
+	~FOVRLipSyncFileBuffer();
+
+	TArrayView<const uint8> GetView() const { return View; }
+	bool IsMapped() const { return MappedRegion.IsValid(); }
+
+private:
+	FOVRLipSyncFileBuffer() = default;
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TArray<uint8> LoadedBytes;
+	TArrayView<const uint8> View;
+};
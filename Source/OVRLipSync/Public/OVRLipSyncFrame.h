@@ -24,6 +24,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "OVRLipSyncCompactTrack.h"
 #include "OVRLipSyncFrame.generated.h"
 
 USTRUCT()
@@ -50,7 +51,34 @@ class OVRLIPSYNC_API UOVRLipSyncFrameSequence : public UObject
 public:
 	UPROPERTY()
 	TArray<FOVRLipSyncFrame> FrameSequence;
-	unsigned Num() const { return FrameSequence.Num(); }
+
+#if WITH_EDITORONLY_DATA
+	// Hash of the audio and settings the sequence was generated from, empty for sequences made before it existed
+	UPROPERTY(AssetRegistrySearchable)
+	FString SourceHash;
+
+	// Hash of the saved sound wave package and the settings, compared from the asset registry without loading the wave
+	UPROPERTY(AssetRegistrySearchable)
+	FString SourcePackageHash;
+#endif
+	// Frames of the editor data or, in cooked builds, of the track packaged for the platform
+	unsigned Num() const { return FrameSequence.Num() > 0 ? FrameSequence.Num() : CompactTrack.NumFrames; }
 	void Add(const TArray<float> &Visemes, float LaughterScore) { FrameSequence.Emplace(Visemes, LaughterScore); }
+	// Full precision frames, empty in cooked builds, use GetFrame for playback
 	const FOVRLipSyncFrame &operator[](unsigned idx) const { return FrameSequence[idx]; }
+
+	// Frames per second of audio, lower than 100 when the platform's packaging settings reduce it
+	int32 GetFrameRate() const { return FrameSequence.Num() > 0 ? 100 : CompactTrack.FrameRate; }
+
+	// Read frame Index, false when it is out of range
+	bool GetFrame(int32 Index, TArray<float> &OutVisemes, float &OutLaughterScore) const;
+
+	// Memory used by the frames
+	SIZE_T GetFramesAllocatedSize() const;
+
+	virtual void Serialize(FArchive &Ar) override;
+
+private:
+	// Written when cooking instead of FrameSequence, see UOVRLipSyncSettings
+	FOVRLipSyncCompactTrack CompactTrack;
 };
@@ -0,0 +1,74 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncLoadSequenceAsync.h
+ * Content     :   Blueprint access to asynchronous loading of LipSync sequences and banks
+ ******************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "OVRLipSyncFrame.h"
+#include "OVRLipSyncResidencyManager.h"
+#include "OVRLipSyncSequenceBank.h"
+#include "OVRLipSyncLoadSequenceAsync.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOVRLipSyncSequenceLoaded, UOVRLipSyncFrameSequence *, Sequence,
+											   UOVRLipSyncSequenceBank *, Bank, bool, Success);
+
+/**
+ * Loads a sequence, or the bank holding an entry, through FOVRLipSyncSequenceStreamer
+ */
+UCLASS()
+class OVRLIPSYNC_API UOVRLipSyncLoadSequenceAsync : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY(BlueprintAssignable, Category = "LipSync")
+	FOVRLipSyncSequenceLoaded OnLoaded;
+
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"), Category = "LipSync")
+	static UOVRLipSyncLoadSequenceAsync *LoadLipSyncSequence(TSoftObjectPtr<UOVRLipSyncFrameSequence> Sequence);
+
+	// Success is false when the bank loaded but has no entry EntryId
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"), Category = "LipSync")
+	static UOVRLipSyncLoadSequenceAsync *LoadLipSyncBankEntry(TSoftObjectPtr<UOVRLipSyncSequenceBank> Bank,
+															  FName EntryId);
+
+	virtual void Activate() override;
+
+private:
+	FSoftObjectPath Path;
+	FName EntryId;
+};
+
+UCLASS()
+class OVRLIPSYNC_API UOVRLipSyncStreamingLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Start loading the sequences of the lines coming up, so they are resident by the time they are played.
+	 *
+	 * @param UpcomingSequences Sequences of the next lines, soonest first.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "LipSync")
+	static void PrefetchLipSyncSequences(const TArray<TSoftObjectPtr<UOVRLipSyncFrameSequence>> &UpcomingSequences);
+
+	// Start loading banks whose entries will be played soon
+	UFUNCTION(BlueprintCallable, Category = "LipSync")
+	static void PrefetchLipSyncBanks(const TArray<TSoftObjectPtr<UOVRLipSyncSequenceBank>> &UpcomingBanks);
+
+	/**
+	 * Set how much memory loaded sequences and banks may use, least recently used idle ones are released past it.
+	 *
+	 * @param BudgetBytes The budget in bytes.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "LipSync")
+	static void SetLipSyncStreamingBudget(int64 BudgetBytes);
+
+	// Memory used by loaded sequences and banks, and how often idle ones were evicted
+	UFUNCTION(BlueprintCallable, Category = "LipSync")
+	static FOVRLipSyncResidencyStats GetLipSyncResidencyStats();
+};
@@ -0,0 +1,51 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncPCMConverter.h
+ * Content     :   Conversion of PCM encodings to 16-bit mono or stereo
+ ******************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OVRLipSyncWaveFormat.h"
+
+/**
+ * Converts interleaved 8/16/24/32-bit integer or 32-bit float samples with any number of channels to
+ * interleaved 16-bit samples with fewer or as many channels, downmixing in the same pass.
+ * Conversions run on SIMD registers in blocks small enough to stay in cache.
+ */
+class OVRLIPSYNC_API FOVRLipSyncPCMConverter
+{
+public:
+	/**
+	 * @param InFormat Format of the source samples.
+	 * @param InOutputChannels Number of channels to produce, 1 or 2.
+	 */
+	FOVRLipSyncPCMConverter(const FOVRLipSyncWaveFormat &InFormat, int32 InOutputChannels);
+
+	// Number of channels inference runs on for a source with NumChannels channels
+	static int32 GetInferenceChannels(int32 NumChannels) { return NumChannels > 1 ? 2 : 1; }
+
+	const FOVRLipSyncWaveFormat &GetSourceFormat() const { return Format; }
+	FOVRLipSyncWaveFormat GetOutputFormat() const;
+
+	// True when the source already is 16-bit PCM with the output channel count, so it can be used as is
+	bool IsPassthrough() const { return bPassthrough; }
+
+	/**
+	 * Convert whole frames.
+	 *
+	 * @param Src First frame to convert, in the source format.
+	 * @param NumFrames Number of frames to convert.
+	 * @param Dst Receives NumFrames * output channels samples.
+	 */
+	void Convert(const uint8 *Src, int64 NumFrames, int16 *Dst) const;
+
+private:
+	void BuildMixGains();
+
+	FOVRLipSyncWaveFormat Format;
+	int32 OutputChannels;
+	bool bPassthrough;
+	// Gain of each source channel in each output channel, indexed [Output * NumChannels + Source]
+	TArray<float> MixGains;
+};
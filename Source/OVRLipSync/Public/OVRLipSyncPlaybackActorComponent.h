@@ -26,6 +26,7 @@
 #include "Components/AudioComponent.h"
 #include "OVRLipSyncActorComponentBase.h"
 #include "OVRLipSyncFrame.h"
+#include "OVRLipSyncSequenceBank.h"
 
 #include "OVRLipSyncPlaybackActorComponent.generated.h"
 
@@ -38,6 +39,13 @@ public:
 	UPROPERTY(EditAnywhere, Category = "LipSync", Meta = (Tooltip = "LipSync Sequence to be played"))
 	UOVRLipSyncFrameSequence *Sequence;
 
+	UPROPERTY(EditAnywhere, Category = "LipSync",
+			  Meta = (Tooltip = "Bank holding the sequence to be played, used when Sequence is not set"))
+	UOVRLipSyncSequenceBank *Bank;
+
+	UPROPERTY(EditAnywhere, Category = "LipSync", Meta = (Tooltip = "ID of the bank entry to be played"))
+	FName BankEntryId;
+
 	UPROPERTY(BlueprintReadonly, Category = "LipSync")
 	UAudioComponent *AudioComponent;
 
@@ -45,15 +53,36 @@ public:
 			  Meta = (Tooltip = "Start playback of the canned sequence synchronized with AudioComponent"))
 	void Start(UAudioComponent *InAudioComponent, UOVRLipSyncFrameSequence *InSequence);
 
+	UFUNCTION(BlueprintCallable, Category = "LipSync",
+			  Meta = (Tooltip = "Start playback of a bank entry synchronized with AudioComponent"))
+	void StartBankEntry(UAudioComponent *InAudioComponent, UOVRLipSyncSequenceBank *InBank, FName InEntryId);
+
+	UFUNCTION(BlueprintCallable, Category = "LipSync",
+			  Meta = (Tooltip = "Load the sequence without blocking, then start playback synchronized with "
+								"AudioComponent"))
+	void StartAsync(UAudioComponent *InAudioComponent, TSoftObjectPtr<UOVRLipSyncFrameSequence> InSequence);
+
+	UFUNCTION(BlueprintCallable, Category = "LipSync",
+			  Meta = (Tooltip = "Load the bank without blocking, then start playback of the entry synchronized with "
+								"AudioComponent"))
+	void StartBankEntryAsync(UAudioComponent *InAudioComponent, TSoftObjectPtr<UOVRLipSyncSequenceBank> InBank,
+							 FName InEntryId);
+
 	UFUNCTION(BlueprintCallable, Category = "LipSync")
 	void Stop();
 
 	UFUNCTION(BlueprintCallable, Category = "LipSync", Meta = (Tooltip = "Sets playback sequence property"))
 	void SetPlaybackSequence(UOVRLipSyncFrameSequence *InSequence);
 
+	UFUNCTION(BlueprintCallable, Category = "LipSync",
+			  Meta = (Tooltip = "Sets the bank entry to be played and clears the playback sequence"))
+	void SetPlaybackBankEntry(UOVRLipSyncSequenceBank *InBank, FName InEntryId);
+
 	UFUNCTION(BlueprintCallable, Category = "LipSync")
 	bool GetVisemesTimeBased(float Time, TArray<float> &OutVisemes, float &OutLaughterScore);
 
+	virtual const TCHAR *GetDebugMode() const override { return TEXT("Playback"); }
+	virtual FString GetDebugDetails() const override;
 
 protected:
 	// Returns audio Component associated with the same
@@ -67,6 +96,16 @@ protected:
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
+	// Frame of the sequence, or else of the bank entry, played at Time
+	bool GetFrameAt(float Time, TArray<float> &OutVisemes, float &OutLaughterScore) const;
+
+	// Mark the asset being played as in use with the residency manager, releasing the previous one
+	void SetAssetInUse(UObject *Asset);
+
+	// Sequence or bank marked as in use, kept alive by the residency manager while it is
+	UObject *AssetInUse = nullptr;
+	// Bumped by every asynchronous start and by Stop, loads finishing for an older value are ignored
+	uint32 LoadRequest = 0;
 	FDelegateHandle PlaybackPercentHandle;
 	FDelegateHandle PlaybackFinishedHandle;
 };
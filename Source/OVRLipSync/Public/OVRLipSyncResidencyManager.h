@@ -0,0 +1,103 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncResidencyManager.h
+ * Content     :   Memory budget for loaded LipSync sequences and banks
+ ******************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/StrongObjectPtr.h"
+#include "OVRLipSyncResidencyManager.generated.h"
+
+struct FStreamableHandle;
+
+USTRUCT(BlueprintType)
+struct OVRLIPSYNC_API FOVRLipSyncResidencyStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "LipSync")
+	int64 BudgetBytes = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "LipSync")
+	int64 ResidentBytes = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "LipSync")
+	int64 PeakResidentBytes = 0;
+
+	// Bytes of assets played right now, which can't be evicted
+	UPROPERTY(BlueprintReadOnly, Category = "LipSync")
+	int64 InUseBytes = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "LipSync")
+	int32 NumResident = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "LipSync")
+	int32 NumInUse = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "LipSync")
+	int32 NumEvictions = 0;
+};
+
+/**
+ * Keeps the sequences and banks it tracks alive within a byte budget. Playback components mark the asset they play
+ * as in use; once the tracked assets exceed the budget the least recently used idle ones are released to garbage
+ * collection. Works the same for assets loaded from packages, where the streamable handle is released too, and for
+ * sequences cooked at runtime. Game thread only.
+ *
+ * The budget starts at UOVRLipSyncSettings::ResidencyBudgetMB, which can be overridden per platform in the
+ * platform's Engine.ini.
+ */
+class OVRLIPSYNC_API FOVRLipSyncResidencyManager
+{
+public:
+	static FOVRLipSyncResidencyManager &Get();
+
+	/**
+	 * Track a sequence or bank, or mark it as recently used when it is already tracked.
+	 *
+	 * @param Asset A UOVRLipSyncFrameSequence or UOVRLipSyncSequenceBank.
+	 * @param Handle Handle the asset was loaded with, released on eviction.
+	 */
+	void Register(UObject *Asset, TSharedPtr<FStreamableHandle> Handle = nullptr);
+
+	// Mark an asset as played by one more component, registering it when needed
+	void AcquireUse(UObject *Asset);
+	// Undo one AcquireUse, the asset becomes evictable when nobody plays it anymore
+	void ReleaseUse(UObject *Asset);
+
+	// Evicts idle assets right away when the new budget is lower than the resident size
+	void SetBudget(int64 InBudgetBytes);
+	FOVRLipSyncResidencyStats GetStats() const;
+	// Components playing Asset, INDEX_NONE when it isn't tracked
+	int32 GetNumUsers(const UObject *Asset) const;
+	// Release every idle asset
+	void Clear();
+	// Release every asset and handle, played or not, while UObjects are still alive. Components releasing their
+	// asset afterwards find nothing to release.
+	void Shutdown();
+
+private:
+	FOVRLipSyncResidencyManager();
+
+	struct FEntry
+	{
+		TStrongObjectPtr<UObject> Asset;
+		TSharedPtr<FStreamableHandle> Handle;
+		int64 Size = 0;
+		int32 NumUsers = 0;
+		uint64 LastUse = 0;
+	};
+
+	FEntry &FindOrAdd(UObject *Asset);
+	// Release least recently used idle entries, other than Keep, until the tracked assets fit the budget
+	void Trim(const UObject *Keep = nullptr);
+	void Evict(const UObject *Asset);
+
+	TMap<const UObject *, FEntry> Entries;
+	int64 BudgetBytes = 0;
+	int64 ResidentBytes = 0;
+	int64 PeakResidentBytes = 0;
+	int32 NumEvictions = 0;
+	uint64 UseCounter = 0;
+};
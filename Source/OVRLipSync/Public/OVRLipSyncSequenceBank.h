@@ -0,0 +1,107 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncSequenceBank.h
+ * Content     :   Many LipSync tracks packed into one asset
+ ******************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OVRLipSyncCompactTrack.h"
+#include "OVRLipSyncSequenceBank.generated.h"
+
+class UOVRLipSyncFrameSequence;
+
+USTRUCT()
+struct OVRLIPSYNC_API FOVRLipSyncBankSource
+{
+	GENERATED_BODY()
+
+	// Name the entry is looked up by, e.g. the sound or line ID
+	UPROPERTY(EditAnywhere, Category = "LipSync")
+	FName Id;
+
+	UPROPERTY(EditAnywhere, Category = "LipSync")
+	TSoftObjectPtr<UOVRLipSyncFrameSequence> Sequence;
+};
+
+/**
+ * Layout of each entry of a bank followed by one buffer holding the scores of all of them.
+ */
+struct OVRLIPSYNC_API FOVRLipSyncPackedTracks
+{
+	TArray<FName> EntryIds;
+	// Layout of each entry, their scores live in Scores
+	TArray<FOVRLipSyncCompactTrack> Tracks;
+	TArray<int32> Offsets;
+	TArray<uint8> Scores;
+
+	void Add(FName Id, FOVRLipSyncCompactTrack &&Track);
+	void Reset();
+	SIZE_T GetAllocatedSize() const;
+	void Serialize(FArchive &Ar, bool bCompress = false);
+};
+
+/**
+ * Frames of many sequences in a single object: an index of entries keyed by ID and one contiguous buffer of scores,
+ * read with a single bulk read when the bank loads. Meant for the many short lines of a character or level, which
+ * would otherwise be one package each.
+ *
+ * The bank is built in the editor from its source sequences. Like sequences, the packed scores are reduced for each
+ * platform when cooking, see UOVRLipSyncSettings.
+ */
+UCLASS(BlueprintType)
+class OVRLIPSYNC_API UOVRLipSyncSequenceBank : public UObject
+{
+	GENERATED_BODY()
+
+public:
+#if WITH_EDITORONLY_DATA
+	// Sequences packed into the bank, changing them rebuilds it
+	UPROPERTY(EditAnywhere, Category = "LipSync")
+	TArray<FOVRLipSyncBankSource> Sources;
+#endif
+
+#if WITH_EDITOR
+	/**
+	 * Load the source sequences and pack their frames, replacing the current entries.
+	 *
+	 * @param OutError Sources that couldn't be packed, the others are packed regardless.
+	 * @return Whether every source was packed.
+	 */
+	bool Rebuild(FString *OutError = nullptr);
+
+	virtual void PostEditChangeProperty(FPropertyChangedEvent &PropertyChangedEvent) override;
+#endif
+
+	UFUNCTION(BlueprintCallable, Category = "LipSync")
+	bool Contains(FName Id) const { return EntryIndex.Contains(Id); }
+
+	UFUNCTION(BlueprintCallable, Category = "LipSync")
+	TArray<FName> GetEntryIds() const { return Packed.EntryIds; }
+
+	// Index of the entry with the given ID, INDEX_NONE when there is none
+	int32 FindEntry(FName Id) const;
+
+	int32 GetNumFrames(int32 Entry) const
+	{
+		return Packed.Tracks.IsValidIndex(Entry) ? Packed.Tracks[Entry].NumFrames : 0;
+	}
+	int32 GetFrameRate(int32 Entry) const
+	{
+		return Packed.Tracks.IsValidIndex(Entry) ? Packed.Tracks[Entry].FrameRate : 100;
+	}
+
+	// Read frame Index of an entry, false when either is out of range
+	bool GetFrame(int32 Entry, int32 Index, TArray<float> &OutVisemes, float &OutLaughterScore) const;
+
+	// Memory used by the index and the packed scores
+	SIZE_T GetFramesAllocatedSize() const;
+
+	virtual void Serialize(FArchive &Ar) override;
+
+private:
+	void RebuildIndex();
+
+	FOVRLipSyncPackedTracks Packed;
+	TMap<FName, int32> EntryIndex;
+};
@@ -0,0 +1,54 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncSequenceStreamer.h
+ * Content     :   Asynchronous loading and prefetching of LipSync sequences and banks
+ ******************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+
+/**
+ * Loads sequences and sequence banks by soft reference through a streamable manager, so playback doesn't hitch on
+ * synchronous loads or force every line to be loaded with the level. Dialogue systems pass the lines coming up as
+ * prefetch hints, which load at a lower priority than lines requested for playback.
+ *
+ * Loaded assets are handed to FOVRLipSyncResidencyManager, which keeps them resident within its budget. Game thread
+ * only.
+ */
+class OVRLIPSYNC_API FOVRLipSyncSequenceStreamer
+{
+public:
+	// Called with the loaded sequence or bank, or nullptr when it can't be loaded
+	using FOnLoaded = TFunction<void(UObject *Asset)>;
+
+	static FOVRLipSyncSequenceStreamer &Get();
+
+	/**
+	 * Load a sequence or bank. OnLoaded is called right away when the asset is already loaded.
+	 *
+	 * @param Path Path of a UOVRLipSyncFrameSequence or UOVRLipSyncSequenceBank.
+	 * @param OnLoaded Called on the game thread once the load ends.
+	 */
+	void Request(const FSoftObjectPath &Path, FOnLoaded &&OnLoaded);
+
+	// Start loading assets that will be requested soon, e.g. the next lines of a conversation
+	void Prefetch(const TArray<FSoftObjectPath> &Paths);
+
+	// Forget loads in flight, their callbacks won't be called
+	void Clear();
+
+private:
+	struct FPendingLoad
+	{
+		TSharedPtr<FStreamableHandle> Handle;
+		TArray<FOnLoaded> Waiting;
+	};
+
+	// Start loading Path unless it is loaded or loading, false when it can't be loaded
+	bool Load(const FSoftObjectPath &Path, TAsyncLoadPriority Priority);
+	void OnLoadDone(FSoftObjectPath Path);
+
+	FStreamableManager StreamableManager;
+	TMap<FSoftObjectPath, FPendingLoad> PendingLoads;
+};
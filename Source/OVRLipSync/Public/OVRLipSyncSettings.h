@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncSettings.h
+ * Content     :   Project settings of the OVRLipSync runtime
+ ******************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "OVRLipSyncSettings.generated.h"
+
+UENUM()
+enum class EOVRLipSyncQuantization : uint8
+{
+	// 32-bit float scores
+	None,
+	// 16-bit fixed point scores
+	Bits16 UMETA(DisplayName = "16 Bit"),
+	// 8-bit fixed point scores
+	Bits8 UMETA(DisplayName = "8 Bit"),
+};
+
+/**
+ * How sequences are packaged for one platform. The editor always keeps the 100 Hz full precision frames, these
+ * settings only change what is written to cooked packages.
+ */
+USTRUCT()
+struct OVRLIPSYNC_API FOVRLipSyncPlatformCookSettings
+{
+	GENERATED_BODY()
+
+	// Frames stored per second of audio, raised towards 100 when the reduced rate would exceed MaxError
+	UPROPERTY(EditAnywhere, Category = "Packaging", meta = (ClampMin = "10", ClampMax = "100"))
+	int32 FrameRate = 100;
+
+	UPROPERTY(EditAnywhere, Category = "Packaging")
+	EOVRLipSyncQuantization Quantization = EOVRLipSyncQuantization::None;
+
+	// Compress the stored scores, they are decompressed once when the sequence loads
+	UPROPERTY(EditAnywhere, Category = "Packaging")
+	bool bCompress = false;
+
+	// Don't store laughter scores, they read as zero at runtime
+	UPROPERTY(EditAnywhere, Category = "Packaging")
+	bool bStripLaughter = false;
+
+	// Don't store visemes whose score never exceeds MaxError, they read as zero at runtime
+	UPROPERTY(EditAnywhere, Category = "Packaging")
+	bool bStripUnusedVisemes = false;
+
+	// Largest score difference to the editor frames the packaged frames may have, 0 to allow any
+	UPROPERTY(EditAnywhere, Category = "Packaging", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float MaxError = 0.05f;
+};
+
+UCLASS(config = Engine, defaultconfig, meta = (DisplayName = "OVRLipSync Runtime"))
+class OVRLIPSYNC_API UOVRLipSyncSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UOVRLipSyncSettings() { CategoryName = TEXT("Plugins"); }
+
+	// Settings of platforms without an entry in PlatformSettings
+	UPROPERTY(config, EditAnywhere, Category = "Packaging")
+	FOVRLipSyncPlatformCookSettings DefaultSettings;
+
+	// Settings per platform, keyed by the platform's ini name (Windows, Android, IOS, ...)
+	UPROPERTY(config, EditAnywhere, Category = "Packaging")
+	TMap<FName, FOVRLipSyncPlatformCookSettings> PlatformSettings;
+
+	// Memory loaded sequences and banks may use before idle ones are evicted, see FOVRLipSyncResidencyManager
+	UPROPERTY(config, EditAnywhere, Category = "Residency", meta = (ClampMin = "0"))
+	int32 ResidencyBudgetMB = 16;
+
+	static const FOVRLipSyncPlatformCookSettings &GetForPlatform(FName IniPlatformName);
+};
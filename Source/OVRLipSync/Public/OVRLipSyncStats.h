@@ -0,0 +1,33 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncStats.h
+ * Content     :   Stats group and trace channel of the LipSync pipeline
+ ******************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+
+/**
+ * Shown by "stat OVRLipSync". Cycle counters are declared next to the code they time; the counters below are shared
+ * by the playback and inference modules. Stats are compiled out of Shipping builds, the CPU trace scopes and the
+ * OVRLipSync trace channel are kept wherever the target enables trace, so Unreal Insights can still profile them.
+ */
+DECLARE_STATS_GROUP(TEXT("OVRLipSync"), STATGROUP_OVRLipSync, STATCAT_Advanced);
+
+// Audio frames run through inference, live or while cooking
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Frames Inferred"), STAT_OVRLipSync_FramesInferred, STATGROUP_OVRLipSync,
+								  OVRLIPSYNC_API);
+// Capture updates that had no audio to infer
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Frames Gated"), STAT_OVRLipSync_FramesGated, STATGROUP_OVRLipSync,
+								  OVRLIPSYNC_API);
+// OnVisemesReady broadcasts of every component
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Broadcasts"), STAT_OVRLipSync_Broadcasts, STATGROUP_OVRLipSync,
+								  OVRLIPSYNC_API);
+// Voice captures currently feeding inference
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Active Streams"), STAT_OVRLipSync_ActiveStreams, STATGROUP_OVRLipSync,
+									  OVRLIPSYNC_API);
+
+// Per-stream timing events, enable with -trace=cpu,OVRLipSync
+UE_TRACE_CHANNEL_EXTERN(OVRLipSyncChannel, OVRLIPSYNC_API);
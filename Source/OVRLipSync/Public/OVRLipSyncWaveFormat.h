@@ -0,0 +1,90 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncWaveFormat.h
+ * Content     :   RIFF/WAVE chunk parser producing non-owning views of PCM data
+ ******************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IFileHandle;
+
+// Sample encoding of the data chunk as declared by the fmt chunk
+enum class EOVRLipSyncSampleEncoding : uint8
+{
+	PCM,
+	Float,
+};
+
+/**
+ * Validated description of the audio stored in a WAV data chunk.
+ */
+struct OVRLIPSYNC_API FOVRLipSyncWaveFormat
+{
+	EOVRLipSyncSampleEncoding Encoding = EOVRLipSyncSampleEncoding::PCM;
+	int32 NumChannels = 0;
+	int32 SampleRate = 0;
+	// Container size of a single sample, always a multiple of 8
+	int32 BitsPerSample = 0;
+	// Size in bytes of one frame (one sample for each channel)
+	int32 BlockAlign = 0;
+	// Speaker positions from WAVE_FORMAT_EXTENSIBLE, zero when not specified
+	uint32 ChannelMask = 0;
+
+	static FOVRLipSyncWaveFormat MakePCM16(int32 SampleRate, int32 NumChannels);
+
+	bool IsPCM16() const { return Encoding == EOVRLipSyncSampleEncoding::PCM && BitsPerSample == 16; }
+};
+
+/**
+ * Format descriptor plus a view of the data chunk inside a caller-owned buffer.
+ * The view stays valid only as long as the buffer it was parsed from.
+ */
+struct OVRLIPSYNC_API FOVRLipSyncWaveView
+{
+	FOVRLipSyncWaveFormat Format;
+	TArrayView<const uint8> Data;
+
+	int64 GetNumFrames() const { return Format.BlockAlign > 0 ? Data.Num() / Format.BlockAlign : 0; }
+	float GetDuration() const
+	{
+		return Format.SampleRate > 0 ? static_cast<float>(GetNumFrames()) / Format.SampleRate : 0.0f;
+	}
+	// Interleaved samples, only meaningful when Format.IsPCM16()
+	const int16 *GetPCM16() const { return reinterpret_cast<const int16 *>(Data.GetData()); }
+	int64 GetNumPCM16Samples() const { return Data.Num() / sizeof(int16); }
+};
+
+class OVRLIPSYNC_API FOVRLipSyncWaveParser
+{
+public:
+	/**
+	 * Walk the RIFF chunks of a WAV file, validate its fmt chunk and locate its data chunk.
+	 * Chunks other than fmt and data (LIST, bext, JUNK, cue, ...) are skipped. No data is copied.
+	 *
+	 * @param FileData Complete contents of the WAV file.
+	 * @param OutView Receives the format and a view of the data chunk inside FileData.
+	 * @param OutError Optional description of why parsing failed.
+	 * @return True if FileData holds a supported WAV file.
+	 */
+	static bool Parse(TArrayView<const uint8> FileData, FOVRLipSyncWaveView &OutView, FString *OutError = nullptr);
+
+	/**
+	 * Same as Parse for a file that is read through a handle instead of being held in memory.
+	 * Only chunk headers and the fmt chunk are read.
+	 *
+	 * @param File Handle to the WAV file, its read position is left unspecified.
+	 * @param OutFormat Receives the format of the data chunk.
+	 * @param OutDataOffset Receives the offset of the first sample in the file.
+	 * @param OutDataSize Receives the size in bytes of the data chunk, a whole number of frames.
+	 * @param OutError Optional description of why parsing failed.
+	 * @return True if File holds a supported WAV file.
+	 */
+	static bool ParseFile(IFileHandle &File, FOVRLipSyncWaveFormat &OutFormat, int64 &OutDataOffset,
+						  int64 &OutDataSize, FString *OutError = nullptr);
+
+private:
+	static bool ParseChunks(int64 FileSize, TFunctionRef<bool(int64 Offset, int32 Size, uint8 *Dest)> ReadBytes,
+							FOVRLipSyncWaveFormat &OutFormat, int64 &OutDataOffset, int64 &OutDataSize,
+							FString *OutError);
+};
@@ -27,6 +27,11 @@
  * - Introduced dynamic interpolation based on phoneme durations.
  * - Added a mechanism to adjust interpolation frames dynamically based on speech tempo.
  * - Enhanced compatibility with modern Unreal Engine APIs (e.g., FPaths and Async threading).
+ * - Added UnrealEd for saving sequences generated in the background.
+ * - Added CollectionManager and Json for the OVRLipSyncCook commandlet.
+ * - Added DerivedDataCache and DeveloperSettings for generating sequences on import.
+ * - Added AssetTools for creating sequence banks.
+ * - Added OVRLipSyncInference, which now holds the context wrapper and the audio decoders.
  ******************************************************************************/
 
 using System.IO;
@@ -43,10 +48,19 @@ public class OVRLipSyncEditor : ModuleRules
           "CoreUObject",
           "Engine",
           "OVRLipSync",
+          "OVRLipSyncInference",
           "Slate",
           "SlateCore",
           "Voice"
         });
+        PrivateDependencyModuleNames.AddRange(new string[] {
+          "AssetTools",
+          "CollectionManager",
+          "DerivedDataCache",
+          "DeveloperSettings",
+          "Json",
+          "UnrealEd"
+        });
     }
 }
 
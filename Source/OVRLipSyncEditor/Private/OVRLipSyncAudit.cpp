@@ -0,0 +1,225 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncAudit.cpp
+ * Content     :   Memory and cost report of the LipSync data of a project
+ ******************************************************************************/
+
+#include "OVRLipSyncAudit.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
+#include "OVRLipSyncFrame.h"
+#include "OVRLipSyncSequenceGenerator.h"
+#include "OVRLipSyncSettings.h"
+#include "Serialization/MemoryWriter.h"
+#include "Sound/SoundWave.h"
+
+namespace
+{
+// Sequences loaded between two garbage collections
+constexpr int32 LoadBatchSize = 256;
+
+const TCHAR *GetQuantizationName(uint8 BytesPerScore)
+{
+	switch (BytesPerScore)
+	{
+	case 1:
+		return TEXT("8-bit");
+	case 2:
+		return TEXT("16-bit");
+	default:
+		return TEXT("float");
+	}
+}
+
+FString DescribeTrack(const FOVRLipSyncCompactTrack &Track, bool bCompressed)
+{
+	return FString::Printf(TEXT("%s %d/%d visemes%s%s"), GetQuantizationName(Track.BytesPerScore),
+						   Track.KeptVisemes.Num(), Track.NumVisemes,
+						   Track.bHasLaughter ? TEXT(" + laughter") : TEXT(""), bCompressed ? TEXT(" zlib") : TEXT(""));
+}
+
+int64 GetPackageFileSize(FName PackageName)
+{
+	FString FileName;
+	if (!FPackageName::DoesPackageExist(PackageName.ToString(), &FileName))
+	{
+		return 0;
+	}
+	return FMath::Max<int64>(IFileManager::Get().FileSize(*FileName), 0);
+}
+
+FString EscapeCsv(const FString &Value)
+{
+	if (!Value.Contains(TEXT(",")) && !Value.Contains(TEXT("\"")) && !Value.Contains(TEXT("\n")))
+	{
+		return Value;
+	}
+	return FString::Printf(TEXT("\"%s\""), *Value.Replace(TEXT("\""), TEXT("\"\"")));
+}
+
+void AuditSequence(UOVRLipSyncFrameSequence &Sequence, const FOVRLipSyncPlatformCookSettings &Settings,
+				   FOVRLipSyncAuditRow &Row)
+{
+	Row.NumFrames = Sequence.Num();
+	Row.FrameRate = Sequence.GetFrameRate();
+	Row.Duration = Row.FrameRate > 0 ? static_cast<float>(Row.NumFrames) / Row.FrameRate : 0.0f;
+	Row.MemoryBytes = Sequence.GetFramesAllocatedSize();
+
+	const int32 NumVisemes = Sequence.FrameSequence.Num() > 0 ? Sequence.FrameSequence[0].VisemeScores.Num() : 0;
+	Row.Encoding = FString::Printf(TEXT("float %d visemes + laughter"), NumVisemes);
+
+	// Build the track exactly as cooking would and measure its serialized size
+	FOVRLipSyncCompactTrack Track =
+		FOVRLipSyncCompactTrack::Build(Sequence.FrameSequence, Settings, Row.PackagedMaxError);
+	TArray<uint8> Packaged;
+	FMemoryWriter Writer(Packaged);
+	Track.Serialize(Writer, Settings.bCompress);
+	Row.PackagedFrameRate = Track.FrameRate;
+	Row.PackagedBytes = Packaged.Num();
+	Row.PackagedEncoding = DescribeTrack(Track, Settings.bCompress);
+	Row.PlaybackBytesPerSecond = static_cast<int64>(Track.FrameRate) * Track.GetFrameSize();
+
+	if (Row.NumFrames == 0)
+	{
+		Row.Flags.Add(TEXT("empty"));
+	}
+	if (Sequence.SourceHash.IsEmpty())
+	{
+		Row.Flags.Add(TEXT("no source hash"));
+	}
+}
+} // namespace
+
+TArray<FOVRLipSyncAuditRow> FOVRLipSyncAudit::Run(const TArray<FString> &Paths, FName PlatformName)
+{
+	IAssetRegistry &AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.ScanPathsSynchronous(Paths, true);
+
+	FARFilter Filter;
+	Filter.bRecursivePaths = true;
+	Filter.bRecursiveClasses = true;
+	for (const FString &Path : Paths)
+	{
+		Filter.PackagePaths.Add(*Path);
+	}
+	TArray<FAssetData> Sequences;
+	Filter.ClassPaths.Add(UOVRLipSyncFrameSequence::StaticClass()->GetClassPathName());
+	AssetRegistry.GetAssets(Filter, Sequences);
+	TArray<FAssetData> SoundWaves;
+	Filter.ClassPaths.Reset();
+	Filter.ClassPaths.Add(USoundWave::StaticClass()->GetClassPathName());
+	AssetRegistry.GetAssets(Filter, SoundWaves);
+
+	const FOVRLipSyncPlatformCookSettings &Settings = UOVRLipSyncSettings::GetForPlatform(PlatformName);
+	TMap<FSoftObjectPath, const FAssetData *> SoundWavesBySequence;
+	for (const FAssetData &SoundWave : SoundWaves)
+	{
+		SoundWavesBySequence.Add(FSoftObjectPath(FOVRLipSyncSequenceGenerator::GetSequenceObjectPath(SoundWave)),
+								 &SoundWave);
+	}
+
+	TArray<FOVRLipSyncAuditRow> Rows;
+	TSet<const FAssetData *> PairedSoundWaves;
+	FScopedSlowTask SlowTask(Sequences.Num(), NSLOCTEXT("NSLT_OVRLipSyncPlugin", "AuditingLipSyncSequences",
+														"Auditing LipSync sequences..."));
+	SlowTask.MakeDialog();
+	for (int32 Index = 0; Index < Sequences.Num(); ++Index)
+	{
+		SlowTask.EnterProgressFrame();
+		FOVRLipSyncAuditRow &Row = Rows.AddDefaulted_GetRef();
+		Row.Sequence = Sequences[Index].GetObjectPathString();
+		Row.DiskBytes = GetPackageFileSize(Sequences[Index].PackageName);
+
+		if (const FAssetData *const *SoundWave = SoundWavesBySequence.Find(Sequences[Index].GetSoftObjectPath()))
+		{
+			PairedSoundWaves.Add(*SoundWave);
+			Row.SoundWave = (*SoundWave)->GetObjectPathString();
+			(*SoundWave)->GetTagValue(GET_MEMBER_NAME_CHECKED(USoundWave, Duration), Row.SoundWaveDuration);
+		}
+		else
+		{
+			Row.Flags.Add(TEXT("orphaned"));
+		}
+
+		if (UOVRLipSyncFrameSequence *Sequence = Cast<UOVRLipSyncFrameSequence>(Sequences[Index].GetAsset()))
+		{
+			AuditSequence(*Sequence, Settings, Row);
+		}
+		else
+		{
+			Row.Flags.Add(TEXT("failed to load"));
+		}
+		if (!Row.SoundWave.IsEmpty() && FMath::Abs(Row.Duration - Row.SoundWaveDuration) > DurationTolerance)
+		{
+			Row.Flags.Add(TEXT("duration mismatch"));
+		}
+
+		if ((Index + 1) % LoadBatchSize == 0)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+	}
+
+	// Outliers are judged by packaged bytes per second of audio, long lines are expected to be large. Editor frames
+	// are 100 Hz floats for every sequence, only the platform's packaging (kept visemes, quantization, compression)
+	// tells them apart.
+	TArray<double> Densities;
+	for (const FOVRLipSyncAuditRow &Row : Rows)
+	{
+		if (Row.Duration > 0.0f)
+		{
+			Densities.Add(Row.PackagedBytes / Row.Duration);
+		}
+	}
+	if (Densities.Num() > 0)
+	{
+		Densities.Sort();
+		const double Median = Densities[Densities.Num() / 2];
+		for (FOVRLipSyncAuditRow &Row : Rows)
+		{
+			if (Row.Duration > 0.0f && Row.PackagedBytes / Row.Duration > Median * OversizeFactor)
+			{
+				Row.Flags.Add(TEXT("oversized"));
+			}
+		}
+	}
+
+	for (const FAssetData &SoundWave : SoundWaves)
+	{
+		if (!PairedSoundWaves.Contains(&SoundWave))
+		{
+			FOVRLipSyncAuditRow &Row = Rows.AddDefaulted_GetRef();
+			Row.SoundWave = SoundWave.GetObjectPathString();
+			SoundWave.GetTagValue(GET_MEMBER_NAME_CHECKED(USoundWave, Duration), Row.SoundWaveDuration);
+			Row.Flags.Add(TEXT("missing sequence"));
+		}
+	}
+	return Rows;
+}
+
+bool FOVRLipSyncAudit::WriteCsv(const TArray<FOVRLipSyncAuditRow> &Rows, const FString &FilePath)
+{
+	TArray<FString> Lines;
+	Lines.Add(TEXT("Sequence,SoundWave,Frames,FrameRate,Duration,SoundWaveDuration,MemoryBytes,DiskBytes,Encoding,"
+				   "PackagedFrameRate,PackagedEncoding,PackagedBytes,PackagedMaxError,PlaybackBytesPerSecond,Flags"));
+	for (const FOVRLipSyncAuditRow &Row : Rows)
+	{
+		Lines.Add(FString::Printf(TEXT("%s,%s,%d,%d,%.3f,%.3f,%lld,%lld,%s,%d,%s,%lld,%.4f,%lld,%s"),
+								  *EscapeCsv(Row.Sequence), *EscapeCsv(Row.SoundWave), Row.NumFrames, Row.FrameRate,
+								  Row.Duration, Row.SoundWaveDuration, Row.MemoryBytes, Row.DiskBytes,
+								  *EscapeCsv(Row.Encoding), Row.PackagedFrameRate, *EscapeCsv(Row.PackagedEncoding),
+								  Row.PackagedBytes, Row.PackagedMaxError, Row.PlaybackBytesPerSecond,
+								  *EscapeCsv(FString::Join(Row.Flags, TEXT(";")))));
+	}
+	return FFileHelper::SaveStringArrayToFile(Lines, *FilePath);
+}
+
+FString FOVRLipSyncAudit::GetDefaultReportPath()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("OVRLipSync"),
+						   FString::Printf(TEXT("Audit-%s.csv"), *FDateTime::Now().ToString()));
+}
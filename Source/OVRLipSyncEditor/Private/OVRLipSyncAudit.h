@@ -0,0 +1,60 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncAudit.h
+ * Content     :   Memory and cost report of the LipSync data of a project
+ ******************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * One sequence, or one sound wave without a sequence.
+ */
+struct FOVRLipSyncAuditRow
+{
+	FString Sequence;
+	// Sound wave the sequence was generated from, found by the generator's naming
+	FString SoundWave;
+	int32 NumFrames = 0;
+	int32 FrameRate = 0;
+	float Duration = 0.0f;
+	float SoundWaveDuration = 0.0f;
+	int64 MemoryBytes = 0;
+	int64 DiskBytes = 0;
+	FString Encoding;
+	// What the packaging settings of the audited platform turn the sequence into
+	int32 PackagedFrameRate = 0;
+	FString PackagedEncoding;
+	int64 PackagedBytes = 0;
+	float PackagedMaxError = 0.0f;
+	// Score bytes read per second of playback of the packaged data
+	int64 PlaybackBytesPerSecond = 0;
+	TArray<FString> Flags;
+};
+
+/**
+ * Scans the sequences and sound waves under a set of paths, shared by the OVRLipSyncAudit commandlet and the
+ * content browser folder action.
+ */
+class FOVRLipSyncAudit
+{
+public:
+	// Sequences packaged to more than this many times the median bytes per second of audio are flagged oversized
+	static constexpr float OversizeFactor = 2.0f;
+	// Seconds a sequence may differ from the duration of its sound wave
+	static constexpr float DurationTolerance = 0.1f;
+
+	/**
+	 * Load every sequence under Paths and report its size and cost. Sound waves under Paths without a sequence are
+	 * reported too.
+	 *
+	 * @param Paths Content paths to scan, recursively.
+	 * @param PlatformName Ini name of the platform whose packaging settings are estimated, None for the defaults.
+	 */
+	static TArray<FOVRLipSyncAuditRow> Run(const TArray<FString> &Paths, FName PlatformName);
+
+	static bool WriteCsv(const TArray<FOVRLipSyncAuditRow> &Rows, const FString &FilePath);
+
+	// Timestamped file under Saved/OVRLipSync
+	static FString GetDefaultReportPath();
+};
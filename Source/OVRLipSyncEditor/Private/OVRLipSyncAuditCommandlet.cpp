@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncAuditCommandlet.cpp
+ * Content     :   Memory and cost report of the LipSync data of a project
+ ******************************************************************************/
+
+#include "OVRLipSyncAuditCommandlet.h"
+
+#include "OVRLipSyncAudit.h"
+
+UOVRLipSyncAuditCommandlet::UOVRLipSyncAuditCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UOVRLipSyncAuditCommandlet::Main(const FString &Params)
+{
+	FString PathList = TEXT("/Game");
+	FParse::Value(*Params, TEXT("Paths="), PathList, false);
+	TArray<FString> Paths;
+	PathList.ParseIntoArray(Paths, TEXT("+"));
+	FString Platform;
+	FParse::Value(*Params, TEXT("Platform="), Platform);
+	FString OutputPath = FOVRLipSyncAudit::GetDefaultReportPath();
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	FString FailOnList;
+	FParse::Value(*Params, TEXT("FailOn="), FailOnList, false);
+	TArray<FString> FailOn;
+	FailOnList.ParseIntoArray(FailOn, TEXT("+"));
+	// A sequence that can't be loaded is an error whatever the flags asked for
+	FailOn.AddUnique(TEXT("failed to load"));
+
+	const TArray<FOVRLipSyncAuditRow> Rows =
+		FOVRLipSyncAudit::Run(Paths, Platform.IsEmpty() ? NAME_None : FName(*Platform));
+
+	int64 MemoryBytes = 0;
+	int64 PackagedBytes = 0;
+	int32 NumFlagged = 0;
+	int32 NumFailed = 0;
+	for (const FOVRLipSyncAuditRow &Row : Rows)
+	{
+		MemoryBytes += Row.MemoryBytes;
+		PackagedBytes += Row.PackagedBytes;
+		if (Row.Flags.Num() == 0)
+		{
+			continue;
+		}
+		++NumFlagged;
+		const bool bFailed = Row.Flags.ContainsByPredicate(
+			[&FailOn](const FString &Flag) { return FailOn.Contains(Flag); });
+		const FString &Name = Row.Sequence.IsEmpty() ? Row.SoundWave : Row.Sequence;
+		const FString Flags = FString::Join(Row.Flags, TEXT(", "));
+		if (bFailed)
+		{
+			++NumFailed;
+			UE_LOG(LogTemp, Error, TEXT("OVRLipSyncAudit: %s: %s"), *Name, *Flags);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Display, TEXT("OVRLipSyncAudit: %s: %s"), *Name, *Flags);
+		}
+	}
+
+	if (!FOVRLipSyncAudit::WriteCsv(Rows, OutputPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("OVRLipSyncAudit: failed to write %s"), *OutputPath);
+		return 1;
+	}
+	UE_LOG(LogTemp, Display,
+		   TEXT("OVRLipSyncAudit: %d rows, %d flagged, %d failed, %lld bytes in the editor, %lld bytes packaged, "
+				"written to %s"),
+		   Rows.Num(), NumFlagged, NumFailed, MemoryBytes, PackagedBytes, *OutputPath);
+	return NumFailed > 0 ? 1 : 0;
+}
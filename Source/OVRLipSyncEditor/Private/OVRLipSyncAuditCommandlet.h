@@ -0,0 +1,30 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncAuditCommandlet.h
+ * Content     :   Memory and cost report of the LipSync data of a project
+ ******************************************************************************/
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "CoreMinimal.h"
+#include "OVRLipSyncAuditCommandlet.generated.h"
+
+/**
+ * Writes the FOVRLipSyncAudit report of the sequences and sound waves under the given paths to a CSV file.
+ *
+ * UnrealEditor-Cmd.exe Project.uproject -run=OVRLipSyncAudit [-Paths=/Game/VO+/Game/Barks] [-Platform=Android]
+ *     [-Output=Path.csv] [-FailOn=oversized+duration mismatch]
+ *
+ * Paths default to /Game and the report to Saved/OVRLipSync. Returns 1 when the report can't be written, when a
+ * sequence fails to load, or when a row carries one of the FailOn flags; other flags are only reported.
+ */
+UCLASS()
+class UOVRLipSyncAuditCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UOVRLipSyncAuditCommandlet();
+
+	virtual int32 Main(const FString &Params) override;
+};
@@ -0,0 +1,214 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncBatchCooker.cpp
+ * Content     :   Generates LipSync sequences for many sound waves on worker threads
+ ******************************************************************************/
+
+#include "OVRLipSyncBatchCooker.h"
+
+#include "Async/Async.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "OVRLipSyncSequenceGenerator.h"
+#include "Widgets/Notifications/SNotificationList.h"
+
+TSharedPtr<FOVRLipSyncBatchCooker> FOVRLipSyncBatchCooker::ActiveBatch;
+
+void FOVRLipSyncBatchCooker::Start(const TArray<FAssetData> &SoundWaveAssets, bool bUseOfflineModel)
+{
+	if (SoundWaveAssets.Num() == 0)
+	{
+		return;
+	}
+	if (ActiveBatch.IsValid())
+	{
+		// Waves imported while a batch runs join it
+		if (ActiveBatch->bUseOfflineModel != bUseOfflineModel || ActiveBatch->bCancelled)
+		{
+			UE_LOG(LogTemp, Warning,
+				   TEXT("LipSync sequences are already being generated, wait for that batch to finish"));
+			return;
+		}
+		for (const FAssetData &Asset : SoundWaveAssets)
+		{
+			ActiveBatch->Assets.AddUnique(Asset);
+		}
+		return;
+	}
+
+	ActiveBatch = MakeShareable(new FOVRLipSyncBatchCooker(SoundWaveAssets, bUseOfflineModel));
+	ActiveBatch->Begin();
+}
+
+void FOVRLipSyncBatchCooker::Shutdown()
+{
+	if (!ActiveBatch.IsValid())
+	{
+		return;
+	}
+	ActiveBatch->bCancelled = true;
+	FTSTicker::GetCoreTicker().RemoveTicker(ActiveBatch->TickerHandle);
+	if (ActiveBatch->Notification.IsValid())
+	{
+		ActiveBatch->Notification->ExpireAndFadeout();
+		ActiveBatch->Notification.Reset();
+	}
+	ActiveBatch.Reset();
+}
+
+FOVRLipSyncBatchCooker::FOVRLipSyncBatchCooker(const TArray<FAssetData> &InAssets, bool bInUseOfflineModel)
+	: Assets(InAssets), bUseOfflineModel(bInUseOfflineModel),
+	  ModelPath(FOVRLipSyncSequenceGenerator::GetModelPath(bInUseOfflineModel))
+{
+	// Leave a worker thread to the editor itself
+	MaxInFlight = FMath::Max(1, FPlatformMisc::NumberOfWorkerThreadsToSpawn() - 1);
+}
+
+void FOVRLipSyncBatchCooker::Begin()
+{
+	FNotificationInfo Info(NSLOCTEXT("NSLT_OVRLipSyncPlugin", "GeneratingLipSyncSequences",
+									 "Generating LipSync sequences..."));
+	Info.bFireAndForget = false;
+	Info.bUseThrobber = true;
+	Info.ButtonDetails.Add(FNotificationButtonInfo(
+		NSLOCTEXT("NSLT_OVRLipSyncPlugin", "CancelLipSyncSequences", "Cancel"),
+		NSLOCTEXT("NSLT_OVRLipSyncPlugin", "CancelLipSyncSequences_Tooltip",
+				  "Stop after the sequences being generated now, keeping the ones already done"),
+		FSimpleDelegate::CreateStatic(&FOVRLipSyncBatchCooker::CancelActive), SNotificationItem::CS_Pending));
+	Notification = FSlateNotificationManager::Get().AddNotification(Info);
+	if (Notification.IsValid())
+	{
+		Notification->SetCompletionState(SNotificationItem::CS_Pending);
+	}
+	UpdateNotification();
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateSP(this, &FOVRLipSyncBatchCooker::Tick));
+}
+
+bool FOVRLipSyncBatchCooker::Tick(float DeltaTime)
+{
+	FResult Result;
+	while (Results.Dequeue(Result))
+	{
+		--NumInFlight;
+		++NumDone;
+		if (Result.Error.IsEmpty())
+		{
+			CreateSequence(Result);
+		}
+		else
+		{
+			Fail(Result.Asset, Result.Error);
+		}
+	}
+	if (PendingSequences.Num() >= SaveBatchSize)
+	{
+		SavePending();
+	}
+
+	if (!bCancelled && NumInFlight < MaxInFlight && NextAsset < Assets.Num())
+	{
+		LaunchNext();
+	}
+
+	UpdateNotification();
+
+	if (NumInFlight == 0 && (bCancelled || NextAsset == Assets.Num()))
+	{
+		Complete();
+		return false;
+	}
+	return true;
+}
+
+void FOVRLipSyncBatchCooker::LaunchNext()
+{
+	const FAssetData &Asset = Assets[NextAsset++];
+	FOVRLipSyncGeneratorJob Job;
+	FString Error;
+	if (!FOVRLipSyncSequenceGenerator::Prepare(Asset, bUseOfflineModel, Job, Error))
+	{
+		++NumDone;
+		Fail(Asset, Error);
+		return;
+	}
+
+	++NumInFlight;
+	Async(EAsyncExecution::ThreadPool,
+		  [This = AsShared(), Job = MoveTemp(Job)]() mutable
+		  {
+			  FResult Result;
+			  Result.Asset = Job.Asset;
+			  Result.SourceHash = Job.SourceHash;
+			  Result.SourcePackageHash = Job.SourcePackageHash;
+			  FOVRLipSyncSequenceGenerator::GenerateCached(Job, This->ModelPath, This->bCancelled, Result.Frames,
+														   Result.Error);
+			  This->Results.Enqueue(MoveTemp(Result));
+		  });
+}
+
+void FOVRLipSyncBatchCooker::CreateSequence(FResult &Result)
+{
+	PendingSequences.Add(FOVRLipSyncSequenceGenerator::CreateSequence(Result.Asset, MoveTemp(Result.Frames),
+																	  Result.SourceHash, Result.SourcePackageHash));
+	++NumCreated;
+}
+
+void FOVRLipSyncBatchCooker::SavePending()
+{
+	if (!FOVRLipSyncSequenceGenerator::SaveSequences(PendingSequences))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Some LipSync sequences could not be saved, save them from the editor"));
+	}
+	PendingSequences.Reset();
+}
+
+void FOVRLipSyncBatchCooker::Complete()
+{
+	SavePending();
+
+	for (const FString &Failure : Failures)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s"), *Failure);
+	}
+	UE_LOG(LogTemp, Log, TEXT("Generated %d of %d LipSync sequences, %d failed"), NumCreated, Assets.Num(),
+		   Failures.Num());
+
+	if (Notification.IsValid())
+	{
+		Notification->SetText(FText::Format(
+			NSLOCTEXT("NSLT_OVRLipSyncPlugin", "GeneratedLipSyncSequences",
+					  "Generated {0} of {1} LipSync sequences, {2} failed (see Output Log)"),
+			FText::AsNumber(NumCreated), FText::AsNumber(Assets.Num()), FText::AsNumber(Failures.Num())));
+		Notification->SetCompletionState(Failures.Num() > 0 || bCancelled ? SNotificationItem::CS_Fail
+																			 : SNotificationItem::CS_Success);
+		Notification->ExpireAndFadeout();
+		Notification.Reset();
+	}
+	// Last, this releases the batch once the ticker is done with it
+	ActiveBatch.Reset();
+}
+
+void FOVRLipSyncBatchCooker::CancelActive()
+{
+	if (ActiveBatch.IsValid())
+	{
+		ActiveBatch->bCancelled = true;
+	}
+}
+
+void FOVRLipSyncBatchCooker::Fail(const FAssetData &Asset, const FString &Error)
+{
+	Failures.Add(FString::Printf(TEXT("Can't generate LipSync sequence for %s: %s"), *Asset.GetObjectPathString(),
+								 *Error));
+}
+
+void FOVRLipSyncBatchCooker::UpdateNotification()
+{
+	if (Notification.IsValid())
+	{
+		Notification->SetText(FText::Format(
+			NSLOCTEXT("NSLT_OVRLipSyncPlugin", "GeneratingLipSyncSequencesProgress",
+					  "Generating LipSync sequences: {0} / {1}"),
+			FText::AsNumber(NumDone), FText::AsNumber(Assets.Num())));
+	}
+}
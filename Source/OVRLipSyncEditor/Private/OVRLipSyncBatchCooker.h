@@ -0,0 +1,87 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncBatchCooker.h
+ * Content     :   Generates LipSync sequences for many sound waves on worker threads
+ ******************************************************************************/
+
+#pragma once
+
+#include "AssetRegistry/AssetData.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "CoreMinimal.h"
+#include "OVRLipSyncFrame.h"
+
+#include <atomic>
+
+class SNotificationItem;
+class UOVRLipSyncFrameSequence;
+class UPackage;
+
+/**
+ * Runs inference for a batch of sound waves without blocking the editor. One wave per tick is handed to the thread
+ * pool, which decodes its imported audio and runs inference without touching the wave or the audio device. The
+ * finished sequences are created, registered and saved in groups of SaveBatchSize. A notification shows the overall
+ * progress and lets the user cancel; failed waves are collected and reported when the batch ends instead of stopping
+ * it.
+ */
+class FOVRLipSyncBatchCooker : public TSharedFromThis<FOVRLipSyncBatchCooker>
+{
+public:
+	// Sequences registered and saved together
+	static constexpr int32 SaveBatchSize = 50;
+
+	/**
+	 * Start generating sequences. While a batch with the same model is running the waves are added to it instead.
+	 *
+	 * @param SoundWaveAssets The sound waves to generate sequences for.
+	 * @param bUseOfflineModel Use the offline model instead of the default one.
+	 */
+	static void Start(const TArray<FAssetData> &SoundWaveAssets, bool bUseOfflineModel);
+
+	// Cancel the running batch and release it, sequences not saved yet are left to the editor's save prompt
+	static void Shutdown();
+
+private:
+	struct FResult
+	{
+		FAssetData Asset;
+		TArray<FOVRLipSyncFrame> Frames;
+		FString SourceHash;
+		FString SourcePackageHash;
+		FString Error;
+	};
+
+	FOVRLipSyncBatchCooker(const TArray<FAssetData> &InAssets, bool bInUseOfflineModel);
+
+	void Begin();
+	bool Tick(float DeltaTime);
+	// Find the audio of the next asset and queue its decoding and inference, on the game thread
+	void LaunchNext();
+	void CreateSequence(FResult &Result);
+	void SavePending();
+	void Complete();
+	// Bound to the notification's Cancel button, which can outlive the batch
+	static void CancelActive();
+	void Fail(const FAssetData &Asset, const FString &Error);
+	void UpdateNotification();
+
+	TArray<FAssetData> Assets;
+	bool bUseOfflineModel;
+	FString ModelPath;
+	int32 MaxInFlight = 1;
+	int32 NextAsset = 0;
+	int32 NumInFlight = 0;
+	int32 NumDone = 0;
+	int32 NumCreated = 0;
+	TArray<FString> Failures;
+	TArray<UOVRLipSyncFrameSequence *> PendingSequences;
+
+	TQueue<FResult, EQueueMode::Mpsc> Results;
+	std::atomic<bool> bCancelled{false};
+
+	TSharedPtr<SNotificationItem> Notification;
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	// The running batch, owned here until Complete; workers hold their own reference while they run
+	static TSharedPtr<FOVRLipSyncBatchCooker> ActiveBatch;
+};
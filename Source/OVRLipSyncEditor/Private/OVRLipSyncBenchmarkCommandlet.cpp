@@ -0,0 +1,367 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncBenchmarkCommandlet.cpp
+ * Content     :   Throughput and cost benchmark of the LipSync pipeline on synthetic speech
+ ******************************************************************************/
+
+#include "OVRLipSyncBenchmarkCommandlet.h"
+
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMesh.h"
+#include "CookFrameSequenceAsync.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "OVRLipSyncCompactTrack.h"
+#include "OVRLipSyncFileBuffer.h"
+#include "OVRLipSyncPlaybackActorComponent.h"
+#include "OVRLipSyncSequenceGenerator.h"
+#include "OVRLipSyncSettings.h"
+#include "OVRLipSyncVisemePostProcess.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace
+{
+TArray<int32> ParseIntList(const FString &Params, const TCHAR *Name, const TCHAR *Default)
+{
+	FString Value = Default;
+	FParse::Value(*Params, Name, Value, false);
+	TArray<FString> Items;
+	Value.ParseIntoArray(Items, TEXT("+"));
+	TArray<int32> Values;
+	for (const FString &Item : Items)
+	{
+		const int32 Parsed = FCString::Atoi(*Item);
+		if (Parsed > 0)
+		{
+			Values.Add(Parsed);
+		}
+	}
+	return Values;
+}
+
+/**
+ * Mono signal alternating syllables, fricative-like noise bursts and pauses. Syllables are harmonics of a varying
+ * pitch weighted by the first two formants of a vowel, under an attack and decay envelope.
+ */
+TArray<float> MakeSpeechLikeSignal(int32 SampleRate, int32 NumSamples, FRandomStream &Random)
+{
+	// First and second formants of aa, E, ih, oh and ou
+	static const float Formants[][2] = {{730.0f, 1090.0f}, {530.0f, 1840.0f}, {390.0f, 1990.0f},
+										{570.0f, 840.0f},  {300.0f, 870.0f}};
+	constexpr float FormantBandwidth = 120.0f;
+
+	TArray<float> Signal;
+	Signal.SetNumZeroed(NumSamples);
+	int32 Offset = 0;
+	while (Offset < NumSamples)
+	{
+		const float Kind = Random.FRand();
+		if (Kind < 0.2f)
+		{
+			// Silence gap
+			Offset += static_cast<int32>(SampleRate * Random.FRandRange(0.1f, 0.4f));
+			continue;
+		}
+
+		const float Seconds = Kind < 0.4f ? Random.FRandRange(0.04f, 0.12f) : Random.FRandRange(0.15f, 0.3f);
+		const int32 Length = FMath::Min(static_cast<int32>(SampleRate * Seconds), NumSamples - Offset);
+		if (Kind < 0.4f)
+		{
+			// Noise burst, from its own stream so the layout doesn't depend on the rate
+			FRandomStream Noise(Random.GetUnsignedInt());
+			for (int32 Index = 0; Index < Length; ++Index)
+			{
+				const float Envelope = FMath::Sin(PI * Index / Length);
+				Signal[Offset + Index] = 0.3f * Envelope * Noise.FRandRange(-1.0f, 1.0f);
+			}
+		}
+		else
+		{
+			// Voiced syllable
+			const float *Vowel = Formants[Random.RandHelper(UE_ARRAY_COUNT(Formants))];
+			const float Pitch = Random.FRandRange(100.0f, 220.0f);
+			const float PitchSlope = Random.FRandRange(-0.3f, 0.3f);
+			// Harmonics up to 4 kHz, below the Nyquist frequency
+			const float MaxFrequency = FMath::Min(4000.0f, SampleRate * 0.45f);
+			const int32 NumHarmonics = FMath::Min(32, static_cast<int32>(MaxFrequency / Pitch));
+			TArray<float> Weights;
+			for (int32 Harmonic = 1; Harmonic <= NumHarmonics; ++Harmonic)
+			{
+				const float Frequency = Harmonic * Pitch;
+				float Weight = 0.0f;
+				for (int32 Formant = 0; Formant < 2; ++Formant)
+				{
+					const float Distance = (Frequency - Vowel[Formant]) / FormantBandwidth;
+					Weight += 1.0f / (1.0f + Distance * Distance);
+				}
+				Weights.Add(Weight / Harmonic);
+			}
+
+			float Phase = 0.0f;
+			const int32 Attack = FMath::Max(1, Length / 5);
+			for (int32 Index = 0; Index < Length; ++Index)
+			{
+				const float Envelope = Index < Attack ? static_cast<float>(Index) / Attack
+													  : 1.0f - static_cast<float>(Index - Attack) / (Length - Attack);
+				float Sample = 0.0f;
+				for (int32 Harmonic = 0; Harmonic < Weights.Num(); ++Harmonic)
+				{
+					Sample += Weights[Harmonic] * FMath::Sin((Harmonic + 1) * Phase);
+				}
+				Signal[Offset + Index] = 0.25f * Envelope * Sample;
+				Phase += 2.0f * PI * Pitch * (1.0f + PitchSlope * Index / Length) / SampleRate;
+				Phase = FMath::Fmod(Phase, 2.0f * PI);
+			}
+		}
+		Offset += Length;
+	}
+	return Signal;
+}
+
+// 16-bit PCM WAV file of a mono signal, copied to every channel with a slightly lower level on the extra ones
+TArray<uint8> MakeWaveFile(const TArray<float> &Signal, int32 SampleRate, int32 NumChannels)
+{
+	const uint32 DataSize = Signal.Num() * NumChannels * sizeof(int16);
+	TArray<uint8> Bytes;
+	Bytes.Reserve(44 + DataSize);
+	auto Append = [&Bytes](const void *Data, int32 Size) { Bytes.Append(static_cast<const uint8 *>(Data), Size); };
+	auto Append32 = [&Append](uint32 Value) { Append(&Value, 4); };
+	auto Append16 = [&Append](uint16 Value) { Append(&Value, 2); };
+
+	Append("RIFF", 4);
+	Append32(36 + DataSize);
+	Append("WAVEfmt ", 8);
+	Append32(16);
+	Append16(1);
+	Append16(NumChannels);
+	Append32(SampleRate);
+	Append32(SampleRate * NumChannels * sizeof(int16));
+	Append16(NumChannels * sizeof(int16));
+	Append16(16);
+	Append("data", 4);
+	Append32(DataSize);
+	for (const float Sample : Signal)
+	{
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			const float Level = Channel == 0 ? 1.0f : 0.8f;
+			Append16(static_cast<uint16>(static_cast<int16>(FMath::Clamp(Sample * Level, -1.0f, 1.0f) * 32767.0f)));
+		}
+	}
+	return Bytes;
+}
+
+double ToMegabytes(uint64 Bytes) { return Bytes / (1024.0 * 1024.0); }
+} // namespace
+
+UOVRLipSyncBenchmarkCommandlet::UOVRLipSyncBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UOVRLipSyncBenchmarkCommandlet::Main(const FString &Params)
+{
+	const TArray<int32> Rates = ParseIntList(Params, TEXT("Rates="), TEXT("16000+44100+48000"));
+	const TArray<int32> ChannelCounts = ParseIntList(Params, TEXT("Channels="), TEXT("1+2"));
+	const TArray<int32> Lengths = ParseIntList(Params, TEXT("Lengths="), TEXT("10+60"));
+	int32 Iterations = 20;
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	Iterations = FMath::Max(Iterations, 1);
+	int32 Seed = 1;
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	const bool bUseOfflineModel = FParse::Param(*Params, TEXT("OfflineModel"));
+	FString OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("OVRLipSync"),
+										 FString::Printf(TEXT("Benchmark-%s.json"), *FDateTime::Now().ToString()));
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	FString MeshPath;
+	FParse::Value(*Params, TEXT("Mesh="), MeshPath);
+
+	const FString ModelPath = FOVRLipSyncSequenceGenerator::GetModelPath(bUseOfflineModel);
+	const std::atomic<bool> bCancelled{false};
+	const FOVRLipSyncPlatformCookSettings &PackagingSettings = GetDefault<UOVRLipSyncSettings>()->DefaultSettings;
+	// Kept alive across the garbage collection after each case
+	TStrongObjectPtr<UOVRLipSyncPlaybackActorComponent> Component(
+		NewObject<UOVRLipSyncPlaybackActorComponent>(GetTransientPackage()));
+	TStrongObjectPtr<USkeletalMeshComponent> Mesh;
+	int32 NumFailed = 0;
+	if (!MeshPath.IsEmpty())
+	{
+		// Without the morph targets SetMorphTarget only fills a map, which says nothing about a real face
+		USkeletalMesh *SkeletalMesh = LoadObject<USkeletalMesh>(nullptr, *MeshPath);
+		TArray<FString> Missing;
+		for (const FString &VisemeName : Component->GetVisemeNames())
+		{
+			if (SkeletalMesh && !SkeletalMesh->FindMorphTarget(FName(*VisemeName)))
+			{
+				Missing.Add(VisemeName);
+			}
+		}
+		if (!SkeletalMesh)
+		{
+			UE_LOG(LogTemp, Error, TEXT("OVRLipSyncBenchmark: can't load skeletal mesh %s"), *MeshPath);
+			return 1;
+		}
+		if (Missing.Num() > 0)
+		{
+			UE_LOG(LogTemp, Error, TEXT("OVRLipSyncBenchmark: %s has no morph target for %s"), *MeshPath,
+				   *FString::Join(Missing, TEXT(", ")));
+			return 1;
+		}
+		Mesh.Reset(NewObject<USkeletalMeshComponent>(GetTransientPackage()));
+		Mesh->SetSkeletalMeshAsset(SkeletalMesh);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Display, TEXT("OVRLipSyncBenchmark: no -Mesh, morph targets won't be measured"));
+	}
+
+	TArray<TSharedPtr<FJsonValue>> Cases;
+	for (const int32 Length : Lengths)
+	{
+		for (const int32 Rate : Rates)
+		{
+			for (const int32 NumChannels : ChannelCounts)
+			{
+				const FString Name = FString::Printf(TEXT("%ds_%dHz_%dch"), Length, Rate, NumChannels);
+				TSharedRef<FJsonObject> Case = MakeShared<FJsonObject>();
+				Case->SetStringField(TEXT("name"), Name);
+				Case->SetNumberField(TEXT("seconds"), Length);
+				Case->SetNumberField(TEXT("sampleRate"), Rate);
+				Case->SetNumberField(TEXT("channels"), NumChannels);
+
+				// Same syllables and pauses for every rate and channel count of a length
+				FRandomStream Random(Seed + Length);
+				const TArray<float> Signal = MakeSpeechLikeSignal(Rate, Length * Rate, Random);
+
+				// Cooking: decoding and inference
+				const uint64 UsedBefore = FPlatformMemory::GetStats().UsedPhysical;
+				FOVRLipSyncGeneratorJob Job;
+				FString Error;
+				Job.Decoder = IOVRLipSyncAudioDecoder::Create(
+					FOVRLipSyncFileBuffer::FromArray(MakeWaveFile(Signal, Rate, NumChannels)), &Error);
+				TArray<FOVRLipSyncFrame> Frames;
+				double StartTime = FPlatformTime::Seconds();
+				if (!Job.Decoder || !FOVRLipSyncSequenceGenerator::Generate(Job, ModelPath, bCancelled, Frames, Error))
+				{
+					UE_LOG(LogTemp, Error, TEXT("OVRLipSyncBenchmark: %s: %s"), *Name, *Error);
+					++NumFailed;
+					continue;
+				}
+				const double CookSeconds = FPlatformTime::Seconds() - StartTime;
+				const uint64 UsedAfter = FPlatformMemory::GetStats().UsedPhysical;
+				TSharedRef<FJsonObject> Cook = MakeShared<FJsonObject>();
+				Cook->SetNumberField(TEXT("frames"), Frames.Num());
+				Cook->SetNumberField(TEXT("seconds"), CookSeconds);
+				Cook->SetNumberField(TEXT("realTimeMultiple"), CookSeconds > 0.0 ? Length / CookSeconds : 0.0);
+				Cook->SetNumberField(TEXT("usedPhysicalDeltaMB"),
+									 UsedAfter > UsedBefore ? ToMegabytes(UsedAfter - UsedBefore) : 0.0);
+				Case->SetObjectField(TEXT("cook"), Cook);
+
+				// Post-processing, with the default settings of the cook node
+				TArray<TArray<float>> RawVisemeFrames;
+				TArray<float> LaughterScores;
+				for (const FOVRLipSyncFrame &Frame : Frames)
+				{
+					RawVisemeFrames.Add(Frame.VisemeScores);
+					LaughterScores.Add(Frame.LaughterScore);
+				}
+				UOVRLipSyncFrameSequence *Sequence = NewObject<UOVRLipSyncFrameSequence>(GetTransientPackage());
+				FOVRLipSyncPostProcessTimings Timings;
+				FOVRLipSyncVisemePostProcess::Apply(RawVisemeFrames, LaughterScores, FVisemeInterpolationSettings(),
+													*Sequence, &Timings);
+				TSharedRef<FJsonObject> PostProcess = MakeShared<FJsonObject>();
+				PostProcess->SetNumberField(TEXT("filterMs"), Timings.FilterSeconds * 1000.0);
+				PostProcess->SetNumberField(TEXT("clusterMs"), Timings.ClusterSeconds * 1000.0);
+				PostProcess->SetNumberField(TEXT("applyMs"), Timings.ApplySeconds * 1000.0);
+				PostProcess->SetNumberField(TEXT("smoothMs"), Timings.SmoothSeconds * 1000.0);
+				Case->SetObjectField(TEXT("postProcess"), PostProcess);
+
+				// Playback evaluation of the editor frames and of the packaged track
+				float MaxError = 0.0f;
+				const FOVRLipSyncCompactTrack Track =
+					FOVRLipSyncCompactTrack::Build(Sequence->FrameSequence, PackagingSettings, MaxError);
+				TArray<float> Visemes;
+				float LaughterScore = 0.0f;
+				const int64 NumEvaluations = static_cast<int64>(Sequence->Num()) * Iterations;
+				StartTime = FPlatformTime::Seconds();
+				for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+				{
+					for (int32 Index = 0; Index < static_cast<int32>(Sequence->Num()); ++Index)
+					{
+						Sequence->GetFrame(Index, Visemes, LaughterScore);
+					}
+				}
+				const double EditorSeconds = FPlatformTime::Seconds() - StartTime;
+				StartTime = FPlatformTime::Seconds();
+				for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+				{
+					for (int32 Index = 0; Index < Track.NumFrames; ++Index)
+					{
+						Track.GetFrame(Index, Visemes, LaughterScore);
+					}
+				}
+				const double PackagedSeconds = FPlatformTime::Seconds() - StartTime;
+				const int64 NumPackagedEvaluations = static_cast<int64>(Track.NumFrames) * Iterations;
+				TSharedRef<FJsonObject> Playback = MakeShared<FJsonObject>();
+				Playback->SetNumberField(TEXT("editorNsPerFrame"),
+										 NumEvaluations > 0 ? EditorSeconds * 1e9 / NumEvaluations : 0.0);
+				Playback->SetNumberField(TEXT("packagedNsPerFrame"), NumPackagedEvaluations > 0
+																		? PackagedSeconds * 1e9 / NumPackagedEvaluations
+																		: 0.0);
+				Playback->SetNumberField(TEXT("packagedFrameRate"), Track.FrameRate);
+				Playback->SetNumberField(TEXT("packagedBytes"), Track.GetAllocatedSize());
+				Playback->SetNumberField(TEXT("editorBytes"), Sequence->GetFramesAllocatedSize());
+				Case->SetObjectField(TEXT("playback"), Playback);
+
+				// Morph target application, one call per frame of the sequence
+				if (Mesh.IsValid())
+				{
+					StartTime = FPlatformTime::Seconds();
+					for (int64 Call = 0; Call < NumEvaluations; ++Call)
+					{
+						Component->AssignVisemesToMorphTargets(Mesh.Get(), {});
+					}
+					const double MorphSeconds = FPlatformTime::Seconds() - StartTime;
+					Case->SetNumberField(TEXT("morphNsPerCall"),
+										 NumEvaluations > 0 ? MorphSeconds * 1e9 / NumEvaluations : 0.0);
+				}
+
+				UE_LOG(LogTemp, Display, TEXT("OVRLipSyncBenchmark: %s cooked at %.1fx real time"), *Name,
+					   CookSeconds > 0.0 ? Length / CookSeconds : 0.0);
+				Cases.Add(MakeShared<FJsonValueObject>(Case));
+				CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			}
+		}
+	}
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("engineVersion"), FEngineVersion::Current().ToString());
+	Report->SetStringField(TEXT("platform"), FPlatformProperties::IniPlatformName());
+	Report->SetStringField(TEXT("cpu"), FPlatformMisc::GetCPUBrand().TrimStartAndEnd());
+	Report->SetNumberField(TEXT("seed"), Seed);
+	Report->SetNumberField(TEXT("iterations"), Iterations);
+	Report->SetBoolField(TEXT("offlineModel"), bUseOfflineModel);
+	Report->SetStringField(TEXT("mesh"), MeshPath);
+	Report->SetNumberField(TEXT("peakUsedPhysicalMB"), ToMegabytes(FPlatformMemory::GetStats().PeakUsedPhysical));
+	Report->SetArrayField(TEXT("cases"), Cases);
+
+	FString Json;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(Report, Writer);
+	if (!FFileHelper::SaveStringToFile(Json, *OutputPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("OVRLipSyncBenchmark: failed to write %s"), *OutputPath);
+		return 1;
+	}
+	UE_LOG(LogTemp, Display, TEXT("OVRLipSyncBenchmark: %d cases, %d failed, written to %s"), Cases.Num(), NumFailed,
+		   *OutputPath);
+	return NumFailed > 0 ? 1 : 0;
+}
@@ -0,0 +1,34 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncBenchmarkCommandlet.h
+ * Content     :   Throughput and cost benchmark of the LipSync pipeline on synthetic speech
+ ******************************************************************************/
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "CoreMinimal.h"
+#include "OVRLipSyncBenchmarkCommandlet.generated.h"
+
+/**
+ * Runs the LipSync pipeline on synthetic, speech-like audio and writes how long each part took to a JSON report.
+ * Every combination of rate, channel count and length is generated from the same seed, so reports of two builds
+ * compare like for like. Each case measures cooking (decoding and inference) as a multiple of real time, the memory
+ * it took, the time of each post-processing step, the cost of evaluating a frame of the editor and packaged data,
+ * and, given a skeletal mesh with the 15 viseme morph targets, the cost of applying a frame to them.
+ *
+ * UnrealEditor-Cmd.exe Project.uproject -run=OVRLipSyncBenchmark [-Rates=16000+44100+48000] [-Channels=1+2]
+ *     [-Lengths=10+60] [-Iterations=20] [-Seed=1] [-OfflineModel] [-Mesh=/Game/Characters/Face] [-Output=Path.json]
+ *
+ * Lengths are in seconds, Iterations is how many times playback and morph target evaluation are repeated. Morph
+ * targets aren't measured without -Mesh. The report is written to Saved/OVRLipSync by default.
+ */
+UCLASS()
+class UOVRLipSyncBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UOVRLipSyncBenchmarkCommandlet();
+
+	virtual int32 Main(const FString &Params) override;
+};
@@ -0,0 +1,244 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncCookCommandlet.cpp
+ * Content     :   Headless, incremental generation of LipSync sequences
+ ******************************************************************************/
+
+#include "OVRLipSyncCookCommandlet.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/Async.h"
+#include "CollectionManagerModule.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+#include "ICollectionManager.h"
+#include "Misc/FileHelper.h"
+#include "OVRLipSyncSequenceGenerator.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Sound/SoundWave.h"
+
+namespace
+{
+TArray<FString> ParseList(const FString &Params, const TCHAR *Name)
+{
+	FString Value;
+	TArray<FString> Items;
+	if (FParse::Value(*Params, Name, Value, false))
+	{
+		Value.ParseIntoArray(Items, TEXT("+"));
+	}
+	return Items;
+}
+
+// Sequences whose package hash tag matches their sound wave's saved package and settings are up to date. Only
+// registry data is compared, a wave resaved without audio changes is regenerated from the Derived Data Cache.
+bool IsUpToDate(IAssetRegistry &AssetRegistry, const FAssetData &SoundWaveAsset, bool bUseOfflineModel)
+{
+	const FAssetData SequenceAsset = AssetRegistry.GetAssetByObjectPath(
+		FSoftObjectPath(FOVRLipSyncSequenceGenerator::GetSequenceObjectPath(SoundWaveAsset)));
+	FString StoredHash;
+	if (!SequenceAsset.IsValid() || !SequenceAsset.GetTagValue(TEXT("SourcePackageHash"), StoredHash) ||
+		StoredHash.IsEmpty())
+	{
+		return false;
+	}
+	return FOVRLipSyncSequenceGenerator::ComputeSourcePackageHash(SoundWaveAsset, bUseOfflineModel) == StoredHash;
+}
+} // namespace
+
+UOVRLipSyncCookCommandlet::UOVRLipSyncCookCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UOVRLipSyncCookCommandlet::Main(const FString &Params)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	const TArray<FString> Paths = ParseList(Params, TEXT("Paths="));
+	const TArray<FString> Collections = ParseList(Params, TEXT("Collections="));
+	const bool bForce = FParse::Param(*Params, TEXT("Force"));
+	const bool bUseOfflineModel = FParse::Param(*Params, TEXT("OfflineModel"));
+	int32 NumThreads = FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+	FParse::Value(*Params, TEXT("Threads="), NumThreads);
+	NumThreads = FMath::Max(NumThreads, 1);
+	FString ReportPath;
+	FParse::Value(*Params, TEXT("Report="), ReportPath);
+
+	if (Paths.Num() == 0 && Collections.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("OVRLipSyncCook: pass -Paths=/Game/A+/Game/B and/or -Collections=A+B"));
+		return 1;
+	}
+
+	// Gather the sound waves
+	IAssetRegistry &AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	TArray<FAssetData> SoundWaves;
+	if (Paths.Num() > 0)
+	{
+		AssetRegistry.ScanPathsSynchronous(Paths, true);
+		FARFilter Filter;
+		Filter.ClassPaths.Add(USoundWave::StaticClass()->GetClassPathName());
+		Filter.bRecursiveClasses = true;
+		Filter.bRecursivePaths = true;
+		for (const FString &Path : Paths)
+		{
+			Filter.PackagePaths.Add(*Path);
+		}
+		AssetRegistry.GetAssets(Filter, SoundWaves);
+	}
+	if (Collections.Num() > 0)
+	{
+		AssetRegistry.SearchAllAssets(true);
+		ICollectionManager &CollectionManager = FCollectionManagerModule::GetModule().Get();
+		for (const FString &Collection : Collections)
+		{
+			TArray<FSoftObjectPath> ObjectPaths;
+			if (!CollectionManager.GetAssetsInCollection(*Collection, ECollectionShareType::CST_All, ObjectPaths))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("OVRLipSyncCook: collection %s not found"), *Collection);
+				continue;
+			}
+			for (const FSoftObjectPath &ObjectPath : ObjectPaths)
+			{
+				const FAssetData Asset = AssetRegistry.GetAssetByObjectPath(ObjectPath);
+				if (Asset.IsValid() && Asset.IsInstanceOf(USoundWave::StaticClass()))
+				{
+					SoundWaves.AddUnique(Asset);
+				}
+			}
+		}
+	}
+
+	// Work out what is missing or stale
+	TArray<FAssetData> Stale;
+	for (const FAssetData &SoundWave : SoundWaves)
+	{
+		if (bForce || !IsUpToDate(AssetRegistry, SoundWave, bUseOfflineModel))
+		{
+			Stale.Add(SoundWave);
+		}
+	}
+	UE_LOG(LogTemp, Display, TEXT("OVRLipSyncCook: %d sound waves, %d to generate on %d threads"), SoundWaves.Num(),
+		   Stale.Num(), NumThreads);
+
+	const FString ModelPath = FOVRLipSyncSequenceGenerator::GetModelPath(bUseOfflineModel);
+	const std::atomic<bool> bCancelled{false};
+	int32 NumCooked = 0;
+	int64 NumFrames = 0;
+	TArray<FString> Failures;
+
+	for (int32 BatchStart = 0; BatchStart < Stale.Num(); BatchStart += BatchSize)
+	{
+		const int32 BatchEnd = FMath::Min(BatchStart + BatchSize, Stale.Num());
+
+		TArray<FOVRLipSyncGeneratorJob> Jobs;
+		for (int32 Index = BatchStart; Index < BatchEnd; ++Index)
+		{
+			FOVRLipSyncGeneratorJob Job;
+			FString Error;
+			if (FOVRLipSyncSequenceGenerator::Prepare(Stale[Index], bUseOfflineModel, Job, Error))
+			{
+				Jobs.Add(MoveTemp(Job));
+			}
+			else
+			{
+				Failures.Add(FString::Printf(TEXT("%s: %s"), *Stale[Index].GetObjectPathString(), *Error));
+			}
+		}
+
+		// Each thread takes the next job until the batch is done
+		TArray<TArray<FOVRLipSyncFrame>> Frames;
+		TArray<FString> Errors;
+		Frames.SetNum(Jobs.Num());
+		Errors.SetNum(Jobs.Num());
+		std::atomic<int32> NextJob{0};
+		TArray<TFuture<void>> Workers;
+		for (int32 Thread = 0; Thread < FMath::Min(NumThreads, Jobs.Num()); ++Thread)
+		{
+			Workers.Add(Async(EAsyncExecution::Thread,
+							  [&]()
+							  {
+								  int32 Index;
+								  while ((Index = NextJob++) < Jobs.Num())
+								  {
+									  FOVRLipSyncSequenceGenerator::GenerateCached(Jobs[Index], ModelPath, bCancelled,
+																				   Frames[Index], Errors[Index]);
+								  }
+							  }));
+		}
+		for (TFuture<void> &Worker : Workers)
+		{
+			Worker.Wait();
+		}
+
+		TArray<UOVRLipSyncFrameSequence *> Sequences;
+		for (int32 Index = 0; Index < Jobs.Num(); ++Index)
+		{
+			if (!Errors[Index].IsEmpty())
+			{
+				Failures.Add(FString::Printf(TEXT("%s: %s"), *Jobs[Index].Asset.GetObjectPathString(), *Errors[Index]));
+				continue;
+			}
+			NumFrames += Frames[Index].Num();
+			Sequences.Add(FOVRLipSyncSequenceGenerator::CreateSequence(Jobs[Index].Asset, MoveTemp(Frames[Index]),
+																	   Jobs[Index].SourceHash,
+																	   Jobs[Index].SourcePackageHash));
+		}
+		if (!FOVRLipSyncSequenceGenerator::SaveSequences(Sequences))
+		{
+			Failures.Add(FString::Printf(TEXT("failed to save some of the %d sequences of a batch"), Sequences.Num()));
+		}
+		NumCooked += Sequences.Num();
+
+		// Saved sequences and the loaded sound waves are no longer needed
+		for (UOVRLipSyncFrameSequence *Sequence : Sequences)
+		{
+			Sequence->ClearFlags(RF_Standalone);
+		}
+		Jobs.Empty();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		UE_LOG(LogTemp, Display, TEXT("OVRLipSyncCook: %d / %d"), BatchEnd, Stale.Num());
+	}
+
+	for (const FString &Failure : Failures)
+	{
+		UE_LOG(LogTemp, Error, TEXT("OVRLipSyncCook: %s"), *Failure);
+	}
+
+	const double Seconds = FPlatformTime::Seconds() - StartTime;
+	const double AudioSeconds = NumFrames / 100.0;
+	TSharedRef<FJsonObject> Summary = MakeShared<FJsonObject>();
+	Summary->SetNumberField(TEXT("scanned"), SoundWaves.Num());
+	Summary->SetNumberField(TEXT("upToDate"), SoundWaves.Num() - Stale.Num());
+	Summary->SetNumberField(TEXT("cooked"), NumCooked);
+	Summary->SetNumberField(TEXT("failed"), Failures.Num());
+	Summary->SetNumberField(TEXT("threads"), NumThreads);
+	Summary->SetNumberField(TEXT("seconds"), Seconds);
+	Summary->SetNumberField(TEXT("audioSeconds"), AudioSeconds);
+	Summary->SetNumberField(TEXT("assetsPerSecond"), Seconds > 0.0 ? NumCooked / Seconds : 0.0);
+	Summary->SetNumberField(TEXT("audioSecondsPerSecond"), Seconds > 0.0 ? AudioSeconds / Seconds : 0.0);
+	TArray<TSharedPtr<FJsonValue>> FailureValues;
+	for (const FString &Failure : Failures)
+	{
+		FailureValues.Add(MakeShared<FJsonValueString>(Failure));
+	}
+	Summary->SetArrayField(TEXT("failures"), FailureValues);
+
+	FString Json;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+		TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+	FJsonSerializer::Serialize(Summary, Writer);
+	if (!ReportPath.IsEmpty() && !FFileHelper::SaveStringToFile(Json, *ReportPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("OVRLipSyncCook: failed to write %s"), *ReportPath);
+	}
+	UE_LOG(LogTemp, Display, TEXT("OVRLipSyncCook summary: %s"), *Json);
+
+	return Failures.Num() > 0 ? 1 : 0;
+}
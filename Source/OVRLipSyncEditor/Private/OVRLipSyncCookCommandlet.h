@@ -0,0 +1,34 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncCookCommandlet.h
+ * Content     :   Headless, incremental generation of LipSync sequences
+ ******************************************************************************/
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "CoreMinimal.h"
+#include "OVRLipSyncCookCommandlet.generated.h"
+
+/**
+ * Generates the LipSync sequences of every sound wave under the given paths or in the given collections, skipping
+ * sequences whose stored package hash still matches their sound wave's saved package and settings. The check only
+ * reads the asset registry, sound waves are loaded for the sequences that are regenerated.
+ *
+ * UnrealEditor-Cmd.exe Project.uproject -run=OVRLipSyncCook -Paths=/Game/VO+/Game/Barks [-Collections=A+B]
+ *     [-Force] [-Threads=N] [-OfflineModel] [-Report=Path.json]
+ *
+ * A JSON summary is printed on the last line of the log and written to -Report when given.
+ */
+UCLASS()
+class UOVRLipSyncCookCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	// Sound waves loaded and generated between two saves
+	static constexpr int32 BatchSize = 256;
+
+	UOVRLipSyncCookCommandlet();
+
+	virtual int32 Main(const FString &Params) override;
+};
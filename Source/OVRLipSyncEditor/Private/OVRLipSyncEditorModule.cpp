@@ -23,181 +23,128 @@
 #include "ContentBrowserModule.h"
 
 #include "AssetRegistry/AssetRegistryModule.h"
-#include "AudioDecompress.h"
-#include "AudioDevice.h"
+#include "AssetToolsModule.h"
 #include "Engine.h"
 #include "Framework/Commands/UIAction.h"
 #include "Framework/MultiBox/MultiBoxBuilder.h"
-#include "Misc/EngineVersionComparison.h"
-#include "Misc/ScopedSlowTask.h"
+#include "Framework/Notifications/NotificationManager.h"
 #include "Modules/ModuleManager.h"
-#include "OVRLipSyncContextWrapper.h"
-#include "OVRLipSyncFrame.h"
-#include "Sound/SoundWave.h"
+#include "OVRLipSyncAudit.h"
+#include "OVRLipSyncBatchCooker.h"
+#include "OVRLipSyncImportHook.h"
+#include "OVRLipSyncSequenceBank.h"
 #include "Textures/SlateIcon.h"
+#include "Widgets/Notifications/SNotificationList.h"
 
 namespace
 {
 
-// Compute LipSync sequence frames at 100 times a second rate
-constexpr auto LipSyncSequenceUpateFrequency = 100;
-constexpr auto LipSyncSequenceDuration = 1.0f / LipSyncSequenceUpateFrequency;
-
-// Decompresses SoundWave object by initializing RawPCM data
-bool DecompressSoundWave(USoundWave *SoundWave)
+// Generate sequences for all selected waves in the background
+void OVRLipSyncCreateSequence(const TArray<FAssetData> SelectedSoundAssets, bool UseOfflineModel = false)
 {
-	if (SoundWave->RawPCMData)
-	{
-		return true;
-	}
-	auto AudioDevice = GEngine->GetMainAudioDevice();
-	if (!AudioDevice)
-	{
-		return false;
-	}
-
-	AudioDevice->StopAllSounds(true);
-	auto OriginalDecompressionType = SoundWave->DecompressionType;
-	SoundWave->DecompressionType = DTYPE_RealTime;
-	if (SoundWave->InitAudioResource(SoundWave->GetRuntimeFormat()))
-	{
-#if UE_VERSION_OLDER_THAN(4, 22, 0)
-		USoundWave::FAsyncAudioDecompress Decompress(SoundWave);
-#else
-		USoundWave::FAsyncAudioDecompress Decompress(SoundWave, MONO_PCM_BUFFER_SAMPLES);
-#endif
-		Decompress.StartSynchronousTask();
-	}
-	SoundWave->DecompressionType = OriginalDecompressionType;
+	FOVRLipSyncBatchCooker::Start(SelectedSoundAssets, UseOfflineModel);
+}
 
-	return true;
+void OVRLipSyncContextMenuExtension(FMenuBuilder &MenuBuilder, const TArray<FAssetData> SelectedSoundWavesPath)
+{
+	// SoundWaves are already loaded at that point, so convert Paths to a lest
+	// of weak pointers
+	MenuBuilder.AddMenuEntry(
+		NSLOCTEXT("NSLT_OVRLipSyncPlugin", "CreateLipSyncSequence_Menu", "Generate LipSyncSequence"),
+		NSLOCTEXT("NSLT_OVRLipSyncPlugin", "CreateLipSyncSequence_Tooltip",
+				  "Creates sequence asset that could be used by OVRLipSyncPlaybackActorComponent"),
+		FSlateIcon(), FUIAction(FExecuteAction::CreateStatic(OVRLipSyncCreateSequence, SelectedSoundWavesPath, false)));
+	MenuBuilder.AddMenuEntry(
+		NSLOCTEXT("NSLT_OVRLipSyncPlugin", "CreateLipSyncSequenceWithOfflineModel_Menu",
+				  "Generate LipSyncSequence with Offline Model"),
+		NSLOCTEXT("NSLT_OVRLipSyncPlugin", "CreateLipSyncSequenceWithOfflineModel_Tooltip",
+				  "Creates sequence asset that could be used by OVRLipSyncPlaybackActorComponent"),
+		FSlateIcon(), FUIAction(FExecuteAction::CreateStatic(OVRLipSyncCreateSequence, SelectedSoundWavesPath, true)));
 }
 
-bool OVRLipSyncProcessSoundWave(const FAssetData &SoundWaveAsset, bool UseOfflineModel = false)
+// Pack the selected sequences into a new bank next to the first one, keyed by the name of their sound wave
+void OVRLipSyncCreateBank(const TArray<FAssetData> SelectedSequenceAssets)
 {
-	auto ObjectPath = SoundWaveAsset.GetObjectPathString();
-	auto SoundWave = FindObject<USoundWave>(NULL, *ObjectPath);
-	if (!SoundWave)
+	FString PackageName, AssetName;
+	FAssetToolsModule::GetModule().Get().CreateUniqueAssetName(
+		FString::Printf(TEXT("%s/LipSyncBank"), *SelectedSequenceAssets[0].PackagePath.ToString()), TEXT(""),
+		PackageName, AssetName);
+	auto Bank = NewObject<UOVRLipSyncSequenceBank>(CreatePackage(*PackageName), *AssetName,
+												   RF_Public | RF_Standalone | RF_Transactional);
+	for (const FAssetData &Asset : SelectedSequenceAssets)
 	{
-		UE_LOG(LogTemp, Error, TEXT("Can't find %s"), *ObjectPath);
-		return false;
+		FOVRLipSyncBankSource &Source = Bank->Sources.AddDefaulted_GetRef();
+		Source.Id = *Asset.AssetName.ToString().Replace(TEXT("_LipSyncSequence"), TEXT(""));
+		Source.Sequence = TSoftObjectPtr<UOVRLipSyncFrameSequence>(Asset.GetSoftObjectPath());
 	}
-	if (SoundWave->NumChannels > 2)
+	FString Error;
+	if (!Bank->Rebuild(&Error))
 	{
-		UE_LOG(LogTemp, Error, TEXT("Can't process %s: only mono and stereo streams are supported"), *ObjectPath);
-		return false;
+		UE_LOG(LogTemp, Warning, TEXT("%s: some sequences weren't packed: %s"), *Bank->GetPathName(), *Error);
 	}
-	DecompressSoundWave(SoundWave);
-
-	auto SequenceName = FString::Printf(TEXT("%s_LipSyncSequence"), *SoundWaveAsset.AssetName.ToString());
-	auto SequencePath = FString::Printf(TEXT("%s_LipSyncSequence"), *SoundWaveAsset.PackageName.ToString());
-	auto SequencePackage = CreatePackage(*SequencePath);
-	auto Sequence = NewObject<UOVRLipSyncFrameSequence>(SequencePackage, *SequenceName, RF_Public | RF_Standalone);
-
-	auto NumChannels = SoundWave->NumChannels;
-	auto SampleRate = SoundWave->GetSampleRateForCurrentPlatform();
-	auto PCMDataSize = SoundWave->RawPCMDataSize / sizeof(int16_t);
-	auto PCMData = reinterpret_cast<int16_t *>(SoundWave->RawPCMData);
-	auto ChunkSizeSamples = static_cast<int>(SampleRate * LipSyncSequenceDuration);
-	auto ChunkSize = NumChannels * ChunkSizeSamples;
-
-	FString ModelPath = UseOfflineModel ? FPaths::Combine(FPaths::ProjectPluginsDir(), TEXT("OVRLipSync"),
-														  TEXT("OfflineModel"), TEXT("ovrlipsync_offline_model.pb"))
-										: FString();
-	UOVRLipSyncContextWrapper context(ovrLipSyncContextProvider_Enhanced, SampleRate, 4096, ModelPath);
-
-	float LaughterScore = 0.0f;
-	int32_t FrameDelayInMs = 0;
-	TArray<float> Visemes;
-
-	TArray<int16_t> samples;
-	samples.SetNumZeroed(ChunkSize);
-	context.ProcessFrame(samples.GetData(), ChunkSizeSamples, Visemes, LaughterScore, FrameDelayInMs, NumChannels > 1);
-
-	int FrameOffset = (int)(FrameDelayInMs * SampleRate / 1000 * NumChannels);
-
-	FScopedSlowTask SlowTask(PCMDataSize + FrameOffset,
-							 FText::Format(NSLOCTEXT("NSLT_OVRLipSyncPlugin", "GeneratingLipSyncSequence",
-													 "Generating LipSync sequence for {0}..."),
-										   FText::FromName(SoundWaveAsset.AssetName)));
-	SlowTask.MakeDialog();
-	for (int offs = 0; offs < PCMDataSize + FrameOffset; offs += ChunkSize)
+	FAssetRegistryModule::AssetCreated(Bank);
+	Bank->MarkPackageDirty();
+	FModuleManager::LoadModuleChecked<FContentBrowserModule>(TEXT("ContentBrowser"))
+		.Get()
+		.SyncBrowserToAssets(TArray<UObject *>{Bank});
+}
+
+// Repack banks after their source sequences were regenerated
+void OVRLipSyncRebuildBanks(const TArray<FAssetData> SelectedBankAssets)
+{
+	for (const FAssetData &Asset : SelectedBankAssets)
 	{
-		int remainingSamples = PCMDataSize - offs;
-		if (remainingSamples >= ChunkSize)
-		{
-			context.ProcessFrame(PCMData + offs, ChunkSizeSamples, Visemes, LaughterScore, FrameDelayInMs,
-								 NumChannels > 1);
-		}
-		else
+		if (auto Bank = Cast<UOVRLipSyncSequenceBank>(Asset.GetAsset()))
 		{
-			if (remainingSamples > 0)
-			{
-				memcpy(samples.GetData(), PCMData + offs, sizeof(int16_t) * remainingSamples);
-				memset(samples.GetData() + remainingSamples, 0, ChunkSize - remainingSamples);
-			}
-			else
+			Bank->Modify();
+			FString Error;
+			if (!Bank->Rebuild(&Error))
 			{
-				memset(samples.GetData(), 0, ChunkSize);
+				UE_LOG(LogTemp, Warning, TEXT("%s: some sequences weren't packed: %s"), *Bank->GetPathName(), *Error);
 			}
-			context.ProcessFrame(samples.GetData(), ChunkSizeSamples, Visemes, LaughterScore, FrameDelayInMs,
-								 NumChannels > 1);
-		}
-
-		SlowTask.EnterProgressFrame(ChunkSize);
-		if (SlowTask.ShouldCancel())
-		{
-			return false;
-		}
-		if (offs >= FrameOffset)
-		{
-			Sequence->Add(Visemes, LaughterScore);
 		}
 	}
-
-	FAssetRegistryModule::AssetCreated(Sequence);
-	Sequence->MarkPackageDirty();
-	return true;
 }
 
-void OVRLipSyncCreateSequence(const TArray<FAssetData> SelectedSoundAssets, bool UseOfflineModel = false)
+void OVRLipSyncSequenceMenuExtension(FMenuBuilder &MenuBuilder, const TArray<FAssetData> SelectedSequences)
 {
-	for (auto &SoundWaveAsset : SelectedSoundAssets)
-	{
-		if (!OVRLipSyncProcessSoundWave(SoundWaveAsset, UseOfflineModel))
-		{
-			break;
-		}
-	}
+	MenuBuilder.AddMenuEntry(
+		NSLOCTEXT("NSLT_OVRLipSyncPlugin", "CreateLipSyncBank_Menu", "Create LipSync Sequence Bank"),
+		NSLOCTEXT("NSLT_OVRLipSyncPlugin", "CreateLipSyncBank_Tooltip",
+				  "Packs the selected sequences into one bank asset that OVRLipSyncPlaybackActorComponent can play "
+				  "entries of"),
+		FSlateIcon(), FUIAction(FExecuteAction::CreateStatic(OVRLipSyncCreateBank, SelectedSequences)));
 }
 
-void OVRLipSyncContextMenuExtension(FMenuBuilder &MenuBuilder, const TArray<FAssetData> SelectedSoundWavesPath)
+void OVRLipSyncBankMenuExtension(FMenuBuilder &MenuBuilder, const TArray<FAssetData> SelectedBanks)
 {
-	// SoundWaves are already loaded at that point, so convert Paths to a lest
-	// of weak pointers
 	MenuBuilder.AddMenuEntry(
-		NSLOCTEXT("NSLT_OVRLipSyncPlugin", "CreateLipSyncSequence_Menu", "Generate LipSyncSequence"),
-		NSLOCTEXT("NSLT_OVRLipSyncPlugin", "CreateLipSyncSequence_Tooltip",
-				  "Creates sequence asset that could be used by OVRLipSyncPlaybackActorComponent"),
-		FSlateIcon(), FUIAction(FExecuteAction::CreateStatic(OVRLipSyncCreateSequence, SelectedSoundWavesPath, false)));
-	MenuBuilder.AddMenuEntry(
-		NSLOCTEXT("NSLT_OVRLipSyncPlugin", "CreateLipSyncSequenceWithOfflineModel_Menu",
-				  "Generate LipSyncSequence with Offline Model"),
-		NSLOCTEXT("NSLT_OVRLipSyncPlugin", "CreateLipSyncSequenceWithOfflineModel_Tooltip",
-				  "Creates sequence asset that could be used by OVRLipSyncPlaybackActorComponent"),
-		FSlateIcon(), FUIAction(FExecuteAction::CreateStatic(OVRLipSyncCreateSequence, SelectedSoundWavesPath, true)));
+		NSLOCTEXT("NSLT_OVRLipSyncPlugin", "RebuildLipSyncBank_Menu", "Rebuild LipSync Sequence Bank"),
+		NSLOCTEXT("NSLT_OVRLipSyncPlugin", "RebuildLipSyncBank_Tooltip",
+				  "Packs the current frames of the bank's source sequences"),
+		FSlateIcon(), FUIAction(FExecuteAction::CreateStatic(OVRLipSyncRebuildBanks, SelectedBanks)));
 }
 
 TSharedRef<FExtender> OVRLipSyncContextMenuExtender(const TArray<FAssetData> &SelectedAssets)
 {
 	TSharedRef<FExtender> Extender(new FExtender());
 	TArray<FAssetData> SelectedSoundWaveAssets;
+	TArray<FAssetData> SelectedSequenceAssets;
+	TArray<FAssetData> SelectedBankAssets;
 	for (auto &Asset : SelectedAssets)
 	{
 		if (Asset.AssetClassPath.ToString().Contains(TEXT("SoundWave")))
 		{
 			SelectedSoundWaveAssets.Add(Asset);
 		}
+		else if (Asset.AssetClassPath == UOVRLipSyncFrameSequence::StaticClass()->GetClassPathName())
+		{
+			SelectedSequenceAssets.Add(Asset);
+		}
+		else if (Asset.AssetClassPath == UOVRLipSyncSequenceBank::StaticClass()->GetClassPathName())
+		{
+			SelectedBankAssets.Add(Asset);
+		}
 	}
 	if (SelectedSoundWaveAssets.Num() > 0)
 	{
@@ -205,6 +152,56 @@ TSharedRef<FExtender> OVRLipSyncContextMenuExtender(const TArray<FAssetData> &Se
 			"GetAssetActions", EExtensionHook::After, TSharedPtr<FUICommandList>(),
 			FMenuExtensionDelegate::CreateStatic(OVRLipSyncContextMenuExtension, SelectedSoundWaveAssets));
 	}
+	if (SelectedSequenceAssets.Num() > 0)
+	{
+		Extender->AddMenuExtension(
+			"GetAssetActions", EExtensionHook::After, TSharedPtr<FUICommandList>(),
+			FMenuExtensionDelegate::CreateStatic(OVRLipSyncSequenceMenuExtension, SelectedSequenceAssets));
+	}
+	if (SelectedBankAssets.Num() > 0)
+	{
+		Extender->AddMenuExtension(
+			"GetAssetActions", EExtensionHook::After, TSharedPtr<FUICommandList>(),
+			FMenuExtensionDelegate::CreateStatic(OVRLipSyncBankMenuExtension, SelectedBankAssets));
+	}
+	return Extender;
+}
+
+// Write the audit of the selected folders to Saved/OVRLipSync
+void OVRLipSyncAuditPaths(const TArray<FString> SelectedPaths)
+{
+	const TArray<FOVRLipSyncAuditRow> Rows = FOVRLipSyncAudit::Run(SelectedPaths, NAME_None);
+	const FString ReportPath = FPaths::ConvertRelativePathToFull(FOVRLipSyncAudit::GetDefaultReportPath());
+	if (!FOVRLipSyncAudit::WriteCsv(Rows, ReportPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to write LipSync audit to %s"), *ReportPath);
+		return;
+	}
+
+	FNotificationInfo Info(FText::Format(
+		NSLOCTEXT("NSLT_OVRLipSyncPlugin", "LipSyncAuditWritten", "LipSync audit of {0} assets written to {1}"),
+		Rows.Num(), FText::FromString(ReportPath)));
+	Info.ExpireDuration = 8.0f;
+	Info.HyperlinkText = NSLOCTEXT("NSLT_OVRLipSyncPlugin", "LipSyncAuditShow", "Show in folder");
+	Info.Hyperlink = FSimpleDelegate::CreateLambda([ReportPath]() { FPlatformProcess::ExploreFolder(*ReportPath); });
+	FSlateNotificationManager::Get().AddNotification(Info);
+}
+
+void OVRLipSyncPathMenuExtension(FMenuBuilder &MenuBuilder, const TArray<FString> SelectedPaths)
+{
+	MenuBuilder.AddMenuEntry(
+		NSLOCTEXT("NSLT_OVRLipSyncPlugin", "AuditLipSync_Menu", "Audit LipSync Data"),
+		NSLOCTEXT("NSLT_OVRLipSyncPlugin", "AuditLipSync_Tooltip",
+				  "Writes a CSV report of the size and cost of the LipSync sequences in these folders and flags "
+				  "outliers, orphaned sequences and sound waves without a sequence"),
+		FSlateIcon(), FUIAction(FExecuteAction::CreateStatic(OVRLipSyncAuditPaths, SelectedPaths)));
+}
+
+TSharedRef<FExtender> OVRLipSyncPathMenuExtender(const TArray<FString> &SelectedPaths)
+{
+	TSharedRef<FExtender> Extender(new FExtender());
+	Extender->AddMenuExtension("PathContextBulkOperations", EExtensionHook::After, TSharedPtr<FUICommandList>(),
+							   FMenuExtensionDelegate::CreateStatic(OVRLipSyncPathMenuExtension, SelectedPaths));
 	return Extender;
 }
 
@@ -219,7 +216,30 @@ public:
 		auto &ContextMenuExtenders = ContentBrowserModule.GetAllAssetViewContextMenuExtenders();
 		ContextMenuExtenders.Add(
 			FContentBrowserMenuExtender_SelectedAssets::CreateStatic(OVRLipSyncContextMenuExtender));
+		ContentBrowserModule.GetAllPathViewContextMenuExtenders().Add(
+			FContentBrowserMenuExtender_SelectedPaths::CreateStatic(OVRLipSyncPathMenuExtender));
+
+		// Editor subsystems only exist once the engine is up
+		if (GEditor)
+		{
+			ImportHook.Register();
+		}
+		else
+		{
+			PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddLambda([this]() { ImportHook.Register(); });
+		}
 	}
+
+	void ShutdownModule() override
+	{
+		FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+		ImportHook.Unregister();
+		FOVRLipSyncBatchCooker::Shutdown();
+	}
+
+private:
+	FOVRLipSyncImportHook ImportHook;
+	FDelegateHandle PostEngineInitHandle;
 };
 
 IMPLEMENT_MODULE(FOVRLipSyncEditorModule, OVRLipSyncEditor);
\ No newline at end of file
@@ -0,0 +1,39 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncEditorSettings.h
+ * Content     :   Project settings of the OVRLipSync editor tools
+ ******************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "OVRLipSyncEditorSettings.generated.h"
+
+UCLASS(config = Editor, defaultconfig, meta = (DisplayName = "OVRLipSync"))
+class UOVRLipSyncEditorSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UOVRLipSyncEditorSettings() { CategoryName = TEXT("Plugins"); }
+
+	// Generate the LipSync sequence of sound waves in the background when they are imported or reimported
+	UPROPERTY(config, EditAnywhere, Category = "Sequence Generation")
+	bool bGenerateOnImport = false;
+
+	// Use the offline model for sequences generated on import
+	UPROPERTY(config, EditAnywhere, Category = "Sequence Generation", meta = (EditCondition = "bGenerateOnImport"))
+	bool bUseOfflineModel = false;
+
+	// Share generated frames through the Derived Data Cache so a line is only generated once across the team
+	UPROPERTY(config, EditAnywhere, Category = "Sequence Generation")
+	bool bUseDerivedDataCache = true;
+
+	// Largest difference of any score a post-processing candidate may produce against the golden reference
+	UPROPERTY(config, EditAnywhere, Category = "Golden Tests", meta = (ClampMin = "0"))
+	float GoldenMaxTolerance = 1e-4f;
+
+	// Largest mean difference of a viseme or of laughter over a track against the golden reference
+	UPROPERTY(config, EditAnywhere, Category = "Golden Tests", meta = (ClampMin = "0"))
+	float GoldenMeanTolerance = 1e-5f;
+};
@@ -0,0 +1,332 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncGolden.cpp
+ * Content     :   Golden output comparison of viseme post-processing implementations
+ ******************************************************************************/
+
+#include "OVRLipSyncGolden.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "CookFrameSequenceAsync.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "OVRLipSyncReferencePostProcess.h"
+#include "OVRLipSyncSequenceGenerator.h"
+#include "OVRLipSyncVisemePostProcess.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Sound/SoundWave.h"
+
+namespace
+{
+// "LSRW", followed by the version of the layout
+constexpr uint32 TrackMagic = 0x4C535257;
+constexpr int32 TrackVersion = 1;
+
+// Sound waves loaded between two garbage collections
+constexpr int32 RecordBatchSize = 64;
+
+struct FSettingsVariant
+{
+	const TCHAR *Name;
+	FVisemeInterpolationSettings Settings;
+};
+
+// Defaults of the cook node, and each option flipped or pushed to its limits
+TArray<FSettingsVariant> GetSettingsVariants()
+{
+	TArray<FSettingsVariant> Variants;
+	Variants.Add({TEXT("Default"), FVisemeInterpolationSettings()});
+
+	FVisemeInterpolationSettings NoInterpolation;
+	NoInterpolation.bEnableInterpolation = false;
+	Variants.Add({TEXT("NoInterpolation"), NoInterpolation});
+
+	FVisemeInterpolationSettings NoConsonantLock;
+	NoConsonantLock.bStrictConsonantLock = false;
+	Variants.Add({TEXT("NoConsonantLock"), NoConsonantLock});
+
+	FVisemeInterpolationSettings ShortBlocks;
+	ShortBlocks.MaxInterpolationFrames = 1;
+	ShortBlocks.MinHoldFrames = 1;
+	Variants.Add({TEXT("ShortBlocks"), ShortBlocks});
+
+	FVisemeInterpolationSettings LongBlocks;
+	LongBlocks.MaxInterpolationFrames = 24;
+	LongBlocks.MinHoldFrames = 6;
+	Variants.Add({TEXT("LongBlocks"), LongBlocks});
+	return Variants;
+}
+
+void SplitFrames(const TArray<FOVRLipSyncFrame> &Frames, TArray<TArray<float>> &OutVisemes,
+				 TArray<float> &OutLaughterScores)
+{
+	for (const FOVRLipSyncFrame &Frame : Frames)
+	{
+		OutVisemes.Add(Frame.VisemeScores);
+		OutLaughterScores.Add(Frame.LaughterScore);
+	}
+}
+
+void Measure(const TArray<FOVRLipSyncFrame> &Reference, const TArray<FOVRLipSyncFrame> &Candidate,
+			 float MaxTolerance, float MeanTolerance, FOVRLipSyncGoldenResult &Result)
+{
+	Result.NumFrames = Reference.Num();
+	Result.NumCandidateFrames = Candidate.Num();
+	const int32 NumVisemes = Reference.Num() > 0 ? Reference[0].VisemeScores.Num() : 0;
+	Result.MaxDifference.SetNumZeroed(NumVisemes + 1);
+	Result.MeanDifference.SetNumZeroed(NumVisemes + 1);
+	Result.bPassed = Reference.Num() == Candidate.Num();
+
+	TArray<double> Sums;
+	Sums.SetNumZeroed(NumVisemes + 1);
+	const int32 NumFrames = FMath::Min(Reference.Num(), Candidate.Num());
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		const FOVRLipSyncFrame &Expected = Reference[Frame];
+		const FOVRLipSyncFrame &Actual = Candidate[Frame];
+		if (Actual.VisemeScores.Num() != NumVisemes || Expected.VisemeScores.Num() != NumVisemes)
+		{
+			Result.bPassed = false;
+			continue;
+		}
+		for (int32 Index = 0; Index <= NumVisemes; ++Index)
+		{
+			const float Difference = Index < NumVisemes
+										 ? FMath::Abs(Actual.VisemeScores[Index] - Expected.VisemeScores[Index])
+										 : FMath::Abs(Actual.LaughterScore - Expected.LaughterScore);
+			if (FMath::IsNaN(Difference))
+			{
+				Result.bPassed = false;
+				continue;
+			}
+			Result.MaxDifference[Index] = FMath::Max(Result.MaxDifference[Index], Difference);
+			Sums[Index] += Difference;
+		}
+	}
+	for (int32 Index = 0; Index <= NumVisemes; ++Index)
+	{
+		Result.MeanDifference[Index] = NumFrames > 0 ? static_cast<float>(Sums[Index] / NumFrames) : 0.0f;
+		if (Result.MaxDifference[Index] > MaxTolerance || Result.MeanDifference[Index] > MeanTolerance)
+		{
+			Result.bPassed = false;
+		}
+	}
+}
+
+TArray<TSharedPtr<FJsonValue>> ToJsonArray(const TArray<float> &Values)
+{
+	TArray<TSharedPtr<FJsonValue>> JsonValues;
+	for (const float Value : Values)
+	{
+		JsonValues.Add(MakeShared<FJsonValueNumber>(Value));
+	}
+	return JsonValues;
+}
+} // namespace
+
+int32 FOVRLipSyncGolden::Record(const TArray<FString> &Paths, const FString &Directory, bool bUseOfflineModel,
+								TArray<FString> &OutFailures)
+{
+	IAssetRegistry &AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.ScanPathsSynchronous(Paths, true);
+	FARFilter Filter;
+	Filter.ClassPaths.Add(USoundWave::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	Filter.bRecursivePaths = true;
+	for (const FString &Path : Paths)
+	{
+		Filter.PackagePaths.Add(*Path);
+	}
+	TArray<FAssetData> SoundWaves;
+	AssetRegistry.GetAssets(Filter, SoundWaves);
+
+	const FString ModelPath = FOVRLipSyncSequenceGenerator::GetModelPath(bUseOfflineModel);
+	const std::atomic<bool> bCancelled{false};
+	int32 NumRecorded = 0;
+	for (int32 Index = 0; Index < SoundWaves.Num(); ++Index)
+	{
+		FOVRLipSyncGeneratorJob Job;
+		FOVRLipSyncGoldenTrack Track;
+		Track.Name = SoundWaves[Index].GetObjectPathString();
+		FString Error;
+		if (!FOVRLipSyncSequenceGenerator::Prepare(SoundWaves[Index], bUseOfflineModel, Job, Error) ||
+			!FOVRLipSyncSequenceGenerator::GenerateCached(Job, ModelPath, bCancelled, Track.Frames, Error))
+		{
+			OutFailures.Add(FString::Printf(TEXT("%s: %s"), *Track.Name, *Error));
+			continue;
+		}
+
+		// /Game/VO/Line becomes Game_VO_Line
+		const FString FileName =
+			SoundWaves[Index].PackageName.ToString().RightChop(1).Replace(TEXT("/"), TEXT("_")) + TrackExtension;
+		if (!SaveTrack(Track, FPaths::Combine(Directory, FileName)))
+		{
+			OutFailures.Add(FString::Printf(TEXT("%s: can't write %s"), *Track.Name, *FileName));
+			continue;
+		}
+		++NumRecorded;
+
+		if ((Index + 1) % RecordBatchSize == 0)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+	}
+	return NumRecorded;
+}
+
+TArray<FOVRLipSyncGoldenTrack> FOVRLipSyncGolden::LoadTracks(const FString &Directory)
+{
+	TArray<FString> FileNames;
+	IFileManager::Get().FindFiles(FileNames, *FPaths::Combine(Directory, FString(TEXT("*")) + TrackExtension), true,
+								  false);
+	FileNames.Sort();
+
+	TArray<FOVRLipSyncGoldenTrack> Tracks;
+	for (const FString &FileName : FileNames)
+	{
+		FOVRLipSyncGoldenTrack Track;
+		if (LoadTrack(FPaths::Combine(Directory, FileName), Track))
+		{
+			Tracks.Add(MoveTemp(Track));
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("OVRLipSyncGolden: %s is not a valid track"), *FileName);
+		}
+	}
+	return Tracks;
+}
+
+TArray<FOVRLipSyncGoldenResult> FOVRLipSyncGolden::Compare(const TArray<FOVRLipSyncGoldenTrack> &Tracks,
+														   const TArray<FName> &Candidates, float MaxTolerance,
+														   float MeanTolerance)
+{
+	const TMap<FName, FOVRLipSyncVisemePostProcess::FImplementation> Registered =
+		FOVRLipSyncVisemePostProcess::GetCandidates();
+	TArray<FName> Names = Candidates;
+	if (Names.Num() == 0)
+	{
+		Registered.GetKeys(Names);
+	}
+
+	TArray<FOVRLipSyncGoldenResult> Results;
+	for (const FOVRLipSyncGoldenTrack &Track : Tracks)
+	{
+		for (const FSettingsVariant &Variant : GetSettingsVariants())
+		{
+			// Every implementation modifies the raw frames in place, each gets its own copy
+			TArray<TArray<float>> RawVisemes;
+			TArray<float> LaughterScores;
+			SplitFrames(Track.Frames, RawVisemes, LaughterScores);
+			TArray<FOVRLipSyncFrame> Reference;
+			FOVRLipSyncReferencePostProcess::Apply(RawVisemes, LaughterScores, Variant.Settings, Reference);
+
+			for (const FName Name : Names)
+			{
+				FOVRLipSyncGoldenResult &Result = Results.AddDefaulted_GetRef();
+				Result.Track = Track.Name;
+				Result.Candidate = Name;
+				Result.Variant = Variant.Name;
+
+				const FOVRLipSyncVisemePostProcess::FImplementation *Implementation = Registered.Find(Name);
+				if (!Implementation)
+				{
+					UE_LOG(LogTemp, Error, TEXT("OVRLipSyncGolden: no candidate named %s"), *Name.ToString());
+					continue;
+				}
+				RawVisemes.Reset();
+				LaughterScores.Reset();
+				SplitFrames(Track.Frames, RawVisemes, LaughterScores);
+				UOVRLipSyncFrameSequence *Sequence = NewObject<UOVRLipSyncFrameSequence>(GetTransientPackage());
+				(*Implementation)(RawVisemes, LaughterScores, Variant.Settings, *Sequence);
+				Measure(Reference, Sequence->FrameSequence, MaxTolerance, MeanTolerance, Result);
+			}
+		}
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+	return Results;
+}
+
+bool FOVRLipSyncGolden::WriteJson(const TArray<FOVRLipSyncGoldenResult> &Results, const FString &FilePath)
+{
+	int32 NumFailed = 0;
+	TArray<TSharedPtr<FJsonValue>> ResultValues;
+	for (const FOVRLipSyncGoldenResult &Result : Results)
+	{
+		NumFailed += Result.bPassed ? 0 : 1;
+		TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+		Object->SetStringField(TEXT("track"), Result.Track);
+		Object->SetStringField(TEXT("candidate"), Result.Candidate.ToString());
+		Object->SetStringField(TEXT("variant"), Result.Variant);
+		Object->SetNumberField(TEXT("frames"), Result.NumFrames);
+		Object->SetNumberField(TEXT("candidateFrames"), Result.NumCandidateFrames);
+		Object->SetBoolField(TEXT("passed"), Result.bPassed);
+		Object->SetArrayField(TEXT("maxDifference"), ToJsonArray(Result.MaxDifference));
+		Object->SetArrayField(TEXT("meanDifference"), ToJsonArray(Result.MeanDifference));
+		ResultValues.Add(MakeShared<FJsonValueObject>(Object));
+	}
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetNumberField(TEXT("comparisons"), Results.Num());
+	Report->SetNumberField(TEXT("failed"), NumFailed);
+	Report->SetArrayField(TEXT("results"), ResultValues);
+	FString Json;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(Report, Writer);
+	return FFileHelper::SaveStringToFile(Json, *FilePath);
+}
+
+FString FOVRLipSyncGolden::GetDefaultTrackDirectory()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("OVRLipSync"), TEXT("Golden"));
+}
+
+bool FOVRLipSyncGolden::SaveTrack(const FOVRLipSyncGoldenTrack &Track, const FString &FilePath)
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	uint32 Magic = TrackMagic;
+	int32 Version = TrackVersion;
+	int32 NumFrames = Track.Frames.Num();
+	// Archive operators aren't const, the writer only reads the track
+	FOVRLipSyncGoldenTrack &MutableTrack = const_cast<FOVRLipSyncGoldenTrack &>(Track);
+	Writer << Magic << Version << MutableTrack.Name << NumFrames;
+	for (FOVRLipSyncFrame &Frame : MutableTrack.Frames)
+	{
+		Writer << Frame.VisemeScores << Frame.LaughterScore;
+	}
+	return FFileHelper::SaveArrayToFile(Bytes, *FilePath);
+}
+
+bool FOVRLipSyncGolden::LoadTrack(const FString &FilePath, FOVRLipSyncGoldenTrack &OutTrack)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+	{
+		return false;
+	}
+	FMemoryReader Reader(Bytes);
+	uint32 Magic = 0;
+	int32 Version = 0;
+	int32 NumFrames = 0;
+	Reader << Magic << Version;
+	if (Magic != TrackMagic || Version != TrackVersion)
+	{
+		return false;
+	}
+	Reader << OutTrack.Name << NumFrames;
+	if (Reader.IsError() || NumFrames < 0)
+	{
+		return false;
+	}
+	OutTrack.Frames.SetNum(NumFrames);
+	for (FOVRLipSyncFrame &Frame : OutTrack.Frames)
+	{
+		Reader << Frame.VisemeScores << Frame.LaughterScore;
+	}
+	return !Reader.IsError();
+}
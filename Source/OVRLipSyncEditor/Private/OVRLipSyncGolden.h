@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncGolden.h
+ * Content     :   Golden output comparison of viseme post-processing implementations
+ ******************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OVRLipSyncFrame.h"
+
+/**
+ * Raw inference frames of one sound wave, recorded once so every implementation is fed exactly the same input.
+ */
+struct FOVRLipSyncGoldenTrack
+{
+	FString Name;
+	TArray<FOVRLipSyncFrame> Frames;
+};
+
+/**
+ * Difference between the frames of a candidate and of the reference for one track and one variant of the
+ * interpolation settings.
+ */
+struct FOVRLipSyncGoldenResult
+{
+	FString Track;
+	FName Candidate;
+	FString Variant;
+	int32 NumFrames = 0;
+	int32 NumCandidateFrames = 0;
+	// Absolute differences of each viseme, followed by the laughter score
+	TArray<float> MaxDifference;
+	TArray<float> MeanDifference;
+	bool bPassed = false;
+};
+
+/**
+ * Records raw viseme tracks and runs them through FOVRLipSyncReferencePostProcess and the candidates registered with
+ * FOVRLipSyncVisemePostProcess, shared by the OVRLipSyncGolden commandlet.
+ */
+class FOVRLipSyncGolden
+{
+public:
+	static constexpr const TCHAR *TrackExtension = TEXT(".lipsyncraw");
+
+	/**
+	 * Run inference on every sound wave under Paths and write its raw frames to Directory, one file per wave.
+	 *
+	 * @param OutFailures Sound waves that couldn't be recorded, with the reason.
+	 * @return Number of tracks written.
+	 */
+	static int32 Record(const TArray<FString> &Paths, const FString &Directory, bool bUseOfflineModel,
+						TArray<FString> &OutFailures);
+
+	static TArray<FOVRLipSyncGoldenTrack> LoadTracks(const FString &Directory);
+
+	/**
+	 * Post-process every track with the reference and with each candidate, once per settings variant.
+	 *
+	 * @param Candidates Names registered with FOVRLipSyncVisemePostProcess, every registered one when empty.
+	 * @param MaxTolerance Largest difference of any score allowed.
+	 * @param MeanTolerance Largest mean difference of a viseme or of laughter allowed.
+	 */
+	static TArray<FOVRLipSyncGoldenResult> Compare(const TArray<FOVRLipSyncGoldenTrack> &Tracks,
+												   const TArray<FName> &Candidates, float MaxTolerance,
+												   float MeanTolerance);
+
+	static bool WriteJson(const TArray<FOVRLipSyncGoldenResult> &Results, const FString &FilePath);
+
+	// Saved/OVRLipSync/Golden
+	static FString GetDefaultTrackDirectory();
+
+private:
+	static bool SaveTrack(const FOVRLipSyncGoldenTrack &Track, const FString &FilePath);
+	static bool LoadTrack(const FString &FilePath, FOVRLipSyncGoldenTrack &OutTrack);
+};
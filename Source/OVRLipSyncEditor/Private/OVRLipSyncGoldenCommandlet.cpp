@@ -0,0 +1,95 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncGoldenCommandlet.cpp
+ * Content     :   Golden output regression check of viseme post-processing implementations
+ ******************************************************************************/
+
+#include "OVRLipSyncGoldenCommandlet.h"
+
+#include "Misc/Paths.h"
+#include "OVRLipSyncEditorSettings.h"
+#include "OVRLipSyncGolden.h"
+
+UOVRLipSyncGoldenCommandlet::UOVRLipSyncGoldenCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UOVRLipSyncGoldenCommandlet::Main(const FString &Params)
+{
+	FString TrackDirectory = FOVRLipSyncGolden::GetDefaultTrackDirectory();
+	FParse::Value(*Params, TEXT("Tracks="), TrackDirectory);
+
+	if (FParse::Param(*Params, TEXT("Record")))
+	{
+		FString PathList = TEXT("/Game");
+		FParse::Value(*Params, TEXT("Paths="), PathList, false);
+		TArray<FString> Paths;
+		PathList.ParseIntoArray(Paths, TEXT("+"));
+
+		TArray<FString> Failures;
+		const int32 NumRecorded =
+			FOVRLipSyncGolden::Record(Paths, TrackDirectory, FParse::Param(*Params, TEXT("OfflineModel")), Failures);
+		for (const FString &Failure : Failures)
+		{
+			UE_LOG(LogTemp, Error, TEXT("OVRLipSyncGolden: %s"), *Failure);
+		}
+		UE_LOG(LogTemp, Display, TEXT("OVRLipSyncGolden: %d tracks recorded to %s, %d failed"), NumRecorded,
+			   *TrackDirectory, Failures.Num());
+		return Failures.Num() > 0 ? 1 : 0;
+	}
+
+	const UOVRLipSyncEditorSettings *Settings = GetDefault<UOVRLipSyncEditorSettings>();
+	float MaxTolerance = Settings->GoldenMaxTolerance;
+	FParse::Value(*Params, TEXT("MaxTolerance="), MaxTolerance);
+	float MeanTolerance = Settings->GoldenMeanTolerance;
+	FParse::Value(*Params, TEXT("MeanTolerance="), MeanTolerance);
+	FString CandidateList;
+	FParse::Value(*Params, TEXT("Candidates="), CandidateList, false);
+	TArray<FString> CandidateNames;
+	CandidateList.ParseIntoArray(CandidateNames, TEXT("+"));
+	TArray<FName> Candidates;
+	for (const FString &Name : CandidateNames)
+	{
+		Candidates.Add(FName(*Name));
+	}
+	FString ReportPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("OVRLipSync"),
+										 FString::Printf(TEXT("Golden-%s.json"), *FDateTime::Now().ToString()));
+	FParse::Value(*Params, TEXT("Report="), ReportPath);
+
+	const TArray<FOVRLipSyncGoldenTrack> Tracks = FOVRLipSyncGolden::LoadTracks(TrackDirectory);
+	if (Tracks.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("OVRLipSyncGolden: no tracks in %s, record them with -Record first"),
+			   *TrackDirectory);
+		return 1;
+	}
+
+	const TArray<FOVRLipSyncGoldenResult> Results =
+		FOVRLipSyncGolden::Compare(Tracks, Candidates, MaxTolerance, MeanTolerance);
+	int32 NumFailed = 0;
+	for (const FOVRLipSyncGoldenResult &Result : Results)
+	{
+		if (Result.bPassed)
+		{
+			continue;
+		}
+		++NumFailed;
+		const float WorstMax = Result.MaxDifference.Num() > 0 ? FMath::Max(Result.MaxDifference) : 0.0f;
+		const float WorstMean = Result.MeanDifference.Num() > 0 ? FMath::Max(Result.MeanDifference) : 0.0f;
+		UE_LOG(LogTemp, Warning, TEXT("OVRLipSyncGolden: %s failed %s (%s): %d of %d frames, max %g, mean %g"),
+			   *Result.Candidate.ToString(), *Result.Track, *Result.Variant, Result.NumCandidateFrames,
+			   Result.NumFrames, WorstMax, WorstMean);
+	}
+
+	if (!FOVRLipSyncGolden::WriteJson(Results, ReportPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("OVRLipSyncGolden: failed to write %s"), *ReportPath);
+		return 1;
+	}
+	UE_LOG(LogTemp, Display, TEXT("OVRLipSyncGolden: %d tracks, %d comparisons, %d failed, written to %s"),
+		   Tracks.Num(), Results.Num(), NumFailed, *ReportPath);
+	return NumFailed > 0 ? 1 : 0;
+}
@@ -0,0 +1,32 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncGoldenCommandlet.h
+ * Content     :   Golden output regression check of viseme post-processing implementations
+ ******************************************************************************/
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "CoreMinimal.h"
+#include "OVRLipSyncGoldenCommandlet.generated.h"
+
+/**
+ * Records the raw inference frames of the sound waves under the given paths, or checks every post-processing
+ * candidate registered with FOVRLipSyncVisemePostProcess against the frozen reference on the recorded tracks.
+ *
+ * UnrealEditor-Cmd.exe Project.uproject -run=OVRLipSyncGolden -Record [-Paths=/Game/VO] [-Tracks=Dir] [-OfflineModel]
+ * UnrealEditor-Cmd.exe Project.uproject -run=OVRLipSyncGolden [-Tracks=Dir] [-Candidates=Default+Vectorized]
+ *     [-MaxTolerance=0.0001] [-MeanTolerance=0.00001] [-Report=Path.json]
+ *
+ * Tracks default to Saved/OVRLipSync/Golden, tolerances to the Golden Tests project settings. Returns 1 when a track
+ * can't be recorded, when there are no tracks to compare or when any candidate is outside the tolerances.
+ */
+UCLASS()
+class UOVRLipSyncGoldenCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UOVRLipSyncGoldenCommandlet();
+
+	virtual int32 Main(const FString &Params) override;
+};
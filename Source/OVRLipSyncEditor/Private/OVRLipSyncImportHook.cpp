@@ -0,0 +1,82 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncImportHook.cpp
+ * Content     :   Generates LipSync sequences for imported and reimported sound waves
+ ******************************************************************************/
+
+#include "OVRLipSyncImportHook.h"
+
+#include "Editor.h"
+#include "EditorReimportHandler.h"
+#include "OVRLipSyncBatchCooker.h"
+#include "OVRLipSyncEditorSettings.h"
+#include "Sound/SoundWave.h"
+#include "Sound/SoundWaveProcedural.h"
+#include "Subsystems/ImportSubsystem.h"
+
+void FOVRLipSyncImportHook::Register()
+{
+	if (GEditor)
+	{
+		if (UImportSubsystem *ImportSubsystem = GEditor->GetEditorSubsystem<UImportSubsystem>())
+		{
+			PostImportHandle =
+				ImportSubsystem->OnAssetPostImport.AddRaw(this, &FOVRLipSyncImportHook::OnAssetPostImport);
+		}
+	}
+	PostReimportHandle =
+		FReimportManager::Instance()->OnPostReimport().AddRaw(this, &FOVRLipSyncImportHook::OnPostReimport);
+}
+
+void FOVRLipSyncImportHook::Unregister()
+{
+	if (GEditor)
+	{
+		if (UImportSubsystem *ImportSubsystem = GEditor->GetEditorSubsystem<UImportSubsystem>())
+		{
+			ImportSubsystem->OnAssetPostImport.Remove(PostImportHandle);
+		}
+	}
+	FReimportManager::Instance()->OnPostReimport().Remove(PostReimportHandle);
+	FTSTicker::GetCoreTicker().RemoveTicker(FlushHandle);
+	FlushHandle.Reset();
+	PendingAssets.Reset();
+}
+
+void FOVRLipSyncImportHook::OnAssetPostImport(UFactory *Factory, UObject *Object)
+{
+	Enqueue(Object);
+}
+
+void FOVRLipSyncImportHook::OnPostReimport(UObject *Object, bool bSuccess)
+{
+	if (bSuccess)
+	{
+		Enqueue(Object);
+	}
+}
+
+void FOVRLipSyncImportHook::Enqueue(UObject *Object)
+{
+	USoundWave *SoundWave = Cast<USoundWave>(Object);
+	if (!SoundWave || SoundWave->IsA<USoundWaveProcedural>() ||
+		!GetDefault<UOVRLipSyncEditorSettings>()->bGenerateOnImport)
+	{
+		return;
+	}
+
+	// A reimport also reports a post import, the asset is only queued once
+	PendingAssets.AddUnique(FAssetData(SoundWave));
+	if (!FlushHandle.IsValid())
+	{
+		FlushHandle =
+			FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FOVRLipSyncImportHook::Flush));
+	}
+}
+
+bool FOVRLipSyncImportHook::Flush(float DeltaTime)
+{
+	FOVRLipSyncBatchCooker::Start(PendingAssets, GetDefault<UOVRLipSyncEditorSettings>()->bUseOfflineModel);
+	PendingAssets.Reset();
+	FlushHandle.Reset();
+	return false;
+}
@@ -0,0 +1,34 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncImportHook.h
+ * Content     :   Generates LipSync sequences for imported and reimported sound waves
+ ******************************************************************************/
+
+#pragma once
+
+#include "AssetRegistry/AssetData.h"
+#include "Containers/Ticker.h"
+#include "CoreMinimal.h"
+
+class UFactory;
+
+/**
+ * Watches imports and reimports and, when enabled in the project settings, hands new or changed sound waves to
+ * FOVRLipSyncBatchCooker. Waves imported in the same frame are generated as one batch.
+ */
+class FOVRLipSyncImportHook
+{
+public:
+	void Register();
+	void Unregister();
+
+private:
+	void OnAssetPostImport(UFactory *Factory, UObject *Object);
+	void OnPostReimport(UObject *Object, bool bSuccess);
+	void Enqueue(UObject *Object);
+	bool Flush(float DeltaTime);
+
+	TArray<FAssetData> PendingAssets;
+	FDelegateHandle PostImportHandle;
+	FDelegateHandle PostReimportHandle;
+	FTSTicker::FDelegateHandle FlushHandle;
+};
@@ -0,0 +1,300 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncSequenceGenerator.cpp
+ * Content     :   Generates LipSync sequence assets from sound waves
+ ******************************************************************************/
+
+#include "OVRLipSyncSequenceGenerator.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "DerivedDataCacheInterface.h"
+#include "FileHelpers.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "OVRLipSyncContextWrapper.h"
+#include "OVRLipSyncFileBuffer.h"
+#include "OVRLipSyncEditorSettings.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Sound/SoundWave.h"
+
+namespace
+{
+
+// Compute LipSync sequence frames at 100 times a second rate
+constexpr auto LipSyncSequenceUpateFrequency = 100;
+constexpr auto LipSyncSequenceDuration = 1.0f / LipSyncSequenceUpateFrequency;
+
+// Change to invalidate every cached sequence, e.g. when the layout of the cached data changes
+constexpr const TCHAR *DerivedDataVersion = TEXT("5B2D7C4E1A9F4B7E8C3D6A0F2E1B9C47");
+
+FString GetDerivedDataKey(const FString &SourceHash)
+{
+	int Major = 0, Minor = 0, Patch = 0;
+	ovrLipSync_GetVersion(&Major, &Minor, &Patch);
+	const FString Suffix = FString::Printf(TEXT("%s_%d_%d_%d"), *SourceHash, Major, Minor, Patch);
+	return FDerivedDataCacheInterface::BuildCacheKey(TEXT("OVRLIPSYNC"), DerivedDataVersion, *Suffix);
+}
+
+void SerializeFrames(FArchive &Ar, TArray<FOVRLipSyncFrame> &Frames)
+{
+	int32 NumFrames = Frames.Num();
+	Ar << NumFrames;
+	if (Ar.IsLoading())
+	{
+		if (NumFrames < 0)
+		{
+			Ar.SetError();
+			return;
+		}
+		Frames.SetNum(NumFrames);
+	}
+	for (FOVRLipSyncFrame &Frame : Frames)
+	{
+		Ar << Frame.VisemeScores << Frame.LaughterScore;
+	}
+}
+
+} // namespace
+
+FString FOVRLipSyncSequenceGenerator::GetModelPath(bool bUseOfflineModel)
+{
+	return bUseOfflineModel ? FPaths::Combine(FPaths::ProjectPluginsDir(), TEXT("OVRLipSync"), TEXT("OfflineModel"),
+											  TEXT("ovrlipsync_offline_model.pb"))
+							: FString();
+}
+
+FString FOVRLipSyncSequenceGenerator::ComputeSourceHash(USoundWave *SoundWave, bool bUseOfflineModel)
+{
+	// The payload id is a hash of the imported audio, reading it doesn't load the payload
+	const FString AudioHash = SoundWave->RawData.HasPayloadData() ? LexToString(SoundWave->RawData.GetPayloadId())
+																 : SoundWave->CompressedDataGuid.ToString();
+	const FString Key = FString::Printf(TEXT("%s|%d|%d|%d"), *AudioHash, bUseOfflineModel ? 1 : 0,
+										 LipSyncSequenceUpateFrequency, GeneratorVersion);
+	return FMD5::HashAnsiString(*Key);
+}
+
+FString FOVRLipSyncSequenceGenerator::ComputeSourcePackageHash(const FAssetData &SoundWaveAsset, bool bUseOfflineModel)
+{
+	const TOptional<FAssetPackageData> PackageData =
+		IAssetRegistry::GetChecked().GetAssetPackageDataCopy(SoundWaveAsset.PackageName);
+	if (!PackageData.IsSet() || PackageData->GetPackageSavedHash().IsZero())
+	{
+		return FString();
+	}
+	const FString Key = FString::Printf(TEXT("%s|%d|%d|%d"), *LexToString(PackageData->GetPackageSavedHash()),
+										 bUseOfflineModel ? 1 : 0, LipSyncSequenceUpateFrequency, GeneratorVersion);
+	return FMD5::HashAnsiString(*Key);
+}
+
+FString FOVRLipSyncSequenceGenerator::GetSequencePackageName(const FAssetData &SoundWaveAsset)
+{
+	return FString::Printf(TEXT("%s_LipSyncSequence"), *SoundWaveAsset.PackageName.ToString());
+}
+
+FString FOVRLipSyncSequenceGenerator::GetSequenceObjectPath(const FAssetData &SoundWaveAsset)
+{
+	return FString::Printf(TEXT("%s.%s_LipSyncSequence"), *GetSequencePackageName(SoundWaveAsset),
+						   *SoundWaveAsset.AssetName.ToString());
+}
+
+bool FOVRLipSyncSequenceGenerator::Prepare(const FAssetData &SoundWaveAsset, bool bUseOfflineModel,
+										   FOVRLipSyncGeneratorJob &OutJob, FString &OutError)
+{
+	USoundWave *SoundWave = Cast<USoundWave>(SoundWaveAsset.GetAsset());
+	if (!SoundWave)
+	{
+		OutError = FString::Printf(TEXT("can't load %s"), *SoundWaveAsset.GetObjectPathString());
+		return false;
+	}
+
+	OutJob.Asset = SoundWaveAsset;
+	OutJob.SourceHash = ComputeSourceHash(SoundWave, bUseOfflineModel);
+	OutJob.SourcePackageHash = ComputeSourcePackageHash(SoundWaveAsset, bUseOfflineModel);
+
+	// Imported audio is read from the editor bulk data, which is safe from any thread and leaves the wave alone
+	if (SoundWave->RawData.HasPayloadData())
+	{
+		OutJob.Payload = SoundWave->RawData.GetPayload();
+		return true;
+	}
+	OutJob.Decoder = IOVRLipSyncAudioDecoder::CreateForSoundWave(SoundWave, &OutError);
+	return OutJob.Decoder.IsValid();
+}
+
+bool FOVRLipSyncSequenceGenerator::Decode(FOVRLipSyncGeneratorJob &Job, TArray<int16> &OutPCM, int32 &OutNumChannels,
+										  int32 &OutSampleRate, FString &OutError)
+{
+	if (!Job.Decoder)
+	{
+		const FSharedBuffer Payload = Job.Payload.Get();
+		if (Payload.GetSize() == 0)
+		{
+			OutError = TEXT("sound wave has no imported audio");
+			return false;
+		}
+		TArray<uint8> Bytes(static_cast<const uint8 *>(Payload.GetData()), static_cast<int32>(Payload.GetSize()));
+		Job.Decoder = IOVRLipSyncAudioDecoder::Create(FOVRLipSyncFileBuffer::FromArray(MoveTemp(Bytes)), &OutError);
+		if (!Job.Decoder)
+		{
+			return false;
+		}
+	}
+
+	// Wider layouts are downmixed to stereo by the decoder
+	IOVRLipSyncAudioDecoder &Decoder = *Job.Decoder;
+	OutNumChannels = Decoder.GetNumChannels();
+	OutSampleRate = Decoder.GetSampleRate();
+	if (Decoder.GetNumFrames() != INDEX_NONE)
+	{
+		OutPCM.Reserve(Decoder.GetNumFrames() * OutNumChannels);
+	}
+
+	constexpr int32 BlockFrames = 4096;
+	int32 DecodedFrames = BlockFrames;
+	while (DecodedFrames == BlockFrames)
+	{
+		const int32 Offset = OutPCM.Num();
+		OutPCM.AddUninitialized(BlockFrames * OutNumChannels);
+		DecodedFrames = Decoder.Decode(OutPCM.GetData() + Offset, BlockFrames);
+		if (DecodedFrames == INDEX_NONE)
+		{
+			OutError = TEXT("audio data is corrupt");
+			return false;
+		}
+		OutPCM.SetNum(Offset + DecodedFrames * OutNumChannels, false);
+	}
+	Job.Decoder.Reset();
+	return true;
+}
+
+bool FOVRLipSyncSequenceGenerator::Generate(FOVRLipSyncGeneratorJob &Job, const FString &ModelPath,
+											const std::atomic<bool> &bCancelled, TArray<FOVRLipSyncFrame> &OutFrames,
+											FString &OutError)
+{
+	TArray<int16> PCM;
+	int32 NumChannels = 0;
+	int32 SampleRate = 0;
+	if (!Decode(Job, PCM, NumChannels, SampleRate, OutError))
+	{
+		return false;
+	}
+	const int64 PCMDataSize = PCM.Num();
+	const int16_t *PCMData = PCM.GetData();
+
+	auto ChunkSizeSamples = static_cast<int>(SampleRate * LipSyncSequenceDuration);
+	auto ChunkSize = NumChannels * ChunkSizeSamples;
+
+	UOVRLipSyncContextWrapper context(ovrLipSyncContextProvider_Enhanced, SampleRate, 4096, ModelPath);
+
+	float LaughterScore = 0.0f;
+	int32_t FrameDelayInMs = 0;
+	TArray<float> Visemes;
+
+	TArray<int16_t> samples;
+	samples.SetNumZeroed(ChunkSize);
+	context.ProcessFrame(samples.GetData(), ChunkSizeSamples, Visemes, LaughterScore, FrameDelayInMs, NumChannels > 1);
+
+	const int64 FrameOffset = static_cast<int64>(FrameDelayInMs) * SampleRate / 1000 * NumChannels;
+
+	for (int64 offs = 0; offs < PCMDataSize + FrameOffset; offs += ChunkSize)
+	{
+		if (bCancelled)
+		{
+			OutError = TEXT("cancelled");
+			return false;
+		}
+
+		const int64 remainingSamples = PCMDataSize - offs;
+		if (remainingSamples >= ChunkSize)
+		{
+			context.ProcessFrame(PCMData + offs, ChunkSizeSamples, Visemes, LaughterScore, FrameDelayInMs,
+								 NumChannels > 1);
+		}
+		else
+		{
+			if (remainingSamples > 0)
+			{
+				memcpy(samples.GetData(), PCMData + offs, sizeof(int16_t) * remainingSamples);
+				memset(samples.GetData() + remainingSamples, 0, sizeof(int16_t) * (ChunkSize - remainingSamples));
+			}
+			else
+			{
+				memset(samples.GetData(), 0, sizeof(int16_t) * ChunkSize);
+			}
+			context.ProcessFrame(samples.GetData(), ChunkSizeSamples, Visemes, LaughterScore, FrameDelayInMs,
+								 NumChannels > 1);
+		}
+
+		if (offs >= FrameOffset)
+		{
+			OutFrames.Emplace(Visemes, LaughterScore);
+		}
+	}
+	return true;
+}
+
+bool FOVRLipSyncSequenceGenerator::GenerateCached(FOVRLipSyncGeneratorJob &Job, const FString &ModelPath,
+												  const std::atomic<bool> &bCancelled,
+												  TArray<FOVRLipSyncFrame> &OutFrames, FString &OutError)
+{
+	if (!GetDefault<UOVRLipSyncEditorSettings>()->bUseDerivedDataCache)
+	{
+		return Generate(Job, ModelPath, bCancelled, OutFrames, OutError);
+	}
+
+	const FString Key = GetDerivedDataKey(Job.SourceHash);
+	const FString DebugContext = Job.Asset.GetObjectPathString();
+	TArray<uint8> Data;
+	if (GetDerivedDataCacheRef().GetSynchronous(*Key, Data, DebugContext))
+	{
+		FMemoryReader Reader(Data);
+		SerializeFrames(Reader, OutFrames);
+		if (!Reader.IsError())
+		{
+			return true;
+		}
+		OutFrames.Reset();
+	}
+
+	if (!Generate(Job, ModelPath, bCancelled, OutFrames, OutError))
+	{
+		return false;
+	}
+
+	Data.Reset();
+	FMemoryWriter Writer(Data);
+	SerializeFrames(Writer, OutFrames);
+	GetDerivedDataCacheRef().Put(*Key, Data, DebugContext);
+	return true;
+}
+
+UOVRLipSyncFrameSequence *FOVRLipSyncSequenceGenerator::CreateSequence(const FAssetData &SoundWaveAsset,
+																	   TArray<FOVRLipSyncFrame> &&Frames,
+																	   const FString &SourceHash,
+																	   const FString &SourcePackageHash)
+{
+	auto SequenceName = FString::Printf(TEXT("%s_LipSyncSequence"), *SoundWaveAsset.AssetName.ToString());
+	auto SequencePackage = CreatePackage(*GetSequencePackageName(SoundWaveAsset));
+	auto Sequence = NewObject<UOVRLipSyncFrameSequence>(SequencePackage, *SequenceName, RF_Public | RF_Standalone);
+	Sequence->FrameSequence = MoveTemp(Frames);
+	Sequence->SourceHash = SourceHash;
+	Sequence->SourcePackageHash = SourcePackageHash;
+	return Sequence;
+}
+
+bool FOVRLipSyncSequenceGenerator::SaveSequences(const TArray<UOVRLipSyncFrameSequence *> &Sequences)
+{
+	if (Sequences.Num() == 0)
+	{
+		return true;
+	}
+
+	TArray<UPackage *> Packages;
+	for (UOVRLipSyncFrameSequence *Sequence : Sequences)
+	{
+		FAssetRegistryModule::AssetCreated(Sequence);
+		Sequence->MarkPackageDirty();
+		Packages.Add(Sequence->GetOutermost());
+	}
+	return UEditorLoadingAndSavingUtils::SavePackages(Packages, true);
+}
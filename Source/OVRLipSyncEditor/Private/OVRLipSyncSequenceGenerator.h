@@ -0,0 +1,97 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncSequenceGenerator.h
+ * Content     :   Generates LipSync sequence assets from sound waves
+ ******************************************************************************/
+
+#pragma once
+
+#include "AssetRegistry/AssetData.h"
+#include "Async/Future.h"
+#include "CoreMinimal.h"
+#include "Memory/SharedBuffer.h"
+#include "OVRLipSyncAudioDecoder.h"
+#include "OVRLipSyncFrame.h"
+
+#include <atomic>
+
+class USoundWave;
+
+/**
+ * Audio of one sound wave, gathered on the game thread and decoded by Generate on any thread.
+ */
+struct FOVRLipSyncGeneratorJob
+{
+	FAssetData Asset;
+	// Imported source file of the wave, when the editor still has it
+	TFuture<FSharedBuffer> Payload;
+	// Decoder for the compressed platform data otherwise
+	TUniquePtr<IOVRLipSyncAudioDecoder> Decoder;
+	// Stored on the generated sequence to tell when it is out of date
+	FString SourceHash;
+	FString SourcePackageHash;
+};
+
+/**
+ * Steps shared by everything that generates sequence assets in the editor: the content browser action, the cook
+ * commandlet and the import hook.
+ */
+class FOVRLipSyncSequenceGenerator
+{
+public:
+	// Bumped whenever a change to generation alters the frames it produces
+	static constexpr int32 GeneratorVersion = 1;
+
+	static FString GetModelPath(bool bUseOfflineModel);
+
+	// Hash of the imported audio and of every setting that affects the generated frames
+	static FString ComputeSourceHash(USoundWave *SoundWave, bool bUseOfflineModel);
+
+	/**
+	 * Hash of the saved package of a sound wave and of the same settings, read from the asset registry so the wave
+	 * isn't loaded. Resaving the wave changes it even when its audio is unchanged. Empty when the registry has no
+	 * data for the package.
+	 */
+	static FString ComputeSourcePackageHash(const FAssetData &SoundWaveAsset, bool bUseOfflineModel);
+
+	// Package the sequence generated for SoundWaveAsset is saved to
+	static FString GetSequencePackageName(const FAssetData &SoundWaveAsset);
+	static FString GetSequenceObjectPath(const FAssetData &SoundWaveAsset);
+
+	/**
+	 * Load the sound wave and request its audio. Game thread only, neither the wave nor the audio device are
+	 * modified.
+	 */
+	static bool Prepare(const FAssetData &SoundWaveAsset, bool bUseOfflineModel, FOVRLipSyncGeneratorJob &OutJob,
+						FString &OutError);
+
+	/**
+	 * Decode the audio of a job and run inference over it, safe to call from any thread.
+	 *
+	 * @param Job Job filled by Prepare.
+	 * @param ModelPath Model passed to the context, empty for the default model.
+	 * @param bCancelled Checked once per frame.
+	 * @param OutFrames Receives the frames of the sequence.
+	 * @param OutError Why generation failed.
+	 */
+	static bool Generate(FOVRLipSyncGeneratorJob &Job, const FString &ModelPath, const std::atomic<bool> &bCancelled,
+						 TArray<FOVRLipSyncFrame> &OutFrames, FString &OutError);
+
+	/**
+	 * Same as Generate, but frames are first looked up in the Derived Data Cache, keyed by the job's source hash and
+	 * the SDK version, and stored there after a miss. Safe to call from any thread.
+	 */
+	static bool GenerateCached(FOVRLipSyncGeneratorJob &Job, const FString &ModelPath,
+							   const std::atomic<bool> &bCancelled, TArray<FOVRLipSyncFrame> &OutFrames,
+							   FString &OutError);
+
+	// Create (or replace) the sequence asset of a sound wave, game thread only
+	static UOVRLipSyncFrameSequence *CreateSequence(const FAssetData &SoundWaveAsset, TArray<FOVRLipSyncFrame> &&Frames,
+												   const FString &SourceHash, const FString &SourcePackageHash);
+
+	// Register new sequences with the asset registry and save their packages
+	static bool SaveSequences(const TArray<UOVRLipSyncFrameSequence *> &Sequences);
+
+private:
+	static bool Decode(FOVRLipSyncGeneratorJob &Job, TArray<int16> &OutPCM, int32 &OutNumChannels,
+					   int32 &OutSampleRate, FString &OutError);
+};
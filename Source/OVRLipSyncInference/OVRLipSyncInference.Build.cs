@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncInference.Build.cs
+ * Content     :   Unreal build script for OVRLipSyncInference
+ * Created     :   Aug 9th, 2018
+ * Copyright   :   Copyright Facebook Technologies, LLC and its affiliates.
+ *                 All rights reserved.
+ *
+ * Licensed under the Oculus Audio SDK License Version 3.3 (the "License");
+ * you may not use the Oculus Audio SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+
+ * You may obtain a copy of the License at
+ *
+ * https://developer.oculus.com/licenses/audio-3.3/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus Audio SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+
+ * Modified by :   Aida Drogan, SilverCord-VR
+ *
+ * Modifications:
+ * - Adapted the original Oculus OVRLipSync plugin for use with Unreal Engine 5.x.
+ * - Introduced dynamic interpolation based on phoneme durations.
+ * - Added a mechanism to adjust interpolation frames dynamically based on speech tempo.
+ * - Enhanced compatibility with modern Unreal Engine APIs (e.g., FPaths and Async threading).
+ * - Added SignalProcessing for decoding sound wave assets at runtime.
+ * - Added AudioMixerCore for resampling ahead of inference.
+ * - Split from OVRLipSync.Build.cs: the SDK, voice capture and audio decoding are only linked by this module.
+ ******************************************************************************/
+
+using System.IO;
+using UnrealBuildTool;
+
+public class OVRLipSyncInference : ModuleRules
+{
+    public OVRLipSyncInference(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PrivateDependencyModuleNames.AddRange(new string[] {"AndroidPermission", "AudioMixerCore", "SignalProcessing"});
+        PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        string BaseDirectory = Path.GetFullPath(Path.Combine(ModuleDirectory, "..", ".."));
+        string ThirdPartyDirectory = Path.Combine(BaseDirectory, "ThirdParty");
+        string PlatformString = Target.Platform.ToString();
+        string LibraryDirectory = Path.Combine(ThirdPartyDirectory, "Lib", PlatformString);
+        string TargetBinariesDirectory = Path.Combine(BaseDirectory, "Binaries", PlatformString);
+        PublicIncludePaths.Add(Path.Combine(ThirdPartyDirectory, "Include"));
+        PublicDependencyModuleNames.AddRange( new string[] { "Core", "CoreUObject", "Engine", "OVRLipSync", "Voice"});
+
+        if (Target.Platform == UnrealTargetPlatform.Win64)
+        {
+            PublicAdditionalLibraries.Add(Path.Combine(LibraryDirectory, "OVRLipSyncShim.lib"));
+            PublicDelayLoadDLLs.Add("OVRLipSync.dll");
+            RuntimeDependencies.Add(Path.Combine(LibraryDirectory, "OVRLipSync.dll"), StagedFileType.NonUFS);
+        }
+        else if (Target.Platform == UnrealTargetPlatform.Mac)
+        {
+            PublicAdditionalLibraries.Add(Path.Combine(LibraryDirectory, "libOVRLipSyncShim.a"));
+            RuntimeDependencies.Add(Path.Combine(LibraryDirectory, "libOVRLipSync.dylib"), StagedFileType.NonUFS);
+        }
+        else if (Target.Platform == UnrealTargetPlatform.Android)
+        {
+            string Android64Directory = Path.Combine(ThirdPartyDirectory, "Lib", "Android", "arm64-v8a");
+            string Android32Directory = Path.Combine(ThirdPartyDirectory, "Lib", "Android", "armeabi-v7a");
+            PublicSystemLibraryPaths.Add(LibraryDirectory);
+            PublicSystemLibraryPaths.Add(Android32Directory);
+            PublicSystemLibraryPaths.Add(Android64Directory);
+            AdditionalPropertiesForReceipt.Add("AndroidPlugin", Path.Combine(ModuleDirectory, "OVRLipSync_APL.xml"));
+            PublicAdditionalLibraries.Add(Path.Combine(Android32Directory, "libOVRLipSyncShim.a"));
+            PublicAdditionalLibraries.Add(Path.Combine(Android64Directory, "libOVRLipSyncShim.a"));
+        }
+
+    }
+}
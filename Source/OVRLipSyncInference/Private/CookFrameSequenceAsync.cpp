@@ -0,0 +1,243 @@
+/*******************************************************************************
+ * Modifications by Aida Drogan, SilverCord-VR:
+ * - Introduced interpolation for phoneme transitions using a weighted average over previous frames.
+ * - Added dynamic adjustment of interpolation strength based on speech tempo.
+ * - Updated function interface to include `FVisemeInterpolationSettings`.
+ * - Modified interpolation to preserve consonant clarity by applying scaling during smoothing.
+ * - Added filtering of short-duration phonemes below MinHoldFrames.
+ * - Added block-based viseme clustering using NumInterpolationFrames.
+ * - Added weighted priority for dominant viseme selection.
+ * - Locate PCM data by walking RIFF chunks instead of assuming a 44-byte header.
+ * - Added `CookFrameSequenceFromWaveFile` to cook from memory-mapped files without copying them.
+ * - Accept 8/24/32-bit integer, float and multichannel WAVs, converted to 16-bit mono or stereo per chunk.
+ * - Decode FLAC, Ogg Vorbis and engine Opus audio chunk by chunk on the cook thread, added `CookFrameSequenceFromFile`.
+ * - Added `CookFrameSequenceFromSoundWave` to cook imported sound waves at runtime.
+ * - Added optional downmix and resampling ahead of inference through `FOVRLipSyncPreprocessSettings`.
+ * - Moved viseme post-processing to `FOVRLipSyncVisemePostProcess`, added checkpointed
+ *   `CookFrameSequenceFromFileResumable` for multi-hour recordings.
+ * - Moved to the OVRLipSyncInference module with the rest of the code linking the SDK.
+ * - Stream WAV files larger than 2 GB through a file handle instead of mapping them.
+ *******************************************************************************/
+
+#include "CookFrameSequenceAsync.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/ScopedSlowTask.h"
+#include "OVRLipSyncAudioDecoder.h"
+#include "OVRLipSyncFileBuffer.h"
+#include "OVRLipSyncLongFormCook.h"
+#include "OVRLipSyncModule.h"
+#include "OVRLipSyncResamplingDecoder.h"
+#include "OVRLipSyncSoundWaveDecoder.h"
+#include "OVRLipSyncVisemePostProcess.h"
+
+constexpr auto LipSyncSequenceUpateFrequency = 100;
+
+UCookFrameSequenceAsync *UCookFrameSequenceAsync::CookFrameSequence(const TArray<uint8> &RawSamples,
+																	bool UseOfflineModel,
+																	const FVisemeInterpolationSettings &Settings,
+																	const FOVRLipSyncPreprocessSettings &Preprocess)
+{
+	UCookFrameSequenceAsync *BPNode = NewObject<UCookFrameSequenceAsync>();
+	BPNode->RawSamples = RawSamples;
+	BPNode->UseOfflineModel = UseOfflineModel;
+	BPNode->InterpolationSettings = Settings;
+	BPNode->PreprocessSettings = Preprocess;
+	return BPNode;
+}
+
+UCookFrameSequenceAsync *UCookFrameSequenceAsync::CookFrameSequenceFromWaveFile(
+	const FOVRLipSyncWaveHandle &WaveFile, bool UseOfflineModel, const FVisemeInterpolationSettings &Settings,
+	const FOVRLipSyncPreprocessSettings &Preprocess)
+{
+	UCookFrameSequenceAsync *BPNode = NewObject<UCookFrameSequenceAsync>();
+	BPNode->WaveFile = WaveFile;
+	BPNode->UseOfflineModel = UseOfflineModel;
+	BPNode->InterpolationSettings = Settings;
+	BPNode->PreprocessSettings = Preprocess;
+	return BPNode;
+}
+
+UCookFrameSequenceAsync *UCookFrameSequenceAsync::CookFrameSequenceFromFile(
+	const FString &FilePath, bool UseOfflineModel, const FVisemeInterpolationSettings &Settings,
+	const FOVRLipSyncPreprocessSettings &Preprocess)
+{
+	UCookFrameSequenceAsync *BPNode = NewObject<UCookFrameSequenceAsync>();
+	BPNode->SourceFilePath = FilePath;
+	BPNode->UseOfflineModel = UseOfflineModel;
+	BPNode->InterpolationSettings = Settings;
+	BPNode->PreprocessSettings = Preprocess;
+	return BPNode;
+}
+
+UCookFrameSequenceAsync *UCookFrameSequenceAsync::CookFrameSequenceFromSoundWave(
+	USoundWave *SoundWave, bool UseOfflineModel, const FVisemeInterpolationSettings &Settings,
+	const FOVRLipSyncPreprocessSettings &Preprocess)
+{
+	UCookFrameSequenceAsync *BPNode = NewObject<UCookFrameSequenceAsync>();
+	BPNode->SoundWave = SoundWave;
+	BPNode->UseOfflineModel = UseOfflineModel;
+	BPNode->InterpolationSettings = Settings;
+	BPNode->PreprocessSettings = Preprocess;
+	return BPNode;
+}
+
+UCookFrameSequenceAsync *UCookFrameSequenceAsync::CookFrameSequenceFromFileResumable(
+	const FString &FilePath, const FString &CheckpointDirectory, bool UseOfflineModel,
+	const FVisemeInterpolationSettings &Settings, const FOVRLipSyncPreprocessSettings &Preprocess)
+{
+	UCookFrameSequenceAsync *BPNode = NewObject<UCookFrameSequenceAsync>();
+	BPNode->SourceFilePath = FilePath;
+	BPNode->CheckpointDirectory = CheckpointDirectory;
+	BPNode->UseOfflineModel = UseOfflineModel;
+	BPNode->InterpolationSettings = Settings;
+	BPNode->PreprocessSettings = Preprocess;
+	return BPNode;
+}
+
+void UCookFrameSequenceAsync::Activate()
+{
+	// Only headers are read here, audio is decoded one chunk at a time on the cook thread
+	TUniquePtr<IOVRLipSyncAudioDecoder> Decoder;
+	FString DecoderError;
+	if (SoundWave)
+	{
+		Decoder = FOVRLipSyncSoundWaveDecoder::Create(SoundWave, &DecoderError);
+	}
+	else if (!SourceFilePath.IsEmpty())
+	{
+		// Multi-hour WAV recordings don't fit in a view and are read through a file handle
+		Decoder = IOVRLipSyncAudioDecoder::CreateForFile(SourceFilePath, &DecoderError);
+		if (!Decoder.IsValid())
+		{
+			DecoderError = FString::Printf(TEXT("%s (%s)"), *DecoderError, *SourceFilePath);
+		}
+	}
+	else
+	{
+		TSharedPtr<FOVRLipSyncFileBuffer> File = WaveFile.File;
+		if (!File.IsValid())
+		{
+			File = FOVRLipSyncFileBuffer::FromArray(MoveTemp(RawSamples));
+		}
+		Decoder = IOVRLipSyncAudioDecoder::Create(File.ToSharedRef(), &DecoderError);
+	}
+	if (!Decoder.IsValid())
+	{
+		UE_LOG(LogOvrLipSync, Error, TEXT("Can't cook frame sequence: %s"), *DecoderError);
+		onFrameSequenceCooked.Broadcast(nullptr, false);
+		return;
+	}
+
+	if (PreprocessSettings.bEnablePreprocessing)
+	{
+		Audio::EResamplingMethod Method = Audio::EResamplingMethod::FastSinc;
+		switch (PreprocessSettings.Quality)
+		{
+		case EOVRLipSyncResampleQuality::Fast:
+			Method = Audio::EResamplingMethod::Linear;
+			break;
+		case EOVRLipSyncResampleQuality::Best:
+			Method = Audio::EResamplingMethod::BestSinc;
+			break;
+		default:
+			break;
+		}
+		Decoder = FOVRLipSyncResamplingDecoder::Wrap(MoveTemp(Decoder), PreprocessSettings.bDownmixToMono,
+													 PreprocessSettings.TargetSampleRate, Method);
+	}
+
+	int32 NumChannels = Decoder->GetNumChannels();
+	int32 SampleRate = Decoder->GetSampleRate();
+	if (SampleRate < LipSyncSequenceUpateFrequency)
+	{
+		UE_LOG(LogOvrLipSync, Error, TEXT("Can't cook frame sequence: sample rate %d is too low"), SampleRate);
+		onFrameSequenceCooked.Broadcast(nullptr, false);
+		return;
+	}
+	// Largest frame, frames of rates that aren't a multiple of 100 are one sample longer every few frames
+	int32 ChunkSize = NumChannels * (SampleRate / LipSyncSequenceUpateFrequency + 1);
+	int BufferSize = 4096;
+
+	FString modelPath = UseOfflineModel ? FPaths::Combine(FPaths::ProjectPluginsDir(), TEXT("OVRLipSync"),
+														  TEXT("OfflineModel"), TEXT("ovrlipsync_offline_model.pb"))
+										: FString();
+
+	const FVisemeInterpolationSettings Settings = InterpolationSettings;
+
+	// Checkpoints are only reused for the same file contents, decoded and split into frames the same way
+	FString Fingerprint;
+	if (!CheckpointDirectory.IsEmpty())
+	{
+		Fingerprint = FString::Printf(TEXT("FrameGrid2|%s|%lld|%s|%d|%d|%lld|%s|%d|%d|%d|%d"), *SourceFilePath,
+									  IFileManager::Get().FileSize(*SourceFilePath),
+									  *IFileManager::Get().GetTimeStamp(*SourceFilePath).ToString(), SampleRate,
+									  NumChannels, Decoder->GetNumFrames(), *modelPath,
+									  PreprocessSettings.bEnablePreprocessing ? 1 : 0,
+									  PreprocessSettings.bDownmixToMono ? 1 : 0, PreprocessSettings.TargetSampleRate,
+									  static_cast<int32>(PreprocessSettings.Quality));
+	}
+
+	Async(EAsyncExecution::Thread,
+		  [this, Decoder = MoveTemp(Decoder), ChunkSize, NumChannels, modelPath, SampleRate,
+		   BufferSize, Settings, Fingerprint, CheckpointDirectory = CheckpointDirectory]()
+		  {
+			  UOVRLipSyncFrameSequence *Sequence = NewObject<UOVRLipSyncFrameSequence>();
+
+			  TArray<TArray<float>> RawVisemeFrames;
+			  TArray<float> LaughterScores;
+
+			  if (!CheckpointDirectory.IsEmpty())
+			  {
+				  // Raw frames go to disk segment by segment and are read back once inference is done
+				  FOVRLipSyncLongFormCook LongFormCook(CheckpointDirectory, Fingerprint);
+				  FString Error;
+				  if (!LongFormCook.Run(*Decoder, modelPath, [](int64, int64) { return true; }, &Error) ||
+					  !LongFormCook.LoadFrames(RawVisemeFrames, LaughterScores, &Error))
+				  {
+					  UE_LOG(LogOvrLipSync, Error, TEXT("Can't cook frame sequence: %s"), *Error);
+					  AsyncTask(ENamedThreads::GameThread,
+								[this]() { onFrameSequenceCooked.Broadcast(nullptr, false); });
+					  return;
+				  }
+				  LongFormCook.Cleanup();
+			  }
+			  else
+			  {
+				  UOVRLipSyncContextWrapper context(ovrLipSyncContextProvider_Enhanced, SampleRate, BufferSize,
+													modelPath);
+				  TArray<float> CurrentVisemes;
+				  float LaughterScore = 0.0f;
+				  int32 FrameDelayInMs = 0;
+
+				  TArray<int16_t> DecodedChunk;
+				  DecodedChunk.SetNumUninitialized(ChunkSize);
+
+				  // Generate raw frame data on the 10 ms grid, a trailing partial chunk is dropped
+				  const int16_t *Samples = nullptr;
+				  int32 FrameSamples = FOVRLipSyncLongFormCook::GetFrameSamples(0, SampleRate);
+				  int32 DecodedFrames = 0;
+				  while ((DecodedFrames = Decoder->DecodeView(DecodedChunk.GetData(), FrameSamples, Samples)) ==
+						 FrameSamples)
+				  {
+					  context.ProcessFrame(Samples, FrameSamples, CurrentVisemes, LaughterScore, FrameDelayInMs,
+										   NumChannels > 1);
+					  RawVisemeFrames.Add(CurrentVisemes);
+					  LaughterScores.Add(LaughterScore);
+					  FrameSamples = FOVRLipSyncLongFormCook::GetFrameSamples(RawVisemeFrames.Num(), SampleRate);
+				  }
+				  if (DecodedFrames == INDEX_NONE)
+				  {
+					  UE_LOG(LogOvrLipSync, Error, TEXT("Can't cook frame sequence: audio data is corrupt"));
+					  AsyncTask(ENamedThreads::GameThread,
+								[this]() { onFrameSequenceCooked.Broadcast(nullptr, false); });
+					  return;
+				  }
+			  }
+
+			  FOVRLipSyncVisemePostProcess::Apply(RawVisemeFrames, LaughterScores, Settings, *Sequence);
+
+			  AsyncTask(ENamedThreads::GameThread,
+						[Sequence, this]() { onFrameSequenceCooked.Broadcast(Sequence, true); });
+		  });
+}
@@ -0,0 +1,288 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncAudioDecoder.cpp
+ * Content     :   Incremental decoding of audio files to the 16-bit PCM used for inference
+ ******************************************************************************/
+
+#include "OVRLipSyncAudioDecoder.h"
+
+#include "AudioDecompress.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/PlatformFileManager.h"
+#include "OVRLipSyncFileBuffer.h"
+#include "OVRLipSyncFlacDecoder.h"
+#include "OVRLipSyncPCMConverter.h"
+#include "OVRLipSyncSoundWaveDecoder.h"
+#include "OVRLipSyncWaveFormat.h"
+
+namespace
+{
+bool Fail(FString *OutError, const TCHAR *Reason)
+{
+	if (OutError)
+	{
+		*OutError = Reason;
+	}
+	return false;
+}
+
+bool HasMagic(TArrayView<const uint8> Bytes, int32 Offset, const char *Magic, int32 Size)
+{
+	return Bytes.Num() >= Offset + Size && FMemory::Memcmp(Bytes.GetData() + Offset, Magic, Size) == 0;
+}
+
+// WAV files are converted straight from the data chunk, 16-bit files with the output layout are not copied
+class FWaveDecoder : public IOVRLipSyncAudioDecoder
+{
+public:
+	FWaveDecoder(const TSharedRef<FOVRLipSyncFileBuffer> &InFile, const FOVRLipSyncWaveView &InView)
+		: File(InFile), View(InView),
+		  Converter(View.Format, FOVRLipSyncPCMConverter::GetInferenceChannels(View.Format.NumChannels))
+	{
+	}
+
+	int32 GetSampleRate() const override { return View.Format.SampleRate; }
+	int32 GetNumChannels() const override { return Converter.GetOutputFormat().NumChannels; }
+	int64 GetNumFrames() const override { return View.GetNumFrames(); }
+
+	int32 Decode(int16 *OutSamples, int32 MaxFrames) override
+	{
+		const int32 Frames = Advance(MaxFrames);
+		Converter.Convert(View.Data.GetData() + (Position - Frames) * View.Format.BlockAlign, Frames, OutSamples);
+		return Frames;
+	}
+
+	int32 DecodeView(int16 *Scratch, int32 MaxFrames, const int16 *&OutSamples) override
+	{
+		if (!Converter.IsPassthrough())
+		{
+			OutSamples = Scratch;
+			return Decode(Scratch, MaxFrames);
+		}
+		const int32 Frames = Advance(MaxFrames);
+		OutSamples = View.GetPCM16() + (Position - Frames) * View.Format.NumChannels;
+		return Frames;
+	}
+
+private:
+	int32 Advance(int32 MaxFrames)
+	{
+		const int32 Frames = static_cast<int32>(FMath::Min<int64>(MaxFrames, View.GetNumFrames() - Position));
+		Position += Frames;
+		return Frames;
+	}
+
+	TSharedRef<FOVRLipSyncFileBuffer> File;
+	FOVRLipSyncWaveView View;
+	FOVRLipSyncPCMConverter Converter;
+	int64 Position = 0;
+};
+
+// WAV files too large for a view, read from the data chunk through a file handle
+class FWaveFileDecoder : public IOVRLipSyncAudioDecoder
+{
+public:
+	FWaveFileDecoder(TUniquePtr<IFileHandle> InFileHandle, const FOVRLipSyncWaveFormat &Format, int64 InDataOffset,
+					 int64 DataSize)
+		: FileHandle(MoveTemp(InFileHandle)), DataOffset(InDataOffset), NumFrames(DataSize / Format.BlockAlign),
+		  Converter(Format, FOVRLipSyncPCMConverter::GetInferenceChannels(Format.NumChannels))
+	{
+	}
+
+	int32 GetSampleRate() const override { return Converter.GetSourceFormat().SampleRate; }
+	int32 GetNumChannels() const override { return Converter.GetOutputFormat().NumChannels; }
+	int64 GetNumFrames() const override { return NumFrames; }
+
+	int32 Decode(int16 *OutSamples, int32 MaxFrames) override
+	{
+		const int32 Frames = static_cast<int32>(FMath::Min<int64>(MaxFrames, NumFrames - Position));
+		if (Frames <= 0)
+		{
+			return 0;
+		}
+
+		const int32 BlockAlign = Converter.GetSourceFormat().BlockAlign;
+		uint8 *Destination = reinterpret_cast<uint8 *>(OutSamples);
+		if (!Converter.IsPassthrough())
+		{
+			ReadBuffer.SetNumUninitialized(Frames * BlockAlign);
+			Destination = ReadBuffer.GetData();
+		}
+		if (!FileHandle->Seek(DataOffset + Position * BlockAlign) ||
+			!FileHandle->Read(Destination, static_cast<int64>(Frames) * BlockAlign))
+		{
+			return INDEX_NONE;
+		}
+		if (!Converter.IsPassthrough())
+		{
+			Converter.Convert(ReadBuffer.GetData(), Frames, OutSamples);
+		}
+		Position += Frames;
+		return Frames;
+	}
+
+private:
+	TUniquePtr<IFileHandle> FileHandle;
+	int64 DataOffset;
+	int64 NumFrames;
+	int64 Position = 0;
+	FOVRLipSyncPCMConverter Converter;
+	TArray<uint8> ReadBuffer;
+};
+
+// Formats the engine ships runtime decoders for (Ogg Vorbis and its own Opus container)
+class FCompressedAudioDecoder : public IOVRLipSyncAudioDecoder
+{
+public:
+	static TUniquePtr<IOVRLipSyncAudioDecoder> Create(const TSharedRef<FOVRLipSyncFileBuffer> &InFile, FName Format,
+													  FString *OutError)
+	{
+		Audio::IAudioInfoFactory *Factory = Audio::IAudioInfoFactoryRegistry::Get().Find(Format);
+		TUniquePtr<ICompressedAudioInfo> Info(Factory ? Factory->Create() : nullptr);
+		if (!Info.IsValid())
+		{
+			Fail(OutError, TEXT("no decoder is available for this format on this platform"));
+			return nullptr;
+		}
+
+		const TArrayView<const uint8> Bytes = InFile->GetView();
+		FSoundQualityInfo QualityInfo;
+		if (!Info->ReadCompressedInfo(Bytes.GetData(), Bytes.Num(), &QualityInfo) || QualityInfo.NumChannels <= 0 ||
+			QualityInfo.SampleRate <= 0)
+		{
+			Fail(OutError, TEXT("failed to read the compressed audio header"));
+			return nullptr;
+		}
+		return TUniquePtr<IOVRLipSyncAudioDecoder>(new FCompressedAudioDecoder(InFile, MoveTemp(Info), QualityInfo));
+	}
+
+	int32 GetSampleRate() const override { return SampleRate; }
+	int32 GetNumChannels() const override { return Converter.GetOutputFormat().NumChannels; }
+	int64 GetNumFrames() const override { return NumFrames; }
+
+	int32 Decode(int16 *OutSamples, int32 MaxFrames) override
+	{
+		const int32 Frames = static_cast<int32>(FMath::Min<int64>(MaxFrames, NumFrames - Position));
+		if (Frames <= 0)
+		{
+			return 0;
+		}
+
+		// The engine decoders fill the whole buffer, padding with silence past the end of the stream
+		const FOVRLipSyncWaveFormat &SourceFormat = Converter.GetSourceFormat();
+		int16 *Destination = OutSamples;
+		if (!Converter.IsPassthrough())
+		{
+			Decoded.SetNumUninitialized(Frames * SourceFormat.NumChannels);
+			Destination = Decoded.GetData();
+		}
+		Info->ReadCompressedData(reinterpret_cast<uint8 *>(Destination), false, Frames * SourceFormat.BlockAlign);
+		if (!Converter.IsPassthrough())
+		{
+			Converter.Convert(reinterpret_cast<const uint8 *>(Decoded.GetData()), Frames, OutSamples);
+		}
+		Position += Frames;
+		return Frames;
+	}
+
+private:
+	FCompressedAudioDecoder(const TSharedRef<FOVRLipSyncFileBuffer> &InFile, TUniquePtr<ICompressedAudioInfo> InInfo,
+							const FSoundQualityInfo &QualityInfo)
+		: File(InFile), Info(MoveTemp(InInfo)), SampleRate(QualityInfo.SampleRate),
+		  NumFrames(QualityInfo.SampleDataSize / (QualityInfo.NumChannels * sizeof(int16))),
+		  Converter(FOVRLipSyncWaveFormat::MakePCM16(QualityInfo.SampleRate, QualityInfo.NumChannels),
+					FOVRLipSyncPCMConverter::GetInferenceChannels(QualityInfo.NumChannels))
+	{
+	}
+
+	// Decoders read from the file contents in place
+	TSharedRef<FOVRLipSyncFileBuffer> File;
+	TUniquePtr<ICompressedAudioInfo> Info;
+	int32 SampleRate;
+	int64 NumFrames;
+	int64 Position = 0;
+	FOVRLipSyncPCMConverter Converter;
+	TArray<int16> Decoded;
+};
+} // namespace
+
+TUniquePtr<IOVRLipSyncAudioDecoder> IOVRLipSyncAudioDecoder::Create(const TSharedRef<FOVRLipSyncFileBuffer> &File,
+																	FString *OutError)
+{
+	const TArrayView<const uint8> Bytes = File->GetView();
+
+	if (HasMagic(Bytes, 0, "RIFF", 4))
+	{
+		FOVRLipSyncWaveView View;
+		if (!FOVRLipSyncWaveParser::Parse(Bytes, View, OutError))
+		{
+			return nullptr;
+		}
+		return MakeUnique<FWaveDecoder>(File, View);
+	}
+	if (HasMagic(Bytes, 0, "fLaC", 4))
+	{
+		return FOVRLipSyncFlacDecoder::Create(File, OutError);
+	}
+	if (HasMagic(Bytes, 0, "OggS", 4))
+	{
+		// The first page holds the identification header of the first logical stream
+		if (HasMagic(Bytes, 28, "\x01vorbis", 7))
+		{
+			return FCompressedAudioDecoder::Create(File, TEXT("OGG"), OutError);
+		}
+		if (HasMagic(Bytes, 28, "OpusHead", 8))
+		{
+			Fail(OutError, TEXT("Ogg Opus files are not supported, only Opus audio cooked by the engine"));
+			return nullptr;
+		}
+		Fail(OutError, TEXT("unsupported Ogg stream"));
+		return nullptr;
+	}
+	if (HasMagic(Bytes, 0, "UE4OPUS", 7))
+	{
+		return FCompressedAudioDecoder::Create(File, TEXT("OPUS"), OutError);
+	}
+
+	Fail(OutError, TEXT("unrecognized audio file format"));
+	return nullptr;
+}
+
+TUniquePtr<IOVRLipSyncAudioDecoder> IOVRLipSyncAudioDecoder::CreateForFile(const FString &FilePath, FString *OutError)
+{
+	TUniquePtr<IFileHandle> FileHandle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+	if (!FileHandle)
+	{
+		Fail(OutError, TEXT("can't open file"));
+		return nullptr;
+	}
+
+	// Views are 32-bit, multi-hour WAV recordings are streamed instead
+	uint8 Magic[4];
+	if (FileHandle->Size() > MAX_int32 && FileHandle->Read(Magic, sizeof(Magic)) &&
+		HasMagic(MakeArrayView(Magic), 0, "RIFF", 4))
+	{
+		FOVRLipSyncWaveFormat Format;
+		int64 DataOffset = 0;
+		int64 DataSize = 0;
+		if (!FOVRLipSyncWaveParser::ParseFile(*FileHandle, Format, DataOffset, DataSize, OutError))
+		{
+			return nullptr;
+		}
+		return MakeUnique<FWaveFileDecoder>(MoveTemp(FileHandle), Format, DataOffset, DataSize);
+	}
+	FileHandle.Reset();
+
+	TSharedPtr<FOVRLipSyncFileBuffer> File = FOVRLipSyncFileBuffer::Open(FilePath);
+	if (!File.IsValid())
+	{
+		Fail(OutError, TEXT("failed to read the file"));
+		return nullptr;
+	}
+	return Create(File.ToSharedRef(), OutError);
+}
+
+TUniquePtr<IOVRLipSyncAudioDecoder> IOVRLipSyncAudioDecoder::CreateForSoundWave(USoundWave *SoundWave,
+																				FString *OutError)
+{
+	return FOVRLipSyncSoundWaveDecoder::Create(SoundWave, OutError);
+}
@@ -23,13 +23,27 @@
 
 #include "OVRLipSyncContextWrapper.h"
 #include "OVRLipSyncModule.h"
+#include "OVRLipSyncStats.h"
 
 #include <Core.h>
 #include <algorithm>
 
+namespace
+{
+// The SDK's global initialization and context creation aren't safe to run on several threads at once
+FCriticalSection &GetContextLock()
+{
+	static FCriticalSection Lock;
+	return Lock;
+}
+} // namespace
+
+DECLARE_CYCLE_STAT(TEXT("Process Frame"), STAT_OVRLipSync_ProcessFrame, STATGROUP_OVRLipSync);
+
 UOVRLipSyncContextWrapper::UOVRLipSyncContextWrapper(ovrLipSyncContextProvider ProviderKind, int SampleRate,
 													 int BufferSize, FString ModelPath, bool EnableAcceleration)
 {
+	FScopeLock Lock(&GetContextLock());
 #if !PLATFORM_ANDROID
 	auto pluginsDir = FPaths::ProjectPluginsDir();
 	auto libDir = FPaths::Combine(pluginsDir, TEXT("OVRLipSync"), TEXT("ThirdParty"), TEXT("Lib"),
@@ -54,11 +68,18 @@ UOVRLipSyncContextWrapper::UOVRLipSyncContextWrapper(ovrLipSyncContextProvider P
 	}
 }
 
-UOVRLipSyncContextWrapper::~UOVRLipSyncContextWrapper() { ovrLipSync_DestroyContext(LipSyncContext); }
+UOVRLipSyncContextWrapper::~UOVRLipSyncContextWrapper()
+{
+	FScopeLock Lock(&GetContextLock());
+	ovrLipSync_DestroyContext(LipSyncContext);
+}
 
 void UOVRLipSyncContextWrapper::ProcessFrame(const int16_t *AudioBuffer, int AudioBufferSize, TArray<float> &Visemes,
 											 float &LaughterScore, int32_t &FrameDelay, bool Stereo)
 {
+	SCOPE_CYCLE_COUNTER(STAT_OVRLipSync_ProcessFrame);
+	TRACE_CPUPROFILER_EVENT_SCOPE(OVRLipSync::ProcessFrame);
+
 	if (Visemes.Num() != ovrLipSyncViseme_Count)
 	{
 		Visemes.SetNumZeroed(ovrLipSyncViseme_Count);
@@ -74,45 +95,68 @@ void UOVRLipSyncContextWrapper::ProcessFrame(const int16_t *AudioBuffer, int Aud
 		UE_LOG(LogOvrLipSync, Error, TEXT("Failed to process frame: %d"), rc);
 		return;
 	}
+	INC_DWORD_STAT(STAT_OVRLipSync_FramesInferred);
 	LaughterScore = frame.laughterScore;
 	FrameDelay = frame.frameDelay;
 }
 
-namespace
-{
-void ProcessFrameCallback(void *opaque, const ovrLipSyncFrame *pFrame, ovrLipSyncResult result)
+void UOVRLipSyncContextWrapper::ProcessFrameCallback(void *opaque, const ovrLipSyncFrame *pFrame,
+													 ovrLipSyncResult result)
 {
+	auto wrapper = reinterpret_cast<UOVRLipSyncContextWrapper *>(opaque);
+	uint64 FeedCycles = 0;
+	{
+		FScopeLock Lock(&wrapper->PendingLock);
+		if (wrapper->PendingFeedCycles.Num() > 0)
+		{
+			FeedCycles = wrapper->PendingFeedCycles[0];
+			wrapper->PendingFeedCycles.RemoveAt(0);
+		}
+	}
+	--wrapper->NumPendingFrames;
 	if (result != ovrLipSyncSuccess)
 	{
 		UE_LOG(LogOvrLipSync, Error, TEXT("Async prediction failed: %d"), result);
 		return;
 	}
-	auto wrapper = reinterpret_cast<UOVRLipSyncContextWrapper *>(opaque);
+	INC_DWORD_STAT(STAT_OVRLipSync_FramesInferred);
 	TArray<float> Visemes(pFrame->visemes, pFrame->visemesLength);
-	wrapper->InvokeAsyncCallback(Visemes, pFrame->laughterScore);
+	wrapper->InvokeAsyncCallback(Visemes, pFrame->laughterScore, FeedCycles);
 }
-} // namespace
 
 void UOVRLipSyncContextWrapper::SetAsyncCallback(const AsyncCallbackType &Callback) { AsyncCallback = Callback; }
 
-void UOVRLipSyncContextWrapper::InvokeAsyncCallback(const TArray<float> &Visemes, float LaughterScore)
+void UOVRLipSyncContextWrapper::InvokeAsyncCallback(const TArray<float> &Visemes, float LaughterScore,
+													 uint64 FeedCycles)
 {
 	if (!AsyncCallback)
 	{
 		UE_LOG(LogOvrLipSync, Error, TEXT("Trying invoke unintialized async callback"));
 		return;
 	}
-	AsyncCallback(Visemes, LaughterScore);
+	AsyncCallback(Visemes, LaughterScore, FeedCycles);
 }
 
 void UOVRLipSyncContextWrapper::ProcessFrameAsync(const int16_t *AudioBuffer, int AudioBufferSize, bool Stereo)
 {
+	// Counted before the call, the callback can run before it returns
+	++NumPendingFrames;
+	{
+		FScopeLock Lock(&PendingLock);
+		PendingFeedCycles.Add(FPlatformTime::Cycles64());
+	}
 	auto rc = ovrLipSync_ProcessFrameAsync(
 		LipSyncContext, AudioBuffer, AudioBufferSize,
 		Stereo ? ovrLipSyncAudioDataType_S16_Stereo : ovrLipSyncAudioDataType_S16_Mono, ProcessFrameCallback, this);
 	if (rc != ovrLipSyncSuccess)
 	{
 		UE_LOG(LogOvrLipSync, Error, TEXT("Failed to start async prediction: %d"), rc);
+		{
+			// No callback comes for a frame that wasn't accepted, earlier frames have popped their own entries
+			FScopeLock Lock(&PendingLock);
+			PendingFeedCycles.Pop();
+		}
+		--NumPendingFrames;
 		return;
 	}
 }
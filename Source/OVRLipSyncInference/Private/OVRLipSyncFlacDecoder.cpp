@@ -0,0 +1,643 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncFlacDecoder.cpp
+ * Content     :   Native FLAC stream decoder
+ ******************************************************************************/
+
+#include "OVRLipSyncFlacDecoder.h"
+
+#include "OVRLipSyncFileBuffer.h"
+#include "OVRLipSyncPCMConverter.h"
+
+namespace
+{
+constexpr int32 StreamInfoType = 0;
+constexpr int32 StreamInfoSize = 34;
+
+// Big-endian bit reader over a frame, reads past the end return zeros and flag an overrun
+class FFlacBitReader
+{
+public:
+	FFlacBitReader(const uint8 *InData, int64 InNumBytes) : Data(InData), NumBytes(InNumBytes), NumBits(InNumBytes * 8)
+	{
+	}
+
+	bool HasOverrun() const { return bOverrun; }
+	int64 GetBytePosition() const { return (Position + 7) >> 3; }
+	void AlignToByte() { Position = (Position + 7) & ~int64(7); }
+
+	// Read up to 32 bits as an unsigned value
+	uint32 Read(int32 Count)
+	{
+		if (Count == 0)
+		{
+			return 0;
+		}
+		if (Position + Count > NumBits)
+		{
+			bOverrun = true;
+			Position = NumBits;
+			return 0;
+		}
+		const uint64 Word = Load64(Position >> 3) << (Position & 7);
+		Position += Count;
+		return static_cast<uint32>(Word >> (64 - Count));
+	}
+
+	// Read up to 32 bits as a two's complement value
+	int32 ReadSigned(int32 Count)
+	{
+		if (Count == 0)
+		{
+			return 0;
+		}
+		const uint32 Value = Read(Count);
+		const uint32 SignBit = 1u << (Count - 1);
+		return static_cast<int32>((Value ^ SignBit) - SignBit);
+	}
+
+	// Count zero bits up to and including the next one bit
+	uint32 ReadUnary()
+	{
+		uint32 Zeros = 0;
+		while (Position < NumBits)
+		{
+			const int32 Shift = static_cast<int32>(Position & 7);
+			const uint64 Word = Load64(Position >> 3) << Shift;
+			if (Word != 0)
+			{
+				const int32 LeadingZeros = static_cast<int32>(FMath::CountLeadingZeros64(Word));
+				Zeros += LeadingZeros;
+				Position += LeadingZeros + 1;
+				if (Position > NumBits)
+				{
+					break;
+				}
+				return Zeros;
+			}
+			Zeros += 64 - Shift;
+			Position += 64 - Shift;
+		}
+		bOverrun = true;
+		Position = NumBits;
+		return 0;
+	}
+
+private:
+	uint64 Load64(int64 ByteIndex) const
+	{
+		uint64 Word = 0;
+		if (ByteIndex + 8 <= NumBytes)
+		{
+			for (int32 i = 0; i < 8; ++i)
+			{
+				Word = Word << 8 | Data[ByteIndex + i];
+			}
+			return Word;
+		}
+		for (int32 i = 0; i < 8; ++i)
+		{
+			Word = Word << 8 | (ByteIndex + i < NumBytes ? Data[ByteIndex + i] : 0);
+		}
+		return Word;
+	}
+
+	const uint8 *Data;
+	int64 NumBytes;
+	int64 NumBits;
+	int64 Position = 0;
+	bool bOverrun = false;
+};
+
+// CRC-8 of a frame header, polynomial x^8 + x^2 + x + 1
+uint8 ComputeCrc8(const uint8 *Data, int64 NumBytes)
+{
+	uint32 Crc = 0;
+	for (int64 i = 0; i < NumBytes; ++i)
+	{
+		Crc ^= Data[i];
+		for (int32 Bit = 0; Bit < 8; ++Bit)
+		{
+			Crc = (Crc & 0x80) != 0 ? (Crc << 1) ^ 0x07 : Crc << 1;
+		}
+	}
+	return static_cast<uint8>(Crc);
+}
+
+// CRC-16 of a whole frame, polynomial x^16 + x^15 + x^2 + 1
+uint16 ComputeCrc16(const uint8 *Data, int64 NumBytes)
+{
+	static const TArray<uint16> Table = []() {
+		TArray<uint16> Values;
+		Values.SetNumUninitialized(256);
+		for (uint32 Byte = 0; Byte < 256; ++Byte)
+		{
+			uint32 Crc = Byte << 8;
+			for (int32 Bit = 0; Bit < 8; ++Bit)
+			{
+				Crc = (Crc & 0x8000) != 0 ? (Crc << 1) ^ 0x8005 : Crc << 1;
+			}
+			Values[Byte] = static_cast<uint16>(Crc);
+		}
+		return Values;
+	}();
+
+	uint16 Crc = 0;
+	for (int64 i = 0; i < NumBytes; ++i)
+	{
+		Crc = static_cast<uint16>(Crc << 8) ^ Table[(Crc >> 8) ^ Data[i]];
+	}
+	return Crc;
+}
+
+// Decode the Rice coded residual of a subframe into Out[PredictorOrder..BlockSize)
+bool DecodeResidual(FFlacBitReader &Reader, int32 BlockSize, int32 PredictorOrder, int32 *Out)
+{
+	const uint32 Method = Reader.Read(2);
+	if (Method > 1)
+	{
+		return false;
+	}
+	const int32 ParameterBits = Method == 0 ? 4 : 5;
+	const uint32 EscapeParameter = Method == 0 ? 15 : 31;
+	const int32 PartitionOrder = static_cast<int32>(Reader.Read(4));
+	const int32 NumPartitions = 1 << PartitionOrder;
+	const int32 PartitionSize = BlockSize >> PartitionOrder;
+	if ((PartitionSize << PartitionOrder) != BlockSize || PartitionSize < PredictorOrder)
+	{
+		return false;
+	}
+
+	int32 Sample = PredictorOrder;
+	for (int32 Partition = 0; Partition < NumPartitions; ++Partition)
+	{
+		const int32 Count = Partition == 0 ? PartitionSize - PredictorOrder : PartitionSize;
+		const uint32 Parameter = Reader.Read(ParameterBits);
+		if (Parameter == EscapeParameter)
+		{
+			const int32 RawBits = static_cast<int32>(Reader.Read(5));
+			for (int32 i = 0; i < Count; ++i)
+			{
+				Out[Sample++] = Reader.ReadSigned(RawBits);
+			}
+		}
+		else
+		{
+			for (int32 i = 0; i < Count; ++i)
+			{
+				// Two statements, the quotient has to be read before the remainder
+				const uint32 Quotient = Reader.ReadUnary();
+				const uint32 Value = (Quotient << Parameter) | Reader.Read(Parameter);
+				Out[Sample++] = static_cast<int32>(Value >> 1) ^ -static_cast<int32>(Value & 1);
+			}
+		}
+		if (Reader.HasOverrun())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool DecodeSubframe(FFlacBitReader &Reader, int32 BlockSize, int32 BitsPerSample, int32 *Out)
+{
+	if (Reader.Read(1) != 0)
+	{
+		return false;
+	}
+	const uint32 Type = Reader.Read(6);
+	int32 WastedBits = 0;
+	if (Reader.Read(1) != 0)
+	{
+		WastedBits = static_cast<int32>(Reader.ReadUnary()) + 1;
+	}
+	BitsPerSample -= WastedBits;
+	if (BitsPerSample <= 0 || BitsPerSample > 32)
+	{
+		return false;
+	}
+
+	if (Type == 0)
+	{
+		// Constant
+		const int32 Value = Reader.ReadSigned(BitsPerSample);
+		for (int32 i = 0; i < BlockSize; ++i)
+		{
+			Out[i] = Value;
+		}
+	}
+	else if (Type == 1)
+	{
+		// Verbatim
+		for (int32 i = 0; i < BlockSize; ++i)
+		{
+			Out[i] = Reader.ReadSigned(BitsPerSample);
+		}
+	}
+	else if (Type >= 8 && Type <= 12)
+	{
+		// Fixed polynomial predictor
+		const int32 Order = static_cast<int32>(Type - 8);
+		if (Order > BlockSize)
+		{
+			return false;
+		}
+		for (int32 i = 0; i < Order; ++i)
+		{
+			Out[i] = Reader.ReadSigned(BitsPerSample);
+		}
+		if (!DecodeResidual(Reader, BlockSize, Order, Out))
+		{
+			return false;
+		}
+		switch (Order)
+		{
+		case 1:
+			for (int32 i = 1; i < BlockSize; ++i)
+			{
+				Out[i] += Out[i - 1];
+			}
+			break;
+		case 2:
+			for (int32 i = 2; i < BlockSize; ++i)
+			{
+				Out[i] += 2 * Out[i - 1] - Out[i - 2];
+			}
+			break;
+		case 3:
+			for (int32 i = 3; i < BlockSize; ++i)
+			{
+				Out[i] += 3 * Out[i - 1] - 3 * Out[i - 2] + Out[i - 3];
+			}
+			break;
+		case 4:
+			for (int32 i = 4; i < BlockSize; ++i)
+			{
+				Out[i] += 4 * Out[i - 1] - 6 * Out[i - 2] + 4 * Out[i - 3] - Out[i - 4];
+			}
+			break;
+		default:
+			break;
+		}
+	}
+	else if (Type >= 32)
+	{
+		// Linear predictor with quantized coefficients
+		const int32 Order = static_cast<int32>(Type - 31);
+		if (Order > BlockSize)
+		{
+			return false;
+		}
+		for (int32 i = 0; i < Order; ++i)
+		{
+			Out[i] = Reader.ReadSigned(BitsPerSample);
+		}
+		const int32 Precision = static_cast<int32>(Reader.Read(4)) + 1;
+		const int32 Shift = Reader.ReadSigned(5);
+		if (Precision > 15 || Shift < 0)
+		{
+			return false;
+		}
+		int32 Coefficients[32];
+		for (int32 i = 0; i < Order; ++i)
+		{
+			Coefficients[i] = Reader.ReadSigned(Precision);
+		}
+		if (!DecodeResidual(Reader, BlockSize, Order, Out))
+		{
+			return false;
+		}
+		for (int32 i = Order; i < BlockSize; ++i)
+		{
+			int64 Prediction = 0;
+			for (int32 j = 0; j < Order; ++j)
+			{
+				Prediction += static_cast<int64>(Coefficients[j]) * Out[i - j - 1];
+			}
+			Out[i] += static_cast<int32>(Prediction >> Shift);
+		}
+	}
+	else
+	{
+		return false;
+	}
+
+	if (WastedBits > 0)
+	{
+		for (int32 i = 0; i < BlockSize; ++i)
+		{
+			Out[i] = static_cast<int32>(static_cast<uint32>(Out[i]) << WastedBits);
+		}
+	}
+	return !Reader.HasOverrun();
+}
+} // namespace
+
+FOVRLipSyncFlacDecoder::FOVRLipSyncFlacDecoder(const TSharedRef<FOVRLipSyncFileBuffer> &InFile) : File(InFile)
+{
+}
+
+FOVRLipSyncFlacDecoder::~FOVRLipSyncFlacDecoder() = default;
+
+TUniquePtr<FOVRLipSyncFlacDecoder> FOVRLipSyncFlacDecoder::Create(const TSharedRef<FOVRLipSyncFileBuffer> &InFile,
+																  FString *OutError)
+{
+	auto Fail = [OutError](const TCHAR *Error) {
+		if (OutError)
+		{
+			*OutError = Error;
+		}
+		return nullptr;
+	};
+
+	const TArrayView<const uint8> Bytes = InFile->GetView();
+	if (Bytes.Num() < 4 || FMemory::Memcmp(Bytes.GetData(), "fLaC", 4) != 0)
+	{
+		return Fail(TEXT("not a FLAC file"));
+	}
+
+	TUniquePtr<FOVRLipSyncFlacDecoder> Decoder(new FOVRLipSyncFlacDecoder(InFile));
+
+	// Metadata blocks, only STREAMINFO matters
+	int64 Offset = 4;
+	bool bLastBlock = false;
+	bool bHasStreamInfo = false;
+	while (!bLastBlock)
+	{
+		if (Offset + 4 > Bytes.Num())
+		{
+			return Fail(TEXT("FLAC metadata is truncated"));
+		}
+		const uint8 *Header = Bytes.GetData() + Offset;
+		bLastBlock = (Header[0] & 0x80) != 0;
+		const int32 Type = Header[0] & 0x7F;
+		const int64 Size = int64(Header[1]) << 16 | int64(Header[2]) << 8 | Header[3];
+		Offset += 4;
+		if (Offset + Size > Bytes.Num())
+		{
+			return Fail(TEXT("FLAC metadata is truncated"));
+		}
+		if (Type == StreamInfoType && Size >= StreamInfoSize)
+		{
+			FFlacBitReader Reader(Bytes.GetData() + Offset, Size);
+			Reader.Read(16); // Minimum block size
+			const int32 MaxBlock = static_cast<int32>(Reader.Read(16));
+			Reader.Read(24); // Minimum frame size
+			Reader.Read(24); // Maximum frame size
+			Decoder->SampleRate = static_cast<int32>(Reader.Read(20));
+			Decoder->NumChannels = static_cast<int32>(Reader.Read(3)) + 1;
+			Decoder->BitsPerSample = static_cast<int32>(Reader.Read(5)) + 1;
+			const int64 TotalHigh = Reader.Read(4);
+			Decoder->TotalFrames = TotalHigh << 32 | Reader.Read(32);
+			if (MaxBlock < 16)
+			{
+				return Fail(TEXT("invalid FLAC block size"));
+			}
+			bHasStreamInfo = true;
+		}
+		Offset += Size;
+	}
+	if (!bHasStreamInfo)
+	{
+		return Fail(TEXT("missing FLAC STREAMINFO block"));
+	}
+	if (Decoder->SampleRate <= 0 || Decoder->BitsPerSample < 4 || Decoder->BitsPerSample > 32)
+	{
+		return Fail(TEXT("unsupported FLAC sample size or sample rate"));
+	}
+
+	const int32 OutputChannels = FOVRLipSyncPCMConverter::GetInferenceChannels(Decoder->NumChannels);
+	if (Decoder->NumChannels != OutputChannels)
+	{
+		// FLAC channel order matches the default WAVE speaker order
+		Decoder->Downmix = MakeUnique<FOVRLipSyncPCMConverter>(
+			FOVRLipSyncWaveFormat::MakePCM16(Decoder->SampleRate, Decoder->NumChannels), OutputChannels);
+	}
+	Decoder->FrameOffset = Offset;
+	return Decoder;
+}
+
+int32 FOVRLipSyncFlacDecoder::GetNumChannels() const
+{
+	return FOVRLipSyncPCMConverter::GetInferenceChannels(NumChannels);
+}
+
+int32 FOVRLipSyncFlacDecoder::Decode(int16 *OutSamples, int32 MaxFrames)
+{
+	const int32 OutputChannels = GetNumChannels();
+	int32 Frames = 0;
+	while (Frames < MaxFrames)
+	{
+		if (ConsumedFrames == DecodedFrames && !DecodeFrame())
+		{
+			if (bError)
+			{
+				return INDEX_NONE;
+			}
+			break;
+		}
+		const int32 Count = FMath::Min(MaxFrames - Frames, DecodedFrames - ConsumedFrames);
+		FMemory::Memcpy(OutSamples + Frames * OutputChannels, DecodedBlock.GetData() + ConsumedFrames * OutputChannels,
+						Count * OutputChannels * sizeof(int16));
+		Frames += Count;
+		ConsumedFrames += Count;
+	}
+	return Frames;
+}
+
+bool FOVRLipSyncFlacDecoder::DecodeFrame()
+{
+	static const int32 SampleRates[] = {0,	   88200, 176400, 192000, 8000,	 16000,
+										22050, 24000, 32000,  44100,  48000, 96000};
+	static const int32 SampleSizes[] = {0, 8, 12, 0, 16, 20, 24, 32};
+
+	DecodedFrames = ConsumedFrames = 0;
+	const TArrayView<const uint8> Bytes = File->GetView();
+	// Trailing bytes too short for a frame header (e.g. ID3 tags) end the stream
+	if (bEndOfStream || bError || FrameOffset + 6 > Bytes.Num())
+	{
+		bEndOfStream = true;
+		return false;
+	}
+
+	auto Fail = [this]() {
+		bError = true;
+		return false;
+	};
+
+	FFlacBitReader Reader(Bytes.GetData() + FrameOffset, Bytes.Num() - FrameOffset);
+	if (Reader.Read(14) != 0x3FFE)
+	{
+		// Anything after the last frame that isn't a frame ends the stream
+		bEndOfStream = true;
+		return false;
+	}
+	Reader.Read(1); // Reserved
+	Reader.Read(1); // Blocking strategy
+	const uint32 BlockSizeCode = Reader.Read(4);
+	const uint32 SampleRateCode = Reader.Read(4);
+	const uint32 ChannelAssignment = Reader.Read(4);
+	const uint32 SampleSizeCode = Reader.Read(3);
+	Reader.Read(1); // Reserved
+
+	// Frame or sample number, UTF-8 style variable length
+	const uint32 FirstByte = Reader.Read(8);
+	int32 ExtraBytes = 0;
+	for (uint32 Mask = 0x80; (FirstByte & Mask) != 0 && Mask > 1; Mask >>= 1)
+	{
+		++ExtraBytes;
+	}
+	if (ExtraBytes == 1 || ExtraBytes > 7)
+	{
+		return Fail();
+	}
+	for (int32 i = 1; i < ExtraBytes; ++i)
+	{
+		Reader.Read(8);
+	}
+
+	int32 BlockSize = 0;
+	if (BlockSizeCode == 1)
+	{
+		BlockSize = 192;
+	}
+	else if (BlockSizeCode >= 2 && BlockSizeCode <= 5)
+	{
+		BlockSize = 576 << (BlockSizeCode - 2);
+	}
+	else if (BlockSizeCode == 6)
+	{
+		BlockSize = static_cast<int32>(Reader.Read(8)) + 1;
+	}
+	else if (BlockSizeCode == 7)
+	{
+		BlockSize = static_cast<int32>(Reader.Read(16)) + 1;
+	}
+	else if (BlockSizeCode >= 8)
+	{
+		BlockSize = 256 << (BlockSizeCode - 8);
+	}
+	if (BlockSize == 0 || BlockSize > MaxBlockSize)
+	{
+		return Fail();
+	}
+
+	// The sample rate only matters for checking that it doesn't change mid-stream
+	int32 FrameSampleRate = SampleRate;
+	if (SampleRateCode >= 1 && SampleRateCode <= 11)
+	{
+		FrameSampleRate = SampleRates[SampleRateCode];
+	}
+	else if (SampleRateCode == 12)
+	{
+		FrameSampleRate = static_cast<int32>(Reader.Read(8)) * 1000;
+	}
+	else if (SampleRateCode == 13)
+	{
+		FrameSampleRate = static_cast<int32>(Reader.Read(16));
+	}
+	else if (SampleRateCode == 14)
+	{
+		FrameSampleRate = static_cast<int32>(Reader.Read(16)) * 10;
+	}
+	else if (SampleRateCode == 15)
+	{
+		return Fail();
+	}
+	// The header ends on a byte boundary, right before its CRC-8
+	const int64 HeaderSize = Reader.GetBytePosition();
+	if (Reader.Read(8) != ComputeCrc8(Bytes.GetData() + FrameOffset, HeaderSize))
+	{
+		return Fail();
+	}
+
+	const int32 FrameBitsPerSample = SampleSizeCode == 0 ? BitsPerSample : SampleSizes[SampleSizeCode];
+	const int32 FrameChannels = ChannelAssignment < 8 ? static_cast<int32>(ChannelAssignment) + 1 : 2;
+	if (ChannelAssignment > 10 || FrameChannels != NumChannels || FrameBitsPerSample != BitsPerSample ||
+		FrameSampleRate != SampleRate || Reader.HasOverrun())
+	{
+		return Fail();
+	}
+
+	// Subframes, the side channel of stereo decorrelation carries one extra bit
+	for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+	{
+		const bool bSide = (ChannelAssignment == 8 && Channel == 1) || (ChannelAssignment == 9 && Channel == 0) ||
+						   (ChannelAssignment == 10 && Channel == 1);
+		ChannelSamples[Channel].SetNumUninitialized(BlockSize);
+		if (!DecodeSubframe(Reader, BlockSize, BitsPerSample + (bSide ? 1 : 0), ChannelSamples[Channel].GetData()))
+		{
+			return Fail();
+		}
+	}
+	Reader.AlignToByte();
+	// A frame that doesn't match its CRC-16 fails the decode rather than producing wrong audio
+	const int64 FrameSize = Reader.GetBytePosition();
+	const uint32 FrameCrc = Reader.Read(16);
+	if (Reader.HasOverrun() || FrameCrc != ComputeCrc16(Bytes.GetData() + FrameOffset, FrameSize))
+	{
+		return Fail();
+	}
+	FrameOffset += Reader.GetBytePosition();
+
+	// Undo stereo decorrelation
+	int32 *Left = ChannelSamples[0].GetData();
+	int32 *Right = NumChannels > 1 ? ChannelSamples[1].GetData() : nullptr;
+	if (ChannelAssignment == 8)
+	{
+		for (int32 i = 0; i < BlockSize; ++i)
+		{
+			Right[i] = Left[i] - Right[i];
+		}
+	}
+	else if (ChannelAssignment == 9)
+	{
+		for (int32 i = 0; i < BlockSize; ++i)
+		{
+			Left[i] += Right[i];
+		}
+	}
+	else if (ChannelAssignment == 10)
+	{
+		for (int32 i = 0; i < BlockSize; ++i)
+		{
+			const int32 Side = Right[i];
+			const int32 Mid = static_cast<int32>(static_cast<uint32>(Left[i]) << 1) | (Side & 1);
+			Left[i] = (Mid + Side) >> 1;
+			Right[i] = (Mid - Side) >> 1;
+		}
+	}
+
+	// Interleave at 16 bits
+	const int32 OutputChannels = GetNumChannels();
+	TArray<int16> &Interleaved = Downmix ? InterleavedBlock : DecodedBlock;
+	Interleaved.SetNumUninitialized(BlockSize * NumChannels);
+	for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+	{
+		const int32 *Samples = ChannelSamples[Channel].GetData();
+		int16 *Dst = Interleaved.GetData() + Channel;
+		if (BitsPerSample >= 16)
+		{
+			const int32 Shift = BitsPerSample - 16;
+			for (int32 i = 0; i < BlockSize; ++i)
+			{
+				Dst[i * NumChannels] = static_cast<int16>(Samples[i] >> Shift);
+			}
+		}
+		else
+		{
+			const int32 Shift = 16 - BitsPerSample;
+			for (int32 i = 0; i < BlockSize; ++i)
+			{
+				Dst[i * NumChannels] = static_cast<int16>(Samples[i] * (1 << Shift));
+			}
+		}
+	}
+	if (Downmix)
+	{
+		DecodedBlock.SetNumUninitialized(BlockSize * OutputChannels);
+		Downmix->Convert(reinterpret_cast<const uint8 *>(InterleavedBlock.GetData()), BlockSize,
+						 DecodedBlock.GetData());
+	}
+	DecodedFrames = BlockSize;
+	return true;
+}
@@ -0,0 +1,69 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncFlacDecoder.h
+ * Content     :   Native FLAC stream decoder
+ ******************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OVRLipSyncAudioDecoder.h"
+
+class FOVRLipSyncFileBuffer;
+class FOVRLipSyncPCMConverter;
+
+/**
+ * Decodes native FLAC streams (not Ogg FLAC) frame by frame. The engine has no runtime FLAC decoder, and the
+ * format is simple enough to decode directly: fixed and LPC predictors with Rice coded residuals.
+ */
+class FOVRLipSyncFlacDecoder : public IOVRLipSyncAudioDecoder
+{
+public:
+	// Largest channel count and block size allowed by the format
+	static constexpr int32 MaxChannels = 8;
+	static constexpr int32 MaxBlockSize = 65535;
+
+	/**
+	 * Read the stream header of a FLAC file.
+	 *
+	 * @param InFile The file contents, starting with the "fLaC" marker.
+	 * @param OutError Optional description of why the file can't be decoded.
+	 * @return The decoder, or nullptr if the file isn't a supported FLAC stream.
+	 */
+	static TUniquePtr<FOVRLipSyncFlacDecoder> Create(const TSharedRef<FOVRLipSyncFileBuffer> &InFile,
+													 FString *OutError = nullptr);
+
+	~FOVRLipSyncFlacDecoder();
+
+	int32 GetSampleRate() const override { return SampleRate; }
+	int32 GetNumChannels() const override;
+	int64 GetNumFrames() const override { return TotalFrames > 0 ? TotalFrames : INDEX_NONE; }
+	int32 Decode(int16 *OutSamples, int32 MaxFrames) override;
+
+private:
+	explicit FOVRLipSyncFlacDecoder(const TSharedRef<FOVRLipSyncFileBuffer> &InFile);
+
+	// Decode the next frame into DecodedBlock, returns false at the end of the stream or on error
+	bool DecodeFrame();
+
+	TSharedRef<FOVRLipSyncFileBuffer> File;
+	int32 SampleRate = 0;
+	int32 NumChannels = 0;
+	int32 BitsPerSample = 0;
+	int64 TotalFrames = 0;
+
+	// Byte offset of the next frame
+	int64 FrameOffset = 0;
+	bool bEndOfStream = false;
+	bool bError = false;
+
+	// Decoded samples of the current frame, per channel
+	TArray<int32> ChannelSamples[MaxChannels];
+	// Current frame as interleaved 16-bit samples in the output layout
+	TArray<int16> DecodedBlock;
+	TArray<int16> InterleavedBlock;
+	int32 DecodedFrames = 0;
+	int32 ConsumedFrames = 0;
+
+	// Downmix of streams with more than two channels
+	TUniquePtr<FOVRLipSyncPCMConverter> Downmix;
+};
@@ -0,0 +1,15 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncInferenceModule.cpp
+ * Content     :   Module linking the OVRLipSync SDK, for capture and cooking
+ ******************************************************************************/
+
+#include "Modules/ModuleManager.h"
+#include "OVRLipSync.h"
+
+class FOVRLipSyncInferenceModule : public IModuleInterface
+{
+public:
+	void ShutdownModule() override { ovrLipSync_Shutdown(); }
+};
+
+IMPLEMENT_MODULE(FOVRLipSyncInferenceModule, OVRLipSyncInference);
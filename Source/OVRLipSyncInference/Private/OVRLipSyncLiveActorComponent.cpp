@@ -25,7 +25,9 @@
 
 #include "AndroidPermissionCallbackProxy.h"
 #include "AndroidPermissionFunctionLibrary.h"
+#include "Misc/ScopeExit.h"
 #include "OVRLipSyncContextWrapper.h"
+#include "OVRLipSyncStats.h"
 #include "Runtime\Online\Voice/Public/VoiceModule.h"
 
 #include <Core.h>
@@ -35,6 +37,23 @@
 #define DEFAULT_DEVICE_NAME TEXT("Default Device")
 #endif
 
+DECLARE_CYCLE_STAT(TEXT("Voice Capture Update"), STAT_OVRLipSync_VoiceCaptureUpdate, STATGROUP_OVRLipSync);
+
+// Audio of a live stream handed to inference, and how long the capture update took
+UE_TRACE_EVENT_BEGIN(OVRLipSync, StreamFeed)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, StreamId)
+	UE_TRACE_EVENT_FIELD(uint32, NumSamples)
+	UE_TRACE_EVENT_FIELD(uint64, DurationCycles)
+UE_TRACE_EVENT_END()
+
+// Visemes of a live stream coming back from inference, and how long after the last feed
+UE_TRACE_EVENT_BEGIN(OVRLipSync, StreamResult)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, StreamId)
+	UE_TRACE_EVENT_FIELD(uint64, LatencyCycles)
+UE_TRACE_EVENT_END()
+
 // Convert OVRLipSyncProviderKind enum to OVRLipSync
 ovrLipSyncContextProvider ContextProviderFromProviderKind(OVRLipSyncProviderKind Kind)
 {
@@ -57,11 +76,21 @@ void UOVRLipSyncActorComponent::BeginPlay()
 
 	LipSyncContext = MakeShared<UOVRLipSyncContextWrapper>(ContextProviderFromProviderKind(ProviderKind), SampleRate,
 														   BufferSize, FString(), EnableHardwareAcceleration);
-	LipSyncContext->SetAsyncCallback([this](const TArray<float> &NewVisemes, float NewLaughterScore) {
-		Visemes = NewVisemes;
-		LaughterScore = NewLaughterScore;
-		OnVisemesReady.Broadcast();
-	});
+	LipSyncContext->SetAsyncCallback(
+		[this](const TArray<float> &NewVisemes, float NewLaughterScore, uint64 FeedCycles)
+		{
+			Visemes = NewVisemes;
+			LaughterScore = NewLaughterScore;
+			// Measured from the feed that produced this result, including the time it waited behind earlier ones
+			const uint64 ResultCycles = FPlatformTime::Cycles64();
+			const uint64 Latency = ResultCycles - FeedCycles;
+			LastLatencyCycles = Latency;
+			UE_TRACE_LOG(OVRLipSync, StreamResult, OVRLipSyncChannel)
+				<< StreamResult.Cycle(ResultCycles) << StreamResult.StreamId(GetUniqueID())
+				<< StreamResult.LatencyCycles(Latency);
+			INC_DWORD_STAT(STAT_OVRLipSync_Broadcasts);
+			OnVisemesReady.Broadcast();
+		});
 }
 
 void UOVRLipSyncActorComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -131,6 +160,9 @@ void UOVRLipSyncActorComponent::StartVoiceCapture()
 	}
 
 	VoiceCapture->Start();
+	ResetUpdateCounters();
+	LastLatencyCycles = 0;
+	INC_DWORD_STAT(STAT_OVRLipSync_ActiveStreams);
 	auto &TimerManager = GetWorld()->GetTimerManager();
 	TimerManager.SetTimer(VoiceCaptureTimer, this, &UOVRLipSyncActorComponent::OnVoiceCaptureTimer,
 						  VoiceCaptureTimerRate, true);
@@ -159,6 +191,7 @@ void UOVRLipSyncActorComponent::Stop()
 	TimerManager.ClearTimer(VoiceCaptureTimer);
 	VoiceCapture->Stop();
 	VoiceCapture = nullptr;
+	DEC_DWORD_STAT(STAT_OVRLipSync_ActiveStreams);
 
 	InitNeutralPose();
 }
@@ -166,15 +199,21 @@ void UOVRLipSyncActorComponent::Stop()
 // Called every VoiceCaptureTimerRate seconds (10ms) to process audio data
 void UOVRLipSyncActorComponent::OnVoiceCaptureTimer()
 {
+	SCOPE_CYCLE_COUNTER(STAT_OVRLipSync_VoiceCaptureUpdate);
+	TRACE_CPUPROFILER_EVENT_SCOPE(OVRLipSync::OnVoiceCaptureTimer);
+
 	if (!VoiceCapture || !VoiceCapture.IsValid())
 	{
 		return;
 	}
 
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	ON_SCOPE_EXIT { RecordUpdate(StartCycles); };
 	uint32 AvailableVoiceData = 0;
 	auto CaptureState = VoiceCapture->GetCaptureState(AvailableVoiceData);
 	if (CaptureState == EVoiceCaptureState::NoData)
 	{
+		INC_DWORD_STAT(STAT_OVRLipSync_FramesGated);
 		return;
 	}
 	if (CaptureState == EVoiceCaptureState::UnInitialized)
@@ -194,6 +233,7 @@ void UOVRLipSyncActorComponent::OnVoiceCaptureTimer()
 	}
 	if (AvailableVoiceData == 0)
 	{
+		INC_DWORD_STAT(STAT_OVRLipSync_FramesGated);
 		return;
 	}
 
@@ -210,6 +250,19 @@ void UOVRLipSyncActorComponent::OnVoiceCaptureTimer()
 	}
 	VoiceData.SetNum(VoiceDataCaptured);
 	FeedAudio(VoiceData);
+
+	UE_TRACE_LOG(OVRLipSync, StreamFeed, OVRLipSyncChannel)
+		<< StreamFeed.Cycle(StartCycles) << StreamFeed.StreamId(GetUniqueID())
+		<< StreamFeed.NumSamples(VoiceDataCaptured / sizeof(int16))
+		<< StreamFeed.DurationCycles(FPlatformTime::Cycles64() - StartCycles);
+}
+
+FString UOVRLipSyncActorComponent::GetDebugDetails() const
+{
+	return FString::Printf(TEXT("%s, %d frames queued, %.1f ms latency"),
+						   VoiceCapture ? TEXT("capturing") : TEXT("stopped"),
+						   LipSyncContext ? LipSyncContext->GetNumPendingFrames() : 0,
+						   FPlatformTime::ToMilliseconds64(LastLatencyCycles));
 }
 
 const float UOVRLipSyncActorComponent::VoiceCaptureTimerRate = .01f;
@@ -0,0 +1,311 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncLongFormCook.cpp
+ * Content     :   Checkpointed inference over multi-hour recordings
+ ******************************************************************************/
+
+#include "OVRLipSyncLongFormCook.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "OVRLipSyncAudioDecoder.h"
+#include "OVRLipSyncContextWrapper.h"
+
+namespace
+{
+constexpr uint32 SegmentMagic = 0x47534C4F; // "OLSG"
+constexpr int32 SegmentVersion = 1;
+constexpr int64 SegmentHeaderSize = sizeof(uint32) + 3 * sizeof(int32);
+
+bool Fail(FString *OutError, const TCHAR *Reason)
+{
+	if (OutError)
+	{
+		*OutError = Reason;
+	}
+	return false;
+}
+
+// Write to a temporary file first so an interrupted write never leaves a truncated file behind
+bool ReplaceFile(const FString &Path, TFunctionRef<bool(const FString &TempPath)> Write)
+{
+	const FString TempPath = Path + TEXT(".tmp");
+	if (!Write(TempPath))
+	{
+		IFileManager::Get().Delete(*TempPath, false, false, true);
+		return false;
+	}
+	return IFileManager::Get().Move(*Path, *TempPath, true, true);
+}
+} // namespace
+
+FOVRLipSyncLongFormCook::FOVRLipSyncLongFormCook(const FString &InCheckpointDirectory, const FString &InFingerprint,
+												 int32 InSegmentFrames)
+	: CheckpointDirectory(InCheckpointDirectory), Fingerprint(FMD5::HashAnsiString(*InFingerprint)),
+	  SegmentFrames(FMath::Max(InSegmentFrames, 1))
+{
+}
+
+bool FOVRLipSyncLongFormCook::Run(IOVRLipSyncAudioDecoder &Decoder, const FString &ModelPath,
+								  TFunctionRef<bool(int64 FramesDone, int64 TotalFrames)> Progress, FString *OutError)
+{
+	IFileManager &FileManager = IFileManager::Get();
+
+	bool bComplete = false;
+	CompletedSegments = ReadCheckpoint(bComplete);
+	if (CompletedSegments == 0)
+	{
+		// Segments left by a cook of other audio or with other settings
+		FileManager.DeleteDirectory(*CheckpointDirectory, false, true);
+	}
+	if (!FileManager.MakeDirectory(*CheckpointDirectory, true))
+	{
+		return Fail(OutError, TEXT("failed to create the checkpoint directory"));
+	}
+	if (bComplete)
+	{
+		return true;
+	}
+
+	const int32 SampleRate = Decoder.GetSampleRate();
+	const int32 NumChannels = Decoder.GetNumChannels();
+	if (SampleRate < FramesPerSecond)
+	{
+		return Fail(OutError, TEXT("sample rate is too low"));
+	}
+	const int64 TotalFrames = Decoder.GetNumFrames() == INDEX_NONE
+								  ? int64(INDEX_NONE)
+								  : Decoder.GetNumFrames() * FramesPerSecond / SampleRate;
+
+	TArray<int16> DecodedChunk;
+	DecodedChunk.SetNumUninitialized((SampleRate / FramesPerSecond + 1) * NumChannels);
+	const int16 *Samples = nullptr;
+
+	// Audio of completed segments is decoded and dropped, which is far cheaper than inference
+	const int64 ResumeFrame = static_cast<int64>(CompletedSegments) * SegmentFrames;
+	const int64 PreRollStart = FMath::Max<int64>(0, ResumeFrame - PreRollFrames);
+	for (int64 Frame = 0; Frame < PreRollStart; ++Frame)
+	{
+		const int32 FrameSamples = GetFrameSamples(Frame, SampleRate);
+		if (Decoder.DecodeView(DecodedChunk.GetData(), FrameSamples, Samples) != FrameSamples)
+		{
+			return Fail(OutError, TEXT("audio is shorter than the checkpoint"));
+		}
+	}
+
+	UOVRLipSyncContextWrapper Context(ovrLipSyncContextProvider_Enhanced, SampleRate, 4096, ModelPath);
+	TArray<float> Visemes;
+	float LaughterScore = 0.0f;
+	int32 FrameDelayInMs = 0;
+
+	for (int64 Frame = PreRollStart; Frame < ResumeFrame; ++Frame)
+	{
+		const int32 FrameSamples = GetFrameSamples(Frame, SampleRate);
+		if (Decoder.DecodeView(DecodedChunk.GetData(), FrameSamples, Samples) != FrameSamples)
+		{
+			return Fail(OutError, TEXT("audio is shorter than the checkpoint"));
+		}
+		Context.ProcessFrame(Samples, FrameSamples, Visemes, LaughterScore, FrameDelayInMs, NumChannels > 1);
+	}
+
+	// Visemes followed by the laughter score of each frame in the current segment
+	TArray<float> SegmentData;
+	int32 SegmentFrameCount = 0;
+	int32 NumVisemes = 0;
+	int64 FramesDone = ResumeFrame;
+
+	// A trailing partial frame is dropped, as in the in-memory cook
+	int32 FrameSamples = GetFrameSamples(FramesDone, SampleRate);
+	int32 DecodedFrames = 0;
+	while ((DecodedFrames = Decoder.DecodeView(DecodedChunk.GetData(), FrameSamples, Samples)) == FrameSamples)
+	{
+		Context.ProcessFrame(Samples, FrameSamples, Visemes, LaughterScore, FrameDelayInMs, NumChannels > 1);
+		NumVisemes = Visemes.Num();
+		SegmentData.Append(Visemes);
+		SegmentData.Add(LaughterScore);
+		FrameSamples = GetFrameSamples(++FramesDone, SampleRate);
+
+		if (++SegmentFrameCount == SegmentFrames)
+		{
+			if (!WriteSegment(CompletedSegments, SegmentData, SegmentFrameCount, NumVisemes))
+			{
+				return Fail(OutError, TEXT("failed to write a segment"));
+			}
+			++CompletedSegments;
+			if (!WriteCheckpoint(false))
+			{
+				return Fail(OutError, TEXT("failed to write the checkpoint"));
+			}
+			SegmentData.Reset();
+			SegmentFrameCount = 0;
+		}
+
+		if (!Progress(FramesDone, TotalFrames))
+		{
+			return Fail(OutError, TEXT("cancelled"));
+		}
+	}
+	if (DecodedFrames == INDEX_NONE)
+	{
+		return Fail(OutError, TEXT("audio data is corrupt"));
+	}
+
+	if (SegmentFrameCount > 0)
+	{
+		if (!WriteSegment(CompletedSegments, SegmentData, SegmentFrameCount, NumVisemes))
+		{
+			return Fail(OutError, TEXT("failed to write a segment"));
+		}
+		++CompletedSegments;
+	}
+	if (!WriteCheckpoint(true))
+	{
+		return Fail(OutError, TEXT("failed to write the checkpoint"));
+	}
+	return true;
+}
+
+bool FOVRLipSyncLongFormCook::LoadFrames(TArray<TArray<float>> &OutVisemeFrames, TArray<float> &OutLaughterScores,
+										 FString *OutError) const
+{
+	OutVisemeFrames.Reset(CompletedSegments * SegmentFrames);
+	OutLaughterScores.Reset(CompletedSegments * SegmentFrames);
+
+	TArray<float> SegmentData;
+	for (int32 Segment = 0; Segment < CompletedSegments; ++Segment)
+	{
+		TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*GetSegmentPath(Segment)));
+		if (!Reader)
+		{
+			return Fail(OutError, TEXT("failed to open a segment"));
+		}
+
+		uint32 Magic = 0;
+		int32 Version = 0;
+		int32 NumFrames = 0;
+		int32 NumVisemes = 0;
+		*Reader << Magic << Version << NumFrames << NumVisemes;
+		const int64 DataSize = static_cast<int64>(NumFrames) * (NumVisemes + 1) * sizeof(float);
+		if (Reader->IsError() || Magic != SegmentMagic || Version != SegmentVersion || NumFrames <= 0 ||
+			NumFrames > SegmentFrames || NumVisemes < 0 || Reader->TotalSize() != SegmentHeaderSize + DataSize)
+		{
+			return Fail(OutError, TEXT("segment is corrupt"));
+		}
+
+		SegmentData.SetNumUninitialized(NumFrames * (NumVisemes + 1));
+		Reader->Serialize(SegmentData.GetData(), DataSize);
+		if (!Reader->Close())
+		{
+			return Fail(OutError, TEXT("failed to read a segment"));
+		}
+
+		const float *Frame = SegmentData.GetData();
+		for (int32 Index = 0; Index < NumFrames; ++Index, Frame += NumVisemes + 1)
+		{
+			OutVisemeFrames.Emplace(Frame, NumVisemes);
+			OutLaughterScores.Add(Frame[NumVisemes]);
+		}
+	}
+	return true;
+}
+
+void FOVRLipSyncLongFormCook::Cleanup() const
+{
+	IFileManager::Get().DeleteDirectory(*CheckpointDirectory, false, true);
+}
+
+FString FOVRLipSyncLongFormCook::GetSegmentPath(int32 Segment) const
+{
+	return FPaths::Combine(CheckpointDirectory, FString::Printf(TEXT("segment_%05d.bin"), Segment));
+}
+
+FString FOVRLipSyncLongFormCook::GetCheckpointPath() const
+{
+	return FPaths::Combine(CheckpointDirectory, TEXT("checkpoint.txt"));
+}
+
+int32 FOVRLipSyncLongFormCook::ReadCheckpoint(bool &bOutComplete) const
+{
+	bOutComplete = false;
+
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *GetCheckpointPath()))
+	{
+		return 0;
+	}
+
+	FString CheckpointFingerprint;
+	int32 CheckpointSegmentFrames = 0;
+	int32 Segments = 0;
+	bool bComplete = false;
+	for (const FString &Line : Lines)
+	{
+		FString Key, Value;
+		if (!Line.Split(TEXT("="), &Key, &Value))
+		{
+			continue;
+		}
+		if (Key == TEXT("Fingerprint"))
+		{
+			CheckpointFingerprint = Value;
+		}
+		else if (Key == TEXT("SegmentFrames"))
+		{
+			CheckpointSegmentFrames = FCString::Atoi(*Value);
+		}
+		else if (Key == TEXT("CompletedSegments"))
+		{
+			Segments = FCString::Atoi(*Value);
+		}
+		else if (Key == TEXT("Complete"))
+		{
+			bComplete = Value == TEXT("1");
+		}
+	}
+	if (CheckpointFingerprint != Fingerprint || CheckpointSegmentFrames != SegmentFrames)
+	{
+		return 0;
+	}
+
+	// Only trust segments that are still there, a missing one forces everything after it to be redone
+	for (int32 Segment = 0; Segment < Segments; ++Segment)
+	{
+		if (!IFileManager::Get().FileExists(*GetSegmentPath(Segment)))
+		{
+			return Segment;
+		}
+	}
+	bOutComplete = bComplete;
+	return FMath::Max(Segments, 0);
+}
+
+bool FOVRLipSyncLongFormCook::WriteCheckpoint(bool bComplete) const
+{
+	const FString Contents =
+		FString::Printf(TEXT("Fingerprint=%s\nSegmentFrames=%d\nCompletedSegments=%d\nComplete=%d\n"), *Fingerprint,
+						SegmentFrames, CompletedSegments, bComplete ? 1 : 0);
+	return ReplaceFile(GetCheckpointPath(), [&Contents](const FString &TempPath)
+					   { return FFileHelper::SaveStringToFile(Contents, *TempPath); });
+}
+
+bool FOVRLipSyncLongFormCook::WriteSegment(int32 Segment, const TArray<float> &Frames, int32 NumFrames,
+										   int32 NumVisemes) const
+{
+	return ReplaceFile(GetSegmentPath(Segment),
+					   [&Frames, NumFrames, NumVisemes](const FString &TempPath)
+					   {
+						   TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempPath));
+						   if (!Writer)
+						   {
+							   return false;
+						   }
+						   uint32 Magic = SegmentMagic;
+						   int32 Version = SegmentVersion;
+						   int32 FrameCount = NumFrames;
+						   int32 VisemeCount = NumVisemes;
+						   *Writer << Magic << Version << FrameCount << VisemeCount;
+						   Writer->Serialize(const_cast<float *>(Frames.GetData()), Frames.Num() * sizeof(float));
+						   return Writer->Close();
+					   });
+}
@@ -0,0 +1,214 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncPostProcessCore.cpp
+ * Content     :   Engine independent steps of the viseme post-processing
+ ******************************************************************************/
+
+#include "OVRLipSyncPostProcessCore.h"
+
+#include <algorithm>
+
+namespace OVRLipSyncCore
+{
+namespace
+{
+// Priority of each viseme when picking the dominant one of a block, 1 for visemes not listed
+constexpr float VisemePriorities[] = {
+	1.0f, // sil
+	0.9f, // PP
+	0.7f, // FF
+	0.6f, // TH
+	0.7f, // DD
+	0.7f, // kk
+	0.8f, // CH
+	0.6f, // SS
+	0.7f, // nn
+	0.9f, // RR
+	1.0f, // aa
+	0.6f, // E
+	0.5f, // ih
+	0.9f, // oh
+	1.0f, // ou
+};
+constexpr int NumVisemePriorities = sizeof(VisemePriorities) / sizeof(VisemePriorities[0]);
+
+float GetVisemePriority(int Viseme) { return Viseme < NumVisemePriorities ? VisemePriorities[Viseme] : 1.0f; }
+
+bool IsConsonant(int Viseme) { return Viseme >= 1 && Viseme <= 9; }
+
+// Same result as FMath::Clamp(Value, 0, 1), NaN included
+float Clamp01(float Value) { return Value < 0.0f ? 0.0f : Value < 1.0f ? Value : 1.0f; }
+} // namespace
+
+int GetBlockFrames(const FPostProcessSettings &Settings)
+{
+	return std::min(std::max(Settings.MaxInterpolationFrames, 1), 24);
+}
+
+void FilterShortVisemes(FScoreBuffer &Buffer, const FPostProcessSettings &Settings)
+{
+	for (int i = 0; i < Buffer.NumVisemes; ++i)
+	{
+		int Start = -1;
+		for (int f = 0; f < Buffer.NumFrames; ++f)
+		{
+			if (Buffer.GetFrame(f)[i] > 0.5f)
+			{
+				if (Start == -1)
+				{
+					Start = f;
+				}
+			}
+			else if (Start != -1)
+			{
+				// Visemes still held at the end of the track are kept
+				if (f - Start < Settings.MinHoldFrames)
+				{
+					for (int r = Start; r < f; ++r)
+					{
+						Buffer.GetFrame(r)[i] = 0.0f;
+					}
+				}
+				Start = -1;
+			}
+		}
+	}
+}
+
+void ClusterBlocks(const FScoreBuffer &Buffer, const FPostProcessSettings &Settings, FBlockDominants &OutDominants)
+{
+	const int BlockFrames = GetBlockFrames(Settings);
+	const int NumBlocks = (Buffer.NumFrames + BlockFrames - 1) / BlockFrames;
+	OutDominants.Visemes.assign(NumBlocks, -1);
+	OutDominants.Peaks.assign(NumBlocks, 0.0f);
+
+	std::vector<float> Sums(Buffer.NumVisemes);
+	for (int Block = 0; Block < NumBlocks; ++Block)
+	{
+		const int BlockStart = Block * BlockFrames;
+		const int BlockEnd = std::min(BlockStart + BlockFrames, Buffer.NumFrames);
+
+		// Frame by frame so the buffer is read in order, each sum still adds its frames in order
+		std::fill(Sums.begin(), Sums.end(), 0.0f);
+		for (int f = BlockStart; f < BlockEnd; ++f)
+		{
+			const float *Frame = Buffer.GetFrame(f);
+			for (int j = 0; j < Buffer.NumVisemes; ++j)
+			{
+				Sums[j] += Frame[j];
+			}
+		}
+
+		int Dominant = -1;
+		float MaxSum = 0.0f;
+		for (int j = 0; j < Buffer.NumVisemes; ++j)
+		{
+			const float Sum = Sums[j] * GetVisemePriority(j);
+			if (Sum > MaxSum)
+			{
+				MaxSum = Sum;
+				Dominant = j;
+			}
+		}
+		if (Dominant < 0)
+		{
+			continue;
+		}
+
+		float Peak = 0.0f;
+		for (int f = BlockStart; f < BlockEnd; ++f)
+		{
+			Peak = std::max(Peak, Buffer.GetFrame(f)[Dominant]);
+		}
+		OutDominants.Visemes[Block] = Dominant;
+		OutDominants.Peaks[Block] = Peak;
+	}
+}
+
+void ApplyDominants(FScoreBuffer &Buffer, const FPostProcessSettings &Settings, const FBlockDominants &Dominants)
+{
+	const int BlockFrames = GetBlockFrames(Settings);
+	const int NumBlocks = static_cast<int>(Dominants.Visemes.size());
+	for (int Block = 0; Block < NumBlocks; ++Block)
+	{
+		const float Peak = Dominants.Peaks[Block];
+		if (Peak <= 0.0001f)
+		{
+			continue;
+		}
+		const float Scale = 1.0f / Peak;
+		const int Dominant = Dominants.Visemes[Block];
+		// Neighbouring dominants are kept in the half of the block closest to them
+		const int Previous = Block > 0 ? Dominants.Visemes[Block - 1] : -1;
+		const int Next = Block < NumBlocks - 1 ? Dominants.Visemes[Block + 1] : -1;
+
+		const int BlockStart = Block * BlockFrames;
+		const int BlockEnd = std::min(BlockStart + BlockFrames, Buffer.NumFrames);
+		for (int f = BlockStart; f < BlockEnd; ++f)
+		{
+			const bool bFirstHalf = f - BlockStart < BlockFrames / 2;
+			const int Kept = bFirstHalf ? Previous : Next;
+			float *Frame = Buffer.GetFrame(f);
+			for (int j = 0; j < Buffer.NumVisemes; ++j)
+			{
+				if (j == Dominant)
+				{
+					Frame[j] = Clamp01(Frame[j] * Scale);
+				}
+				else if (j != Kept)
+				{
+					Frame[j] = 0.0f;
+				}
+			}
+		}
+	}
+}
+
+void Smooth(const FScoreBuffer &Buffer, const FPostProcessSettings &Settings, FScoreBuffer &OutBuffer)
+{
+	OutBuffer.Init(Buffer.NumFrames, Buffer.NumVisemes);
+	if (!Settings.bEnableInterpolation)
+	{
+		OutBuffer.Scores = Buffer.Scores;
+		return;
+	}
+
+	// Weight of the frame j + 1 frames back, and the total weight of a frame with n previous frames, summed in the
+	// same order as the per-frame loop so the results are identical
+	const int BlockFrames = GetBlockFrames(Settings);
+	std::vector<float> Weights(BlockFrames);
+	std::vector<float> TotalWeights(BlockFrames + 1);
+	TotalWeights[0] = 1.0f;
+	for (int j = 0; j < BlockFrames; ++j)
+	{
+		Weights[j] = 1.0f - static_cast<float>(j + 1) / (BlockFrames + 1);
+		TotalWeights[j + 1] = TotalWeights[j] + Weights[j];
+	}
+
+	const int NumVisemes = Buffer.NumVisemes;
+	if (Buffer.NumFrames > 0)
+	{
+		std::copy(Buffer.GetFrame(0), Buffer.GetFrame(0) + NumVisemes, OutBuffer.GetFrame(0));
+	}
+	for (int f = 1; f < Buffer.NumFrames; ++f)
+	{
+		const float *Current = Buffer.GetFrame(f);
+		float *Smoothed = OutBuffer.GetFrame(f);
+		const int NumPrevious = std::min(f, BlockFrames);
+		for (int i = 0; i < NumVisemes; ++i)
+		{
+			float WeightedSum = Current[i];
+			for (int j = 0; j < NumPrevious; ++j)
+			{
+				WeightedSum += Buffer.GetFrame(f - 1 - j)[i] * Weights[j];
+			}
+			float Value = WeightedSum / TotalWeights[NumPrevious];
+
+			if (Settings.bStrictConsonantLock && IsConsonant(i) && Current[i] > 0.5f)
+			{
+				Value = Clamp01(Value * (1.0f / Current[i]));
+			}
+			Smoothed[i] = Value;
+		}
+	}
+}
+} // namespace OVRLipSyncCore
@@ -0,0 +1,65 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncPostProcessCore.h
+ * Content     :   Engine independent steps of the viseme post-processing
+ ******************************************************************************/
+
+#pragma once
+
+// Standard C++ only, built, benchmarked and tested outside the engine by Tools/PostProcessCore.
+// FOVRLipSyncVisemePostProcess adapts the steps to sequences.
+#include <cstddef>
+#include <vector>
+
+namespace OVRLipSyncCore
+{
+// Plain copy of FVisemeInterpolationSettings
+struct FPostProcessSettings
+{
+	bool bEnableInterpolation = true;
+	int MaxInterpolationFrames = 6;
+	int MinHoldFrames = 2;
+	bool bStrictConsonantLock = true;
+};
+
+/**
+ * Scores of every frame of a track, one frame after the other, NumVisemes floats each. One contiguous buffer instead
+ * of an array per frame, so the steps below walk memory in order.
+ */
+struct FScoreBuffer
+{
+	std::vector<float> Scores;
+	int NumFrames = 0;
+	int NumVisemes = 0;
+
+	void Init(int InNumFrames, int InNumVisemes)
+	{
+		NumFrames = InNumFrames;
+		NumVisemes = InNumVisemes;
+		Scores.assign(static_cast<size_t>(InNumFrames) * InNumVisemes, 0.0f);
+	}
+	float *GetFrame(int Frame) { return Scores.data() + static_cast<size_t>(Frame) * NumVisemes; }
+	const float *GetFrame(int Frame) const { return Scores.data() + static_cast<size_t>(Frame) * NumVisemes; }
+};
+
+// Dominant viseme of each block of frames, -1 when the block is silent, and its peak score
+struct FBlockDominants
+{
+	std::vector<int> Visemes;
+	std::vector<float> Peaks;
+};
+
+// Frames per block, MaxInterpolationFrames clamped to 1-24
+int GetBlockFrames(const FPostProcessSettings &Settings);
+
+// Step 1: zero visemes held above 0.5 for less than MinHoldFrames
+void FilterShortVisemes(FScoreBuffer &Buffer, const FPostProcessSettings &Settings);
+
+// Step 2: find the dominant viseme of each block, weighted by its priority
+void ClusterBlocks(const FScoreBuffer &Buffer, const FPostProcessSettings &Settings, FBlockDominants &OutDominants);
+
+// Step 3: scale the dominant viseme of each block to its peak, keep the neighbouring dominants at block edges
+void ApplyDominants(FScoreBuffer &Buffer, const FPostProcessSettings &Settings, const FBlockDominants &Dominants);
+
+// Step 4: blend each frame with the previous ones, writing every frame to OutBuffer
+void Smooth(const FScoreBuffer &Buffer, const FPostProcessSettings &Settings, FScoreBuffer &OutBuffer);
+} // namespace OVRLipSyncCore
@@ -0,0 +1,42 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncReferencePostProcess.cpp
+ * Content     :   Frozen copy of the viseme post-processing, the reference of the golden tests
+ ******************************************************************************/
+
+#include "OVRLipSyncReferencePostProcess.h"
+
+#include "CookFrameSequenceAsync.h"
+#include "OVRLipSyncFrame.h"
+#include "OVRLipSyncReferencePostProcessCore.h"
+
+void FOVRLipSyncReferencePostProcess::Apply(TArray<TArray<float>> &RawVisemeFrames,
+											const TArray<float> &LaughterScores,
+											const FVisemeInterpolationSettings &Settings,
+											TArray<FOVRLipSyncFrame> &OutFrames)
+{
+	OVRLipSyncCore::FPostProcessSettings CoreSettings;
+	CoreSettings.bEnableInterpolation = Settings.bEnableInterpolation;
+	CoreSettings.MaxInterpolationFrames = Settings.MaxInterpolationFrames;
+	CoreSettings.MinHoldFrames = Settings.MinHoldFrames;
+	CoreSettings.bStrictConsonantLock = Settings.bStrictConsonantLock;
+
+	std::vector<std::vector<float>> Frames(RawVisemeFrames.Num());
+	for (int32 Frame = 0; Frame < RawVisemeFrames.Num(); ++Frame)
+	{
+		Frames[Frame].assign(RawVisemeFrames[Frame].GetData(),
+							 RawVisemeFrames[Frame].GetData() + RawVisemeFrames[Frame].Num());
+	}
+
+	std::vector<std::vector<float>> Smoothed;
+	OVRLipSyncCore::ReferenceApply(Frames, CoreSettings, Smoothed);
+
+	// The raw frames are modified in place, as by Apply
+	OutFrames.Reserve(OutFrames.Num() + static_cast<int32>(Smoothed.size()));
+	for (int32 Frame = 0; Frame < RawVisemeFrames.Num(); ++Frame)
+	{
+		FMemory::Memcpy(RawVisemeFrames[Frame].GetData(), Frames[Frame].data(),
+						RawVisemeFrames[Frame].Num() * sizeof(float));
+		OutFrames.Emplace(TArray<float>(Smoothed[Frame].data(), static_cast<int32>(Smoothed[Frame].size())),
+						  LaughterScores[Frame]);
+	}
+}
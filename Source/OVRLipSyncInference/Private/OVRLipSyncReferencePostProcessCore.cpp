@@ -0,0 +1,238 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncReferencePostProcessCore.cpp
+ * Content     :   Frozen copy of the viseme post-processing, the reference of the golden and equivalence tests
+ ******************************************************************************/
+
+#include "OVRLipSyncReferencePostProcessCore.h"
+
+#include <algorithm>
+#include <map>
+
+// Keep this file as it is: optimised implementations are checked against it, not against each other. Copied from
+// FOVRLipSyncVisemePostProcess::Apply before any optimisation, with the engine containers swapped for std ones.
+
+namespace OVRLipSyncCore
+{
+namespace
+{
+enum class EVisemeType
+{
+	Vowel,
+	Consonant,
+	Other
+};
+
+EVisemeType GetVisemeType(int Index)
+{
+	switch (Index)
+	{
+	case 10:
+	case 11:
+	case 12:
+	case 13:
+	case 14:
+		return EVisemeType::Vowel;
+	case 1:
+	case 2:
+	case 3:
+	case 4:
+	case 5:
+	case 6:
+	case 7:
+	case 8:
+	case 9:
+		return EVisemeType::Consonant;
+	default:
+		return EVisemeType::Other;
+	}
+}
+
+// Same as FMath::Clamp
+template <typename T> T Clamp(T Value, T Min, T Max) { return Value < Min ? Min : Value < Max ? Value : Max; }
+} // namespace
+
+void ReferenceApply(std::vector<std::vector<float>> &RawVisemeFrames, const FPostProcessSettings &Settings,
+					std::vector<std::vector<float>> &OutFrames)
+{
+	const int NumRawFrames = static_cast<int>(RawVisemeFrames.size());
+	const int NumInterpolationFrames = Clamp(Settings.MaxInterpolationFrames, 1, 24);
+	const int NumVisemes = NumRawFrames > 0 ? static_cast<int>(RawVisemeFrames[0].size()) : 0;
+	std::vector<std::vector<float>> FrameBuffer;
+
+	// Step 1: filter out short visemes
+	for (int i = 0; i < NumVisemes; ++i)
+	{
+		int Start = -1;
+		for (int f = 0; f < NumRawFrames; ++f)
+		{
+			float value = RawVisemeFrames[f][i];
+			if (value > 0.5f)
+			{
+				if (Start == -1)
+					Start = f;
+			}
+			else if (Start != -1)
+			{
+				int Duration = f - Start;
+				if (Duration < Settings.MinHoldFrames)
+				{
+					for (int r = Start; r < f; ++r)
+						RawVisemeFrames[r][i] = 0.0f;
+				}
+				Start = -1;
+			}
+		}
+	}
+
+	// Step 2: cluster into blocks and scale dominant viseme (with priority)
+	std::vector<int> BlockDominants;
+	std::vector<float> BlockPeaks;
+
+	std::map<int, float> VisemePriority = {
+		{10, 1.0f}, // aa
+		{11, 0.6f}, // E
+		{12, 0.5f}, // ih
+		{13, 0.9f}, // oh
+		{14, 1.0f}, // ou
+		{1, 0.9f},  // PP
+		{2, 0.7f},  // FF
+		{3, 0.6f},  // TH
+		{4, 0.7f},  // DD
+		{5, 0.7f},  // kk
+		{6, 0.8f},  // CH
+		{7, 0.6f},  // SS
+		{8, 0.7f},  // nn
+		{9, 0.9f}	  // RR
+	};
+
+	for (int blockStart = 0; blockStart < NumRawFrames; blockStart += NumInterpolationFrames)
+	{
+		int blockEnd = std::min(blockStart + NumInterpolationFrames, NumRawFrames);
+
+		int DominantIndex = -1;
+		float MaxSum = 0.0f;
+
+		for (int j = 0; j < NumVisemes; ++j)
+		{
+			float Priority = VisemePriority.count(j) ? VisemePriority[j] : 1.0f;
+			float Sum = 0.0f;
+			for (int f = blockStart; f < blockEnd; ++f)
+				Sum += RawVisemeFrames[f][j];
+
+			Sum *= Priority;
+
+			if (Sum > MaxSum)
+			{
+				MaxSum = Sum;
+				DominantIndex = j;
+			}
+		}
+
+		if (DominantIndex < 0)
+		{
+			BlockDominants.push_back(-1);
+			BlockPeaks.push_back(0.0f);
+			continue;
+		}
+
+		BlockDominants.push_back(DominantIndex);
+
+		float PeakValue = 0.0f;
+		for (int f = blockStart; f < blockEnd; ++f)
+		{
+			float value = RawVisemeFrames[f][DominantIndex];
+			if (value > PeakValue)
+				PeakValue = value;
+		}
+		BlockPeaks.push_back(PeakValue);
+	}
+
+	// Step 3: apply scaled dominant viseme in block, preserve neighbors
+	const int NumBlocks = static_cast<int>(BlockDominants.size());
+	for (int blockIndex = 0; blockIndex < NumBlocks; ++blockIndex)
+	{
+		int blockStart = blockIndex * NumInterpolationFrames;
+		int blockEnd = std::min(blockStart + NumInterpolationFrames, NumRawFrames);
+
+		int DominantIndex = BlockDominants[blockIndex];
+		float Peak = BlockPeaks[blockIndex];
+		if (Peak <= 0.0001f)
+			continue;
+
+		float Scale = 1.0f / Peak;
+
+		int PrevDominant = (blockIndex > 0) ? BlockDominants[blockIndex - 1] : -1;
+		int NextDominant = (blockIndex < NumBlocks - 1) ? BlockDominants[blockIndex + 1] : -1;
+
+		bool IsFirstBlock = (blockIndex == 0);
+		bool IsLastBlock = (blockIndex == NumBlocks - 1);
+
+		for (int f = blockStart; f < blockEnd; ++f)
+		{
+			int localIndex = f - blockStart;
+			for (int j = 0; j < static_cast<int>(RawVisemeFrames[f].size()); ++j)
+			{
+				bool bPreserve =
+					(j == DominantIndex) ||
+					(j == PrevDominant && localIndex < NumInterpolationFrames / 2 && !IsFirstBlock) ||
+					(j == NextDominant && localIndex >= NumInterpolationFrames / 2 && !IsLastBlock);
+
+				if (bPreserve)
+				{
+					if (j == DominantIndex)
+						RawVisemeFrames[f][j] = Clamp(RawVisemeFrames[f][j] * Scale, 0.0f, 1.0f);
+				}
+				else
+				{
+					RawVisemeFrames[f][j] = 0.0f;
+				}
+			}
+		}
+	}
+
+	// Step 4: final smoothing
+	for (int f = 0; f < NumRawFrames; ++f)
+	{
+		const std::vector<float> &Current = RawVisemeFrames[f];
+
+		if (Settings.bEnableInterpolation && FrameBuffer.size() > 0)
+		{
+			std::vector<float> Smoothed;
+			for (int i = 0; i < static_cast<int>(Current.size()); ++i)
+			{
+				float WeightedSum = Current[i];
+				float TotalWeight = 1.0f;
+
+				for (int j = 0; j < static_cast<int>(FrameBuffer.size()); ++j)
+				{
+					float Weight = 1.0f - static_cast<float>(j + 1) / (NumInterpolationFrames + 1);
+					WeightedSum += FrameBuffer[j][i] * Weight;
+					TotalWeight += Weight;
+				}
+
+				float Value = WeightedSum / TotalWeight;
+
+				if (Settings.bStrictConsonantLock && GetVisemeType(i) == EVisemeType::Consonant &&
+					Current[i] > 0.5f)
+				{
+					float Scale = 1.0f / Current[i];
+					Value = Clamp(Value * Scale, 0.0f, 1.0f);
+				}
+
+				Smoothed.push_back(Value);
+			}
+			OutFrames.push_back(Smoothed);
+		}
+		else
+		{
+			OutFrames.push_back(Current);
+		}
+
+		FrameBuffer.insert(FrameBuffer.begin(), Current);
+		if (static_cast<int>(FrameBuffer.size()) > NumInterpolationFrames)
+		{
+			FrameBuffer.pop_back();
+		}
+	}
+}
+} // namespace OVRLipSyncCore
@@ -0,0 +1,26 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncReferencePostProcessCore.h
+ * Content     :   Frozen copy of the viseme post-processing, the reference of the golden and equivalence tests
+ ******************************************************************************/
+
+#pragma once
+
+// Standard C++ only, so the editor golden harness (through FOVRLipSyncReferencePostProcess) and the equivalence test
+// of Tools/PostProcessCore judge candidates against the same code.
+#include "OVRLipSyncPostProcessCore.h"
+
+#include <vector>
+
+namespace OVRLipSyncCore
+{
+/**
+ * The viseme post-processing as it was before it was optimised, one array per frame. The steps of
+ * OVRLipSyncPostProcessCore.h and the registered candidates must produce the same frames.
+ *
+ * @param RawVisemeFrames Viseme scores of each frame, modified in place like the original.
+ * @param Settings Interpolation settings.
+ * @param OutFrames Receives one smoothed frame per raw frame.
+ */
+void ReferenceApply(std::vector<std::vector<float>> &RawVisemeFrames, const FPostProcessSettings &Settings,
+					std::vector<std::vector<float>> &OutFrames);
+} // namespace OVRLipSyncCore
@@ -0,0 +1,152 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncResamplingDecoder.cpp
+ * Content     :   Downmixes and resamples decoded audio ahead of inference
+ ******************************************************************************/
+
+#include "OVRLipSyncResamplingDecoder.h"
+
+namespace
+{
+FOVRLipSyncWaveFormat MakeFloatFormat(int32 SampleRate, int32 NumChannels)
+{
+	FOVRLipSyncWaveFormat Format;
+	Format.Encoding = EOVRLipSyncSampleEncoding::Float;
+	Format.NumChannels = NumChannels;
+	Format.SampleRate = SampleRate;
+	Format.BitsPerSample = 32;
+	Format.BlockAlign = NumChannels * sizeof(float);
+	return Format;
+}
+} // namespace
+
+FOVRLipSyncResamplingDecoder::FOVRLipSyncResamplingDecoder(TUniquePtr<IOVRLipSyncAudioDecoder> &&InSource,
+														   int32 InNumChannels, int32 InSampleRate,
+														   Audio::EResamplingMethod Method)
+	: Source(MoveTemp(InSource)), NumChannels(InNumChannels), SampleRate(InSampleRate),
+	  Ratio(static_cast<float>(InSampleRate) / Source->GetSampleRate()),
+	  Quantizer(MakeFloatFormat(InSampleRate, InNumChannels), InNumChannels)
+{
+	Resampler.Init(Method, Ratio, NumChannels);
+	SourceBlock.SetNumUninitialized(BlockFrames * Source->GetNumChannels());
+	Input.SetNumUninitialized(BlockFrames * NumChannels);
+}
+
+TUniquePtr<IOVRLipSyncAudioDecoder> FOVRLipSyncResamplingDecoder::Wrap(TUniquePtr<IOVRLipSyncAudioDecoder> &&Source,
+																	   bool bDownmixToMono, int32 TargetSampleRate,
+																	   Audio::EResamplingMethod Method)
+{
+	const int32 OutputChannels = bDownmixToMono ? 1 : Source->GetNumChannels();
+	const int32 OutputSampleRate = TargetSampleRate > 0 ? TargetSampleRate : Source->GetSampleRate();
+	if (OutputChannels == Source->GetNumChannels() && OutputSampleRate == Source->GetSampleRate())
+	{
+		return MoveTemp(Source);
+	}
+	return TUniquePtr<IOVRLipSyncAudioDecoder>(
+		new FOVRLipSyncResamplingDecoder(MoveTemp(Source), OutputChannels, OutputSampleRate, Method));
+}
+
+int64 FOVRLipSyncResamplingDecoder::GetNumFrames() const
+{
+	const int64 SourceFrames = Source->GetNumFrames();
+	return SourceFrames == INDEX_NONE ? INDEX_NONE : static_cast<int64>(SourceFrames * static_cast<double>(Ratio));
+}
+
+int32 FOVRLipSyncResamplingDecoder::Decode(int16 *OutSamples, int32 MaxFrames)
+{
+	int32 Frames = 0;
+	while (Frames < MaxFrames)
+	{
+		if (ConsumedFrames == OutputFrames && !Refill())
+		{
+			if (bError)
+			{
+				return INDEX_NONE;
+			}
+			break;
+		}
+		const int32 Count = FMath::Min(MaxFrames - Frames, OutputFrames - ConsumedFrames);
+		FMemory::Memcpy(OutSamples + Frames * NumChannels, Output.GetData() + ConsumedFrames * NumChannels,
+						Count * NumChannels * sizeof(int16));
+		Frames += Count;
+		ConsumedFrames += Count;
+	}
+	return Frames;
+}
+
+bool FOVRLipSyncResamplingDecoder::Refill()
+{
+	OutputFrames = ConsumedFrames = 0;
+	const int32 SourceChannels = Source->GetNumChannels();
+
+	// The resampler may hold frames back until more input arrives, keep pulling until it produces some
+	while (OutputFrames == 0)
+	{
+		if (bEndOfStream || bError)
+		{
+			return false;
+		}
+
+		const int32 SourceFrames = Source->Decode(SourceBlock.GetData(), BlockFrames);
+		if (SourceFrames == INDEX_NONE)
+		{
+			bError = true;
+			return false;
+		}
+		const bool bEndOfInput = SourceFrames < BlockFrames;
+
+		// To float, averaging the channels when downmixing
+		constexpr float Scale = 1.0f / 32768.0f;
+		const int16 *In = SourceBlock.GetData();
+		float *Mixed = Input.GetData();
+		if (NumChannels == SourceChannels)
+		{
+			for (int32 i = 0; i < SourceFrames * SourceChannels; ++i)
+			{
+				Mixed[i] = In[i] * Scale;
+			}
+		}
+		else
+		{
+			const float MixScale = Scale / SourceChannels;
+			for (int32 Frame = 0; Frame < SourceFrames; ++Frame)
+			{
+				int32 Sum = 0;
+				for (int32 Channel = 0; Channel < SourceChannels; ++Channel)
+				{
+					Sum += In[Frame * SourceChannels + Channel];
+				}
+				Mixed[Frame] = Sum * MixScale;
+			}
+		}
+
+		// Resample, at the end of the input the resampler flushes the frames it still holds
+		int32 InputOffset = 0;
+		int32 Produced = 0;
+		for (;;)
+		{
+			const int32 Capacity = FMath::CeilToInt(BlockFrames * Ratio) + 64;
+			if (Resampled.Num() < (Produced + Capacity) * NumChannels)
+			{
+				Resampled.SetNumUninitialized((Produced + Capacity) * NumChannels);
+			}
+			int32 Generated = 0;
+			float *ResampledFrames = Resampled.GetData() + Produced * NumChannels;
+			const int32 Used = Resampler.ProcessAudio(Input.GetData() + InputOffset * NumChannels,
+													  SourceFrames - InputOffset, bEndOfInput, ResampledFrames,
+													  Capacity, Generated);
+			InputOffset += FMath::Max(Used, 0);
+			Produced += Generated;
+			// Done once all input is used, and at the end of the input once nothing more comes out
+			if ((Used <= 0 && Generated == 0) || (InputOffset >= SourceFrames && !bEndOfInput))
+			{
+				break;
+			}
+		}
+
+		Output.SetNumUninitialized(Produced * NumChannels);
+		Quantizer.Convert(reinterpret_cast<const uint8 *>(Resampled.GetData()), Produced, Output.GetData());
+		OutputFrames = Produced;
+		bEndOfStream = bEndOfInput;
+	}
+	return true;
+}
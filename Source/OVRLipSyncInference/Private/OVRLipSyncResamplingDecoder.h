@@ -0,0 +1,64 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncResamplingDecoder.h
+ * Content     :   Downmixes and resamples decoded audio ahead of inference
+ ******************************************************************************/
+
+#pragma once
+
+#include "AudioResampler.h"
+#include "CoreMinimal.h"
+#include "OVRLipSyncAudioDecoder.h"
+#include "OVRLipSyncPCMConverter.h"
+
+/**
+ * Wraps another decoder, optionally downmixing its output to mono and resampling it to a fixed rate, so inference
+ * processes as few samples as the model needs. Frames keep their timing, only the number of samples per frame
+ * changes.
+ */
+class FOVRLipSyncResamplingDecoder : public IOVRLipSyncAudioDecoder
+{
+public:
+	// Source frames pulled and resampled at once
+	static constexpr int32 BlockFrames = 1024;
+
+	/**
+	 * Wrap Source when its output doesn't already match the requested layout and rate.
+	 *
+	 * @param Source The decoder to wrap.
+	 * @param bDownmixToMono Mix stereo sources down to mono.
+	 * @param TargetSampleRate Rate to resample to, zero or less keeps the source rate.
+	 * @param Method Resampling algorithm.
+	 * @return Source itself when nothing needs to change, otherwise the wrapping decoder.
+	 */
+	static TUniquePtr<IOVRLipSyncAudioDecoder> Wrap(TUniquePtr<IOVRLipSyncAudioDecoder> &&Source, bool bDownmixToMono,
+													int32 TargetSampleRate, Audio::EResamplingMethod Method);
+
+	int32 GetSampleRate() const override { return SampleRate; }
+	int32 GetNumChannels() const override { return NumChannels; }
+	int64 GetNumFrames() const override;
+	int32 Decode(int16 *OutSamples, int32 MaxFrames) override;
+
+private:
+	FOVRLipSyncResamplingDecoder(TUniquePtr<IOVRLipSyncAudioDecoder> &&InSource, int32 InNumChannels,
+								 int32 InSampleRate, Audio::EResamplingMethod Method);
+
+	// Pull and resample the next block of source frames into Output, false at the end of the stream or on error
+	bool Refill();
+
+	TUniquePtr<IOVRLipSyncAudioDecoder> Source;
+	int32 NumChannels;
+	int32 SampleRate;
+	float Ratio;
+	Audio::FResampler Resampler;
+	// Quantizes resampled float frames
+	FOVRLipSyncPCMConverter Quantizer;
+
+	TArray<int16> SourceBlock;
+	Audio::FAlignedFloatBuffer Input;
+	Audio::FAlignedFloatBuffer Resampled;
+	TArray<int16> Output;
+	int32 OutputFrames = 0;
+	int32 ConsumedFrames = 0;
+	bool bEndOfStream = false;
+	bool bError = false;
+};
@@ -0,0 +1,116 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncSoundWaveDecoder.cpp
+ * Content     :   Decodes the compressed platform data of USoundWave assets at runtime
+ ******************************************************************************/
+
+#include "OVRLipSyncSoundWaveDecoder.h"
+
+#include "Sound/SoundWave.h"
+#include "Sound/SoundWaveProcedural.h"
+
+namespace
+{
+bool Fail(FString *OutError, const TCHAR *Reason)
+{
+	if (OutError)
+	{
+		*OutError = Reason;
+	}
+	return false;
+}
+
+FOVRLipSyncWaveFormat MakeFloatFormat(int32 SampleRate, int32 NumChannels)
+{
+	FOVRLipSyncWaveFormat Format;
+	Format.Encoding = EOVRLipSyncSampleEncoding::Float;
+	Format.NumChannels = NumChannels;
+	Format.SampleRate = SampleRate;
+	Format.BitsPerSample = 32;
+	Format.BlockAlign = NumChannels * sizeof(float);
+	return Format;
+}
+} // namespace
+
+FOVRLipSyncSoundWaveDecoder::FOVRLipSyncSoundWaveDecoder(TUniquePtr<Audio::FSoundWaveProxyReader> &&InReader,
+														 int32 InSampleRate, int32 InNumChannels, int64 InNumFrames)
+	: Reader(MoveTemp(InReader)), SampleRate(InSampleRate), NumFrames(InNumFrames),
+	  Converter(MakeFloatFormat(InSampleRate, InNumChannels),
+				FOVRLipSyncPCMConverter::GetInferenceChannels(InNumChannels))
+{
+	Decoded.SetNumUninitialized(DecodeFrames * InNumChannels);
+}
+
+TUniquePtr<FOVRLipSyncSoundWaveDecoder> FOVRLipSyncSoundWaveDecoder::Create(USoundWave *SoundWave, FString *OutError)
+{
+	check(IsInGameThread());
+
+	if (!SoundWave)
+	{
+		Fail(OutError, TEXT("no sound wave"));
+		return nullptr;
+	}
+	if (SoundWave->IsA<USoundWaveProcedural>())
+	{
+		Fail(OutError, TEXT("procedural sound waves have no data to decode"));
+		return nullptr;
+	}
+
+	FSoundWaveProxyPtr Proxy = SoundWave->CreateSoundWaveProxy();
+	if (!Proxy.IsValid())
+	{
+		Fail(OutError, TEXT("sound wave has no compressed data for this platform"));
+		return nullptr;
+	}
+
+	Audio::FSoundWaveProxyReader::FSettings Settings;
+	Settings.MaxDecodeSizeInFrames = DecodeFrames;
+	Settings.bIsLooping = false;
+	TUniquePtr<Audio::FSoundWaveProxyReader> Reader =
+		Audio::FSoundWaveProxyReader::Create(Proxy.ToSharedRef(), Settings);
+	if (!Reader.IsValid() || Reader->GetNumChannels() <= 0 || Reader->GetSampleRate() <= 0.0f)
+	{
+		Fail(OutError, TEXT("failed to create a decoder for the sound wave"));
+		return nullptr;
+	}
+
+	return TUniquePtr<FOVRLipSyncSoundWaveDecoder>(
+		new FOVRLipSyncSoundWaveDecoder(MoveTemp(Reader), FMath::RoundToInt(Reader->GetSampleRate()),
+										Reader->GetNumChannels(), Proxy->GetNumFrames()));
+}
+
+int32 FOVRLipSyncSoundWaveDecoder::Decode(int16 *OutSamples, int32 MaxFrames)
+{
+	const int32 SourceChannels = Converter.GetSourceFormat().NumChannels;
+	const int32 OutputChannels = GetNumChannels();
+	int32 Frames = 0;
+	while (Frames < MaxFrames)
+	{
+		if (ConsumedFrames == DecodedFrames)
+		{
+			if (bEndOfStream)
+			{
+				break;
+			}
+			// Fewer samples than requested means the end of the wave was reached
+			const int32 NumSamples = Reader->PopAudio(Decoded);
+			if (Reader->HasFailed())
+			{
+				return INDEX_NONE;
+			}
+			bEndOfStream = NumSamples < Decoded.Num();
+			DecodedFrames = NumSamples / SourceChannels;
+			ConsumedFrames = 0;
+			if (DecodedFrames == 0)
+			{
+				break;
+			}
+		}
+
+		const int32 Count = FMath::Min(MaxFrames - Frames, DecodedFrames - ConsumedFrames);
+		Converter.Convert(reinterpret_cast<const uint8 *>(Decoded.GetData() + ConsumedFrames * SourceChannels), Count,
+						  OutSamples + Frames * OutputChannels);
+		Frames += Count;
+		ConsumedFrames += Count;
+	}
+	return Frames;
+}
@@ -0,0 +1,53 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncSoundWaveDecoder.h
+ * Content     :   Decodes the compressed platform data of USoundWave assets at runtime
+ ******************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OVRLipSyncAudioDecoder.h"
+#include "OVRLipSyncPCMConverter.h"
+#include "Sound/SoundWaveProxyReader.h"
+
+class USoundWave;
+
+/**
+ * Decodes a sound wave through the engine's compressed audio decoders, the same path MetaSounds use, so it works
+ * in cooked builds and never touches the audio device. Streamed waves load their chunks as decoding advances.
+ */
+class FOVRLipSyncSoundWaveDecoder : public IOVRLipSyncAudioDecoder
+{
+public:
+	// Frames decoded by the engine at once
+	static constexpr int32 DecodeFrames = 1024;
+
+	/**
+	 * Prepare decoding a sound wave. Game thread only, Decode can then be called from any single thread.
+	 *
+	 * @param SoundWave The sound wave to decode.
+	 * @param OutError Optional description of why the wave can't be decoded.
+	 * @return The decoder, or nullptr if the wave has no decodable data.
+	 */
+	static TUniquePtr<FOVRLipSyncSoundWaveDecoder> Create(USoundWave *SoundWave, FString *OutError = nullptr);
+
+	int32 GetSampleRate() const override { return SampleRate; }
+	int32 GetNumChannels() const override { return Converter.GetOutputFormat().NumChannels; }
+	int64 GetNumFrames() const override { return NumFrames; }
+	int32 Decode(int16 *OutSamples, int32 MaxFrames) override;
+
+private:
+	FOVRLipSyncSoundWaveDecoder(TUniquePtr<Audio::FSoundWaveProxyReader> &&InReader, int32 InSampleRate,
+								int32 InNumChannels, int64 InNumFrames);
+
+	TUniquePtr<Audio::FSoundWaveProxyReader> Reader;
+	int32 SampleRate;
+	int64 NumFrames;
+	// Converts the float output of the engine decoders
+	FOVRLipSyncPCMConverter Converter;
+
+	Audio::FAlignedFloatBuffer Decoded;
+	int32 DecodedFrames = 0;
+	int32 ConsumedFrames = 0;
+	bool bEndOfStream = false;
+};
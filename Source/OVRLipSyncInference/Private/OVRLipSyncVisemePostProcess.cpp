@@ -0,0 +1,131 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncVisemePostProcess.cpp
+ * Content     :   Filtering, clustering and smoothing of raw inference frames
+ ******************************************************************************/
+
+#include "OVRLipSyncVisemePostProcess.h"
+
+#include "CookFrameSequenceAsync.h"
+#include "OVRLipSyncFrame.h"
+#include "OVRLipSyncPostProcessCore.h"
+#include "OVRLipSyncStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Post-Process: Filter Short Visemes"), STAT_OVRLipSync_FilterShortVisemes,
+				   STATGROUP_OVRLipSync);
+DECLARE_CYCLE_STAT(TEXT("Post-Process: Cluster Blocks"), STAT_OVRLipSync_ClusterBlocks, STATGROUP_OVRLipSync);
+DECLARE_CYCLE_STAT(TEXT("Post-Process: Apply Dominants"), STAT_OVRLipSync_ApplyDominants, STATGROUP_OVRLipSync);
+DECLARE_CYCLE_STAT(TEXT("Post-Process: Smooth"), STAT_OVRLipSync_Smooth, STATGROUP_OVRLipSync);
+
+namespace
+{
+// Adds the time until the end of the scope to Seconds, when set
+struct FStepTimer
+{
+	double *Seconds;
+	double Start;
+
+	explicit FStepTimer(double *InSeconds) : Seconds(InSeconds), Start(FPlatformTime::Seconds()) {}
+	~FStepTimer()
+	{
+		if (Seconds)
+		{
+			*Seconds += FPlatformTime::Seconds() - Start;
+		}
+	}
+};
+
+TMap<FName, FOVRLipSyncVisemePostProcess::FImplementation> &GetRegisteredCandidates()
+{
+	static TMap<FName, FOVRLipSyncVisemePostProcess::FImplementation> Candidates;
+	return Candidates;
+}
+} // namespace
+
+void FOVRLipSyncVisemePostProcess::Apply(TArray<TArray<float>> &RawVisemeFrames, const TArray<float> &LaughterScores,
+										 const FVisemeInterpolationSettings &Settings,
+										 UOVRLipSyncFrameSequence &Sequence, FOVRLipSyncPostProcessTimings *OutTimings)
+{
+	OVRLipSyncCore::FPostProcessSettings CoreSettings;
+	CoreSettings.bEnableInterpolation = Settings.bEnableInterpolation;
+	CoreSettings.MaxInterpolationFrames = Settings.MaxInterpolationFrames;
+	CoreSettings.MinHoldFrames = Settings.MinHoldFrames;
+	CoreSettings.bStrictConsonantLock = Settings.bStrictConsonantLock;
+
+	const int32 NumFrames = RawVisemeFrames.Num();
+	const int32 NumVisemes = NumFrames > 0 ? RawVisemeFrames[0].Num() : 0;
+	OVRLipSyncCore::FScoreBuffer Buffer;
+	Buffer.Init(NumFrames, NumVisemes);
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		FMemory::Memcpy(Buffer.GetFrame(Frame), RawVisemeFrames[Frame].GetData(),
+						FMath::Min(RawVisemeFrames[Frame].Num(), NumVisemes) * sizeof(float));
+	}
+
+	// Step 1: filter out short visemes
+	{
+		SCOPE_CYCLE_COUNTER(STAT_OVRLipSync_FilterShortVisemes);
+		TRACE_CPUPROFILER_EVENT_SCOPE(OVRLipSync::FilterShortVisemes);
+		FStepTimer Timer(OutTimings ? &OutTimings->FilterSeconds : nullptr);
+		OVRLipSyncCore::FilterShortVisemes(Buffer, CoreSettings);
+	}
+
+	// Step 2: cluster into blocks and scale dominant viseme (with priority)
+	OVRLipSyncCore::FBlockDominants Dominants;
+	{
+		SCOPE_CYCLE_COUNTER(STAT_OVRLipSync_ClusterBlocks);
+		TRACE_CPUPROFILER_EVENT_SCOPE(OVRLipSync::ClusterBlocks);
+		FStepTimer Timer(OutTimings ? &OutTimings->ClusterSeconds : nullptr);
+		OVRLipSyncCore::ClusterBlocks(Buffer, CoreSettings, Dominants);
+	}
+
+	// Step 3: apply scaled dominant viseme in block, preserve neighbors
+	{
+		SCOPE_CYCLE_COUNTER(STAT_OVRLipSync_ApplyDominants);
+		TRACE_CPUPROFILER_EVENT_SCOPE(OVRLipSync::ApplyDominants);
+		FStepTimer Timer(OutTimings ? &OutTimings->ApplySeconds : nullptr);
+		OVRLipSyncCore::ApplyDominants(Buffer, CoreSettings, Dominants);
+	}
+
+	// Step 4: final smoothing
+	OVRLipSyncCore::FScoreBuffer Smoothed;
+	{
+		SCOPE_CYCLE_COUNTER(STAT_OVRLipSync_Smooth);
+		TRACE_CPUPROFILER_EVENT_SCOPE(OVRLipSync::Smooth);
+		FStepTimer Timer(OutTimings ? &OutTimings->SmoothSeconds : nullptr);
+		OVRLipSyncCore::Smooth(Buffer, CoreSettings, Smoothed);
+	}
+
+	// Raw frames are left as they were before smoothing, like the steps used to leave them
+	Sequence.FrameSequence.Reserve(Sequence.FrameSequence.Num() + NumFrames);
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		RawVisemeFrames[Frame].SetNumUninitialized(NumVisemes);
+		FMemory::Memcpy(RawVisemeFrames[Frame].GetData(), Buffer.GetFrame(Frame), NumVisemes * sizeof(float));
+		FOVRLipSyncFrame &Output = Sequence.FrameSequence.AddDefaulted_GetRef();
+		Output.VisemeScores.Append(Smoothed.GetFrame(Frame), NumVisemes);
+		Output.LaughterScore = LaughterScores[Frame];
+	}
+}
+
+void FOVRLipSyncVisemePostProcess::RegisterCandidate(FName Name, FImplementation Implementation)
+{
+	check(IsInGameThread());
+	GetRegisteredCandidates().Add(Name, MoveTemp(Implementation));
+}
+
+void FOVRLipSyncVisemePostProcess::UnregisterCandidate(FName Name)
+{
+	check(IsInGameThread());
+	GetRegisteredCandidates().Remove(Name);
+}
+
+TMap<FName, FOVRLipSyncVisemePostProcess::FImplementation> FOVRLipSyncVisemePostProcess::GetCandidates()
+{
+	check(IsInGameThread());
+	TMap<FName, FImplementation> Candidates = GetRegisteredCandidates();
+	Candidates.Add(TEXT("Default"),
+				   [](TArray<TArray<float>> &RawVisemeFrames, const TArray<float> &LaughterScores,
+					  const FVisemeInterpolationSettings &Settings, UOVRLipSyncFrameSequence &Sequence)
+				   { Apply(RawVisemeFrames, LaughterScores, Settings, Sequence); });
+	return Candidates;
+}
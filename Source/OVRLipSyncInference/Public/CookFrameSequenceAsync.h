@@ -0,0 +1,131 @@
+// Frame Sequence Maker fork by Aida Drogan based on CookFrameSequenceAsync by IlgarLunin
+// https://github.com/IlgarLunin/UE4OVRLipSyncCookFrameSequence
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AudioConverterLibrary.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "OVRLipSyncContextWrapper.h"
+#include "OVRLipSyncFrame.h"
+#include "CookFrameSequenceAsync.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FFrameSequenceCoocked, UOVRLipSyncFrameSequence *, FrameSequence, bool,
+											 Success);
+
+USTRUCT(BlueprintType)
+struct FVisemeInterpolationSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bEnableInterpolation = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 MaxInterpolationFrames = 6;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bStrictConsonantLock = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LipSync", meta = (ClampMin = "1"))
+	int32 MinHoldFrames = 2;
+};
+
+UENUM(BlueprintType)
+enum class EOVRLipSyncResampleQuality : uint8
+{
+	// Linear interpolation, fastest
+	Fast,
+	// Short windowed sinc
+	Balanced,
+	// Long windowed sinc, slowest
+	Best,
+};
+
+/**
+ * Optional conversion of the audio before inference. Inference cost scales with the number of samples it is fed,
+ * so downmixing and resampling to the lowest rate the model handles well speeds cooking up without changing the
+ * timing of the generated frames.
+ */
+USTRUCT(BlueprintType)
+struct FOVRLipSyncPreprocessSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LipSync")
+	bool bEnablePreprocessing = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LipSync", meta = (EditCondition = "bEnablePreprocessing"))
+	bool bDownmixToMono = true;
+
+	// Rate inference runs at, 0 keeps the source rate
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LipSync",
+			  meta = (EditCondition = "bEnablePreprocessing", ClampMin = "0", ClampMax = "48000"))
+	int32 TargetSampleRate = 16000;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LipSync", meta = (EditCondition = "bEnablePreprocessing"))
+	EOVRLipSyncResampleQuality Quality = EOVRLipSyncResampleQuality::Balanced;
+};
+
+/**
+ * Generates Frame Sequence for LipSync
+ */
+UCLASS()
+class OVRLIPSYNCINFERENCE_API UCookFrameSequenceAsync : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY(BlueprintAssignable, Category = "LipSync")
+	FFrameSequenceCoocked onFrameSequenceCooked;
+
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"), Category = "LipSync")
+	static UCookFrameSequenceAsync *
+	CookFrameSequence(const TArray<uint8> &RawSamples, bool UseOfflineModel = false,
+					  const FVisemeInterpolationSettings &Settings = FVisemeInterpolationSettings(),
+					  const FOVRLipSyncPreprocessSettings &Preprocess = FOVRLipSyncPreprocessSettings());
+
+	// Cook from a WAV file opened with UAudioConverterLibrary::OpenWaveFile, reading the mapped file directly
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"), Category = "LipSync")
+	static UCookFrameSequenceAsync *
+	CookFrameSequenceFromWaveFile(const FOVRLipSyncWaveHandle &WaveFile, bool UseOfflineModel = false,
+								  const FVisemeInterpolationSettings &Settings = FVisemeInterpolationSettings(),
+								  const FOVRLipSyncPreprocessSettings &Preprocess = FOVRLipSyncPreprocessSettings());
+
+	// Cook from a WAV, FLAC, Ogg Vorbis or engine Opus file, decoding it in chunks as inference runs
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"), Category = "LipSync")
+	static UCookFrameSequenceAsync *
+	CookFrameSequenceFromFile(const FString &FilePath, bool UseOfflineModel = false,
+							  const FVisemeInterpolationSettings &Settings = FVisemeInterpolationSettings(),
+							  const FOVRLipSyncPreprocessSettings &Preprocess = FOVRLipSyncPreprocessSettings());
+
+	/**
+	 * Cook a long recording, writing raw frames to CheckpointDirectory as inference runs. If a previous cook of the
+	 * same file with the same settings was interrupted, it resumes from the last segment written.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"), Category = "LipSync")
+	static UCookFrameSequenceAsync *CookFrameSequenceFromFileResumable(
+		const FString &FilePath, const FString &CheckpointDirectory, bool UseOfflineModel = false,
+		const FVisemeInterpolationSettings &Settings = FVisemeInterpolationSettings(),
+		const FOVRLipSyncPreprocessSettings &Preprocess = FOVRLipSyncPreprocessSettings());
+
+	// Cook from an imported sound wave, decoding its compressed platform data on the cook thread
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"), Category = "LipSync")
+	static UCookFrameSequenceAsync *
+	CookFrameSequenceFromSoundWave(USoundWave *SoundWave, bool UseOfflineModel = false,
+								   const FVisemeInterpolationSettings &Settings = FVisemeInterpolationSettings(),
+								   const FOVRLipSyncPreprocessSettings &Preprocess = FOVRLipSyncPreprocessSettings());
+
+	// Contents of a WAV, FLAC, Ogg Vorbis or engine Opus file
+	TArray<uint8> RawSamples;
+	FOVRLipSyncWaveHandle WaveFile;
+	FString SourceFilePath;
+	// Set for resumable cooks
+	FString CheckpointDirectory;
+	UPROPERTY()
+	TObjectPtr<USoundWave> SoundWave;
+	bool UseOfflineModel;
+	FVisemeInterpolationSettings InterpolationSettings;
+	FOVRLipSyncPreprocessSettings PreprocessSettings;
+
+	virtual void Activate() override;
+};
@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncAudioDecoder.h
+ * Content     :   Incremental decoding of audio files to the 16-bit PCM used for inference
+ ******************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FOVRLipSyncFileBuffer;
+class USoundWave;
+
+/**
+ * Pull-based decoder producing interleaved 16-bit mono or stereo PCM, one block at a time, so that cooking
+ * never needs the whole decoded file in memory.
+ */
+class OVRLIPSYNCINFERENCE_API IOVRLipSyncAudioDecoder
+{
+public:
+	virtual ~IOVRLipSyncAudioDecoder() = default;
+
+	virtual int32 GetSampleRate() const = 0;
+	// Channels of the decoded output, 1 or 2
+	virtual int32 GetNumChannels() const = 0;
+	// Total number of frames, INDEX_NONE when it isn't known before the end of the stream is reached
+	virtual int64 GetNumFrames() const = 0;
+
+	/**
+	 * Decode the next frames.
+	 *
+	 * @param OutSamples Receives up to MaxFrames * GetNumChannels() samples.
+	 * @param MaxFrames Number of frames to decode.
+	 * @return Number of frames decoded, less than MaxFrames only at the end of the stream, INDEX_NONE on error.
+	 */
+	virtual int32 Decode(int16 *OutSamples, int32 MaxFrames) = 0;
+
+	/**
+	 * Same as Decode, but lets decoders whose source already holds 16-bit PCM in the output layout return a
+	 * pointer into the source instead of copying. OutSamples points either into the source or to Scratch.
+	 */
+	virtual int32 DecodeView(int16 *Scratch, int32 MaxFrames, const int16 *&OutSamples)
+	{
+		OutSamples = Scratch;
+		return Decode(Scratch, MaxFrames);
+	}
+
+	/**
+	 * Create a decoder for the file held by File, detecting its container from its contents.
+	 * Supports WAV, FLAC, Ogg Vorbis and the engine's Opus container.
+	 *
+	 * @param File The file contents, kept alive by the decoder.
+	 * @param OutError Optional description of why no decoder could be created.
+	 * @return The decoder, or nullptr if the file can't be decoded.
+	 */
+	static TUniquePtr<IOVRLipSyncAudioDecoder> Create(const TSharedRef<FOVRLipSyncFileBuffer> &File,
+													  FString *OutError = nullptr);
+
+	/**
+	 * Create a decoder for a file on disk. Files that fit in a view are opened with FOVRLipSyncFileBuffer and decoded
+	 * like Create does, larger WAV files are read through a file handle one block at a time with 64-bit offsets.
+	 *
+	 * @param FilePath The path to the file.
+	 * @param OutError Optional description of why no decoder could be created.
+	 * @return The decoder, or nullptr if the file can't be read or decoded.
+	 */
+	static TUniquePtr<IOVRLipSyncAudioDecoder> CreateForFile(const FString &FilePath, FString *OutError = nullptr);
+
+	/**
+	 * Create a decoder for the compressed platform data of a sound wave. Game thread only, the decoder can then be
+	 * used from any single thread.
+	 *
+	 * @param SoundWave The sound wave to decode.
+	 * @param OutError Optional description of why no decoder could be created.
+	 * @return The decoder, or nullptr if the wave has no decodable data.
+	 */
+	static TUniquePtr<IOVRLipSyncAudioDecoder> CreateForSoundWave(USoundWave *SoundWave, FString *OutError = nullptr);
+};
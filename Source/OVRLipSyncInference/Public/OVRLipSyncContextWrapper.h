@@ -25,7 +25,9 @@
 #include "CoreMinimal.h"
 #include "OVRLipSync.h"
 
-class OVRLIPSYNC_API UOVRLipSyncContextWrapper
+#include <atomic>
+
+class OVRLIPSYNCINFERENCE_API UOVRLipSyncContextWrapper
 {
 public:
 	UOVRLipSyncContextWrapper(ovrLipSyncContextProvider Provider, int SampleRate = 48000, int BufferSize = 4096,
@@ -35,13 +37,21 @@ public:
 	void ProcessFrame(const int16_t *Data, int DataSize, TArray<float> &Visemes, float &LaughterScore,
 					  int32_t &FrameDelay, bool Stereo = false);
 
-	// Async processing
-	using AsyncCallbackType = TFunction<void(const TArray<float> &Visemes, float LaughterScore)>;
+	// Async processing, FeedCycles is when the audio of the result was handed to ProcessFrameAsync
+	using AsyncCallbackType = TFunction<void(const TArray<float> &Visemes, float LaughterScore, uint64 FeedCycles)>;
 	void SetAsyncCallback(const AsyncCallbackType &AsyncCallback);
-	void InvokeAsyncCallback(const TArray<float> &Visemes, float LaughterScore);
+	void InvokeAsyncCallback(const TArray<float> &Visemes, float LaughterScore, uint64 FeedCycles);
 	void ProcessFrameAsync(const int16_t *Data, int DataSize, bool Stereo = false);
+	// Frames handed to ProcessFrameAsync whose result hasn't come back yet
+	int32 GetNumPendingFrames() const { return NumPendingFrames; }
 
 private:
+	static void ProcessFrameCallback(void *opaque, const ovrLipSyncFrame *pFrame, ovrLipSyncResult result);
+
 	AsyncCallbackType AsyncCallback;
+	std::atomic<int32> NumPendingFrames{0};
+	// Feed time of each pending frame, oldest first, results come back in the order frames were fed
+	TArray<uint64> PendingFeedCycles;
+	FCriticalSection PendingLock;
 	ovrLipSyncContext LipSyncContext = 0;
 };
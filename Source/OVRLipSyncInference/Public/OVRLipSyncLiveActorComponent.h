@@ -24,10 +24,12 @@
 #pragma once
 
 #include "OVRLipSyncActorComponentBase.h"
+#include "OVRLipSyncModule.h"
 #include "TimerManager.h"
-#include "OVRLipSyncLiveActorComponent.generated.h"
 
-DECLARE_LOG_CATEGORY_EXTERN(LogOvrLipSync, Log, All);
+#include <atomic>
+
+#include "OVRLipSyncLiveActorComponent.generated.h"
 
 class IVoiceCapture;
 class UOVRLipSyncContextWrapper;
@@ -41,7 +43,7 @@ enum class OVRLipSyncProviderKind : uint8
 };
 
 UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
-class OVRLIPSYNC_API UOVRLipSyncActorComponent : public UOVRLipSyncActorComponentBase
+class OVRLIPSYNCINFERENCE_API UOVRLipSyncActorComponent : public UOVRLipSyncActorComponentBase
 {
 	GENERATED_BODY()
 
@@ -71,6 +73,9 @@ public:
 			  Meta = (ToolTip = "Feed AudioBuffer containing packaged mono 16-bit signed integer PCM values"))
 	void FeedAudio(const TArray<uint8> &AudioData);
 
+	virtual const TCHAR *GetDebugMode() const override { return TEXT("Live"); }
+	virtual FString GetDebugDetails() const override;
+
 protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
@@ -87,5 +92,8 @@ private:
 	FTimerHandle VoiceCaptureTimer;
 	static const float VoiceCaptureTimerRate;
 
+	// Time from the feed behind the last result to that result, shown by LipSync.List
+	std::atomic<uint64> LastLatencyCycles{0};
+
 	void StartVoiceCapture();
 };
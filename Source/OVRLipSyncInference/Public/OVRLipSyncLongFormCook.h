@@ -0,0 +1,81 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncLongFormCook.h
+ * Content     :   Checkpointed inference over multi-hour recordings
+ ******************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IOVRLipSyncAudioDecoder;
+
+/**
+ * Runs inference over a recording of any length, writing raw frames to disk in fixed-size segments. A checkpoint
+ * file records the segments completed so far, so a cook interrupted by a crash or a cancel resumes from the last
+ * completed segment instead of from the start.
+ *
+ * A resumed cook feeds PreRollFrames of audio ahead of the first new segment through a fresh context and discards
+ * the output, so the model has settled by the time frames are kept again.
+ */
+class OVRLIPSYNCINFERENCE_API FOVRLipSyncLongFormCook
+{
+public:
+	// Frames generated per second of audio
+	static constexpr int32 FramesPerSecond = 100;
+	// One minute of frames per segment
+	static constexpr int32 DefaultSegmentFrames = 6000;
+	// Frames fed to the context ahead of a resumed segment
+	static constexpr int32 PreRollFrames = 50;
+
+	/**
+	 * Number of samples in frame Frame of audio at SampleRate. Frames start on the 10 ms grid rounded down to a
+	 * sample, so rates that aren't a multiple of FramesPerSecond (e.g. 22050) alternate between two frame sizes
+	 * instead of drifting.
+	 */
+	static int32 GetFrameSamples(int64 Frame, int32 SampleRate)
+	{
+		return static_cast<int32>((Frame + 1) * SampleRate / FramesPerSecond - Frame * SampleRate / FramesPerSecond);
+	}
+
+	/**
+	 * @param InCheckpointDirectory Directory the segments and checkpoint are written to, created when missing.
+	 * @param InFingerprint Identifies the audio and the settings, checkpoints with a different fingerprint are
+	 *                      discarded.
+	 * @param InSegmentFrames Frames written per segment.
+	 */
+	FOVRLipSyncLongFormCook(const FString &InCheckpointDirectory, const FString &InFingerprint,
+							int32 InSegmentFrames = DefaultSegmentFrames);
+
+	/**
+	 * Run inference over the audio not covered by the checkpoint. Blocks, call from a worker thread.
+	 *
+	 * @param Decoder Decoder positioned at the start of the audio.
+	 * @param ModelPath Model passed to the context, empty for the default model.
+	 * @param Progress Called after each frame with the frames done and the total (INDEX_NONE when unknown), return
+	 *                 false to stop. A stopped cook keeps its checkpoint and resumes on the next run.
+	 * @param OutError Why the cook failed.
+	 * @return True once every frame is on disk.
+	 */
+	bool Run(IOVRLipSyncAudioDecoder &Decoder, const FString &ModelPath,
+			 TFunctionRef<bool(int64 FramesDone, int64 TotalFrames)> Progress, FString *OutError = nullptr);
+
+	// Read back the frames of all completed segments
+	bool LoadFrames(TArray<TArray<float>> &OutVisemeFrames, TArray<float> &OutLaughterScores,
+					FString *OutError = nullptr) const;
+
+	// Delete the checkpoint directory
+	void Cleanup() const;
+
+private:
+	FString GetSegmentPath(int32 Segment) const;
+	FString GetCheckpointPath() const;
+	// Number of consecutive segments a matching checkpoint vouches for, 0 otherwise
+	int32 ReadCheckpoint(bool &bOutComplete) const;
+	bool WriteCheckpoint(bool bComplete) const;
+	bool WriteSegment(int32 Segment, const TArray<float> &Frames, int32 NumFrames, int32 NumVisemes) const;
+
+	FString CheckpointDirectory;
+	FString Fingerprint;
+	int32 SegmentFrames;
+	int32 CompletedSegments = 0;
+};
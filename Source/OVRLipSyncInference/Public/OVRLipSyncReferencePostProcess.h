@@ -0,0 +1,24 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncReferencePostProcess.h
+ * Content     :   Frozen copy of the viseme post-processing, the reference of the golden tests
+ ******************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FOVRLipSyncFrame;
+struct FVisemeInterpolationSettings;
+
+/**
+ * The viseme post-processing as it was before it was optimised. FOVRLipSyncVisemePostProcess and its registered
+ * candidates must produce the same frames, within the golden tolerances of the editor settings. Adapts
+ * OVRLipSyncCore::ReferenceApply, which the equivalence test of Tools/PostProcessCore checks the core against.
+ */
+class OVRLIPSYNCINFERENCE_API FOVRLipSyncReferencePostProcess
+{
+public:
+	// Same as FOVRLipSyncVisemePostProcess::Apply, frames are appended to OutFrames
+	static void Apply(TArray<TArray<float>> &RawVisemeFrames, const TArray<float> &LaughterScores,
+					  const FVisemeInterpolationSettings &Settings, TArray<FOVRLipSyncFrame> &OutFrames);
+};
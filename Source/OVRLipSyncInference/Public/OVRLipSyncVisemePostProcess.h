@@ -0,0 +1,52 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncVisemePostProcess.h
+ * Content     :   Filtering, clustering and smoothing of raw inference frames
+ ******************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FVisemeInterpolationSettings;
+class UOVRLipSyncFrameSequence;
+
+// Seconds spent in each step of FOVRLipSyncVisemePostProcess::Apply
+struct FOVRLipSyncPostProcessTimings
+{
+	double FilterSeconds = 0.0;
+	double ClusterSeconds = 0.0;
+	double ApplySeconds = 0.0;
+	double SmoothSeconds = 0.0;
+};
+
+class OVRLIPSYNCINFERENCE_API FOVRLipSyncVisemePostProcess
+{
+public:
+	// Signature of Apply, shared by the alternative implementations checked against it
+	using FImplementation = TFunction<void(TArray<TArray<float>> &, const TArray<float> &,
+										   const FVisemeInterpolationSettings &, UOVRLipSyncFrameSequence &)>;
+
+	/**
+	 * Turn raw inference output into the frames of a sequence: drop visemes held for less than MinHoldFrames,
+	 * keep the dominant viseme of each block of frames (and its neighbours at block edges), then smooth.
+	 *
+	 * @param RawVisemeFrames Viseme scores of each frame, modified in place.
+	 * @param LaughterScores Laughter score of each frame.
+	 * @param Settings Interpolation settings.
+	 * @param Sequence Receives one frame per raw frame.
+	 * @param OutTimings When set, the time of each step is added to it.
+	 */
+	static void Apply(TArray<TArray<float>> &RawVisemeFrames, const TArray<float> &LaughterScores,
+					  const FVisemeInterpolationSettings &Settings, UOVRLipSyncFrameSequence &Sequence,
+					  FOVRLipSyncPostProcessTimings *OutTimings = nullptr);
+
+	/**
+	 * Register an alternative implementation, e.g. a vectorised or streaming one, for the OVRLipSyncGolden
+	 * commandlet to compare against the frozen reference before it replaces Apply. Game thread only.
+	 */
+	static void RegisterCandidate(FName Name, FImplementation Implementation);
+	static void UnregisterCandidate(FName Name);
+
+	// Registered implementations, with Apply itself as "Default"
+	static TMap<FName, FImplementation> GetCandidates();
+};
@@ -0,0 +1,90 @@
+/*******************************************************************************
+ * Filename    :   PostProcessEquivalenceTest.cpp
+ * Content     :   Checks the post-processing core against the frozen reference the golden tests use
+ ******************************************************************************/
+
+#include "OVRLipSyncPostProcessCore.h"
+#include "OVRLipSyncReferencePostProcessCore.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace OVRLipSyncCore;
+
+namespace
+{
+using FFrames = std::vector<std::vector<float>>;
+} // namespace
+
+int main()
+{
+	constexpr int NumCases = 400;
+	constexpr int NumVisemes = 15;
+
+	// Fixed seed so a failure can be reproduced
+	std::mt19937 Random(1);
+	std::uniform_real_distribution<float> Uniform(0.0f, 1.0f);
+
+	int NumFailures = 0;
+	for (int Case = 0; Case < NumCases; ++Case)
+	{
+		// Settings outside of the clamped ranges are included on purpose
+		const int NumFrames = static_cast<int>(Random() % 700);
+		FPostProcessSettings Settings;
+		Settings.bEnableInterpolation = Random() % 4 != 0;
+		Settings.bStrictConsonantLock = Random() % 3 != 0;
+		Settings.MaxInterpolationFrames = static_cast<int>(Random() % 30) - 2;
+		Settings.MinHoldFrames = static_cast<int>(Random() % 8);
+
+		// One loud viseme per frame over quieter ones, with a few silent frames
+		FFrames RawFrames(NumFrames, std::vector<float>(NumVisemes));
+		for (std::vector<float> &Frame : RawFrames)
+		{
+			const int Loud = static_cast<int>(Random() % NumVisemes);
+			for (int j = 0; j < NumVisemes; ++j)
+			{
+				const float Value = j == Loud ? Uniform(Random) : Uniform(Random) * 0.4f;
+				Frame[j] = Random() % 50 == 0 ? 0.0f : Value;
+			}
+		}
+
+		FScoreBuffer Buffer;
+		Buffer.Init(NumFrames, NumVisemes);
+		for (int f = 0; f < NumFrames; ++f)
+		{
+			std::copy(RawFrames[f].begin(), RawFrames[f].end(), Buffer.GetFrame(f));
+		}
+
+		FFrames ExpectedFrames;
+		ReferenceApply(RawFrames, Settings, ExpectedFrames);
+
+		FilterShortVisemes(Buffer, Settings);
+		FBlockDominants Dominants;
+		ClusterBlocks(Buffer, Settings, Dominants);
+		ApplyDominants(Buffer, Settings, Dominants);
+		FScoreBuffer Smoothed;
+		Smooth(Buffer, Settings, Smoothed);
+
+		// Bit for bit, both the smoothed frames and the raw frames left behind by steps 1-3
+		for (int f = 0; f < NumFrames; ++f)
+		{
+			const size_t FrameBytes = NumVisemes * sizeof(float);
+			if (std::memcmp(Smoothed.GetFrame(f), ExpectedFrames[f].data(), FrameBytes) != 0 ||
+				std::memcmp(Buffer.GetFrame(f), RawFrames[f].data(), FrameBytes) != 0)
+			{
+				std::printf("Case %d: frame %d of %d differs (MaxInterpolationFrames %d, MinHoldFrames %d, "
+							"interpolation %d, consonant lock %d)\n",
+							Case, f, NumFrames, Settings.MaxInterpolationFrames, Settings.MinHoldFrames,
+							Settings.bEnableInterpolation, Settings.bStrictConsonantLock);
+				++NumFailures;
+				break;
+			}
+		}
+	}
+
+	std::printf("%d of %d cases differ from the reference\n", NumFailures, NumCases);
+	return NumFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,223 @@
+/*******************************************************************************
+ * Filename    :   WaveChunksTest.cpp
+ * Content     :   Checks the RIFF/WAVE chunk walker on files built in memory
+ ******************************************************************************/
+
+#include "OVRLipSyncWaveChunksCore.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace OVRLipSyncCore;
+
+namespace
+{
+int NumFailures = 0;
+
+void Check(bool bCondition, const char *Description)
+{
+	if (!bCondition)
+	{
+		std::printf("Failed: %s\n", Description);
+		++NumFailures;
+	}
+}
+
+// Little-endian writer for the few WAV fields the tests need
+struct FWaveWriter
+{
+	std::vector<uint8_t> Bytes;
+
+	void U16(uint32_t Value)
+	{
+		Bytes.push_back(uint8_t(Value));
+		Bytes.push_back(uint8_t(Value >> 8));
+	}
+	void U32(uint32_t Value)
+	{
+		U16(Value & 0xFFFF);
+		U16(Value >> 16);
+	}
+	void Id(const char *Id) { Bytes.insert(Bytes.end(), Id, Id + 4); }
+	void Chunk(const char *ChunkId, const std::vector<uint8_t> &Payload, uint32_t DeclaredSize)
+	{
+		Id(ChunkId);
+		U32(DeclaredSize);
+		Bytes.insert(Bytes.end(), Payload.begin(), Payload.end());
+		if (Payload.size() & 1)
+		{
+			Bytes.push_back(0);
+		}
+	}
+	void Chunk(const char *ChunkId, const std::vector<uint8_t> &Payload)
+	{
+		Chunk(ChunkId, Payload, static_cast<uint32_t>(Payload.size()));
+	}
+};
+
+std::vector<uint8_t> MakeFmt(uint16_t FormatTag, int NumChannels, int SampleRate, int BitsPerSample)
+{
+	FWaveWriter Fmt;
+	Fmt.U16(FormatTag);
+	Fmt.U16(NumChannels);
+	Fmt.U32(SampleRate);
+	Fmt.U32(SampleRate * NumChannels * BitsPerSample / 8);
+	Fmt.U16(NumChannels * BitsPerSample / 8);
+	Fmt.U16(BitsPerSample);
+	return Fmt.Bytes;
+}
+
+std::vector<uint8_t> MakeExtensibleFmt(uint16_t SubFormatTag, int NumChannels, int SampleRate, int BitsPerSample,
+									   uint32_t ChannelMask)
+{
+	static const uint8_t GuidSuffix[14] = {0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80,
+										   0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71};
+	FWaveWriter Fmt;
+	Fmt.Bytes = MakeFmt(0xFFFE, NumChannels, SampleRate, BitsPerSample);
+	Fmt.U16(22);
+	Fmt.U16(BitsPerSample);
+	Fmt.U32(ChannelMask);
+	Fmt.U16(SubFormatTag);
+	Fmt.Bytes.insert(Fmt.Bytes.end(), GuidSuffix, GuidSuffix + sizeof(GuidSuffix));
+	return Fmt.Bytes;
+}
+
+// RIFF header followed by Chunks, with the RIFF size patched in
+std::vector<uint8_t> MakeWave(const FWaveWriter &Chunks)
+{
+	FWaveWriter Wave;
+	Wave.Id("RIFF");
+	Wave.U32(static_cast<uint32_t>(Chunks.Bytes.size() + 4));
+	Wave.Id("WAVE");
+	Wave.Bytes.insert(Wave.Bytes.end(), Chunks.Bytes.begin(), Chunks.Bytes.end());
+	return Wave.Bytes;
+}
+
+struct FResult
+{
+	bool bParsed = false;
+	FWaveFormat Format;
+	int64_t DataOffset = 0;
+	int64_t DataSize = 0;
+	std::string Error;
+};
+
+// Parse a file of FileSize bytes that starts with Header, reads past the header fail like they would for samples
+FResult Parse(const std::vector<uint8_t> &Header, int64_t FileSize)
+{
+	auto ReadBytes = [&Header](int64_t Offset, int32_t Size, uint8_t *Dest)
+	{
+		if (Offset + Size > static_cast<int64_t>(Header.size()))
+		{
+			return false;
+		}
+		std::memcpy(Dest, Header.data() + Offset, Size);
+		return true;
+	};
+
+	FResult Result;
+	const char *Error = nullptr;
+	Result.bParsed = ParseWaveChunks(FileSize, ReadBytes, Result.Format, Result.DataOffset, Result.DataSize, &Error);
+	Result.Error = Error ? Error : "";
+	return Result;
+}
+
+FResult Parse(const std::vector<uint8_t> &File) { return Parse(File, static_cast<int64_t>(File.size())); }
+} // namespace
+
+int main()
+{
+	const std::vector<uint8_t> Samples(400, 0x11);
+
+	// Odd-sized chunk with its pad byte before fmt, unknown chunk between fmt and data
+	{
+		FWaveWriter Chunks;
+		Chunks.Chunk("bext", std::vector<uint8_t>(7, 0));
+		Chunks.Chunk("fmt ", MakeFmt(1, 2, 16000, 16));
+		Chunks.Chunk("LIST", std::vector<uint8_t>(10, 0));
+		Chunks.Chunk("data", Samples);
+		const FResult Result = Parse(MakeWave(Chunks));
+		Check(Result.bParsed, "PCM16 with extra chunks parses");
+		Check(Result.Format.Encoding == EWaveEncoding::PCM && Result.Format.BitsPerSample == 16,
+			  "PCM16 encoding is reported");
+		Check(Result.Format.NumChannels == 2 && Result.Format.SampleRate == 16000 && Result.Format.BlockAlign == 4,
+			  "PCM16 channels, rate and block alignment are reported");
+		Check(Result.DataOffset == 12 + 16 + 24 + 18 + 8 && Result.DataSize == 400, "PCM16 data chunk is located");
+	}
+
+	// WAVE_FORMAT_EXTENSIBLE float with a channel mask
+	{
+		FWaveWriter Chunks;
+		Chunks.Chunk("fmt ", MakeExtensibleFmt(3, 1, 48000, 32, 0x4));
+		Chunks.Chunk("data", Samples);
+		const FResult Result = Parse(MakeWave(Chunks));
+		Check(Result.bParsed && Result.Format.Encoding == EWaveEncoding::Float, "extensible float parses");
+		Check(Result.Format.ChannelMask == 0x4, "extensible channel mask is reported");
+	}
+
+	// Unfinished recording: data declares more than the file holds and ends in a partial frame
+	{
+		FWaveWriter Chunks;
+		Chunks.Chunk("fmt ", MakeFmt(1, 2, 16000, 16));
+		Chunks.Chunk("data", std::vector<uint8_t>(402, 0), 0xFFFFFFFF);
+		std::vector<uint8_t> File = MakeWave(Chunks);
+		File.resize(File.size() - 1);
+		const FResult Result = Parse(File);
+		Check(Result.bParsed && Result.DataSize == 400, "truncated data is clamped to whole frames");
+	}
+
+	// Multi-hour recordings: a 3 GB data chunk, and one over 4 GB whose writer left the sizes at their maximum
+	{
+		FWaveWriter Chunks;
+		Chunks.Chunk("fmt ", MakeFmt(1, 1, 48000, 16));
+		Chunks.Id("data");
+		Chunks.U32(0xC0000000);
+		FWaveWriter Header;
+		Header.Id("RIFF");
+		Header.U32(static_cast<uint32_t>(Chunks.Bytes.size() + 4 + 0xC0000000));
+		Header.Id("WAVE");
+		Header.Bytes.insert(Header.Bytes.end(), Chunks.Bytes.begin(), Chunks.Bytes.end());
+		const int64_t HeaderSize = static_cast<int64_t>(Header.Bytes.size());
+		const FResult Result = Parse(Header.Bytes, HeaderSize + 0xC0000000LL);
+		Check(Result.bParsed && Result.DataOffset == HeaderSize && Result.DataSize == 0xC0000000LL,
+			  "data chunk over 2 GB is located with 64-bit offsets");
+	}
+	{
+		FWaveWriter Chunks;
+		Chunks.Chunk("fmt ", MakeFmt(1, 2, 48000, 16));
+		Chunks.Id("data");
+		Chunks.U32(0xFFFFFFFF);
+		FWaveWriter Header;
+		Header.Id("RIFF");
+		Header.U32(0xFFFFFFFF);
+		Header.Id("WAVE");
+		Header.Bytes.insert(Header.Bytes.end(), Chunks.Bytes.begin(), Chunks.Bytes.end());
+		const FResult Result = Parse(Header.Bytes, 5LL << 30);
+		Check(Result.bParsed && Result.DataSize == 0xFFFFFFFCLL, "data chunk size is clamped to whole frames");
+	}
+
+	// Rejected files report why
+	{
+		FWaveWriter Chunks;
+		Chunks.Chunk("data", Samples);
+		const FResult Result = Parse(MakeWave(Chunks));
+		Check(!Result.bParsed && Result.Error == "missing fmt chunk", "missing fmt chunk is rejected");
+	}
+	{
+		FWaveWriter Chunks;
+		Chunks.Chunk("fmt ", MakeFmt(2, 1, 16000, 4));
+		Chunks.Chunk("data", Samples);
+		const FResult Result = Parse(MakeWave(Chunks));
+		Check(!Result.bParsed && Result.Error == "compressed WAV encodings are not supported",
+			  "ADPCM is rejected");
+	}
+	{
+		const FResult Result = Parse(std::vector<uint8_t>(64, 0));
+		Check(!Result.bParsed && Result.Error == "not a RIFF/WAVE file", "non-RIFF data is rejected");
+	}
+
+	std::printf("%d checks failed\n", NumFailures);
+	return NumFailures == 0 ? 0 : 1;
+}
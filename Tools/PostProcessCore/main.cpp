@@ -0,0 +1,118 @@
+/*******************************************************************************
+ * Filename    :   main.cpp
+ * Content     :   Microbenchmark of the viseme post-processing core
+ ******************************************************************************/
+
+#include "OVRLipSyncPostProcessCore.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+using namespace OVRLipSyncCore;
+
+namespace
+{
+// Inference produces 100 frames per second of audio
+constexpr int FramesPerSecond = 100;
+constexpr int NumVisemes = 15;
+
+enum EStep
+{
+	Filter,
+	Cluster,
+	Apply,
+	Smoothing,
+	NumSteps
+};
+
+const char *StepNames[NumSteps] = {"FilterShortVisemes", "ClusterBlocks", "ApplyDominants", "Smooth"};
+
+double GetMilliseconds(std::chrono::steady_clock::time_point Start, std::chrono::steady_clock::time_point End)
+{
+	return std::chrono::duration<double, std::milli>(End - Start).count();
+}
+} // namespace
+
+// Usage: OVRLipSyncCoreBench [Minutes=60] [Runs=5]
+int main(int Argc, char **Argv)
+{
+	const int Minutes = Argc > 1 ? std::max(std::atoi(Argv[1]), 1) : 60;
+	const int NumRuns = Argc > 2 ? std::max(std::atoi(Argv[2]), 1) : 5;
+	const int NumFrames = Minutes * 60 * FramesPerSecond;
+
+	// One loud viseme per frame over quieter ones, held for a few frames like speech
+	FScoreBuffer Track;
+	Track.Init(NumFrames, NumVisemes);
+	std::mt19937 Random(1);
+	std::uniform_real_distribution<float> Uniform(0.0f, 1.0f);
+	int Loud = 0;
+	for (int f = 0; f < NumFrames; ++f)
+	{
+		if (Random() % 4 == 0)
+		{
+			Loud = static_cast<int>(Random() % NumVisemes);
+		}
+		float *Frame = Track.GetFrame(f);
+		for (int j = 0; j < NumVisemes; ++j)
+		{
+			Frame[j] = j == Loud ? 0.5f + Uniform(Random) * 0.5f : Uniform(Random) * 0.4f;
+		}
+	}
+
+	const FPostProcessSettings Settings;
+	double Best[NumSteps];
+	double Total[NumSteps] = {};
+	std::fill(Best, Best + NumSteps, 1e30);
+	for (int Run = 0; Run < NumRuns; ++Run)
+	{
+		FScoreBuffer Buffer = Track;
+		FBlockDominants Dominants;
+		FScoreBuffer Smoothed;
+
+		double Milliseconds[NumSteps];
+		auto Start = std::chrono::steady_clock::now();
+		FilterShortVisemes(Buffer, Settings);
+		auto End = std::chrono::steady_clock::now();
+		Milliseconds[Filter] = GetMilliseconds(Start, End);
+
+		Start = End;
+		ClusterBlocks(Buffer, Settings, Dominants);
+		End = std::chrono::steady_clock::now();
+		Milliseconds[Cluster] = GetMilliseconds(Start, End);
+
+		Start = End;
+		ApplyDominants(Buffer, Settings, Dominants);
+		End = std::chrono::steady_clock::now();
+		Milliseconds[Apply] = GetMilliseconds(Start, End);
+
+		Start = End;
+		Smooth(Buffer, Settings, Smoothed);
+		End = std::chrono::steady_clock::now();
+		Milliseconds[Smoothing] = GetMilliseconds(Start, End);
+
+		for (int Step = 0; Step < NumSteps; ++Step)
+		{
+			Best[Step] = std::min(Best[Step], Milliseconds[Step]);
+			Total[Step] += Milliseconds[Step];
+		}
+	}
+
+	std::printf("%d frames (%d min at %d fps), %d visemes, %d runs\n", NumFrames, Minutes, FramesPerSecond,
+				NumVisemes, NumRuns);
+	std::printf("%-20s %10s %10s %14s\n", "Step", "Best ms", "Avg ms", "Mframes/s");
+	double BestSum = 0.0;
+	double AverageSum = 0.0;
+	for (int Step = 0; Step < NumSteps; ++Step)
+	{
+		const double Average = Total[Step] / NumRuns;
+		std::printf("%-20s %10.2f %10.2f %14.1f\n", StepNames[Step], Best[Step], Average,
+					NumFrames / (Best[Step] * 1e3));
+		BestSum += Best[Step];
+		AverageSum += Average;
+	}
+	std::printf("%-20s %10.2f %10.2f %14.1f\n", "Total", BestSum, AverageSum, NumFrames / (BestSum * 1e3));
+	return 0;
+}